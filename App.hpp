@@ -1,8 +1,12 @@
 #pragma once
 
 #include "PlatformAbstraction.hpp"
+#include "FramePool.hpp"
 #include "IPAddress.hpp"
 #include "NetworkHeaders.hpp"
+#include "ForwardingPipeline.hpp"
+#include "MetricsServer.hpp"
+#include "CaptureWriter.hpp"
 #include <memory>
 #include <string>
 #include <vector>
@@ -48,13 +52,31 @@ public:
 		bool oneWayMode;            ///< One-way mode flag
 		bool dropMode;              ///< Drop packets instead of forwarding
 		int arpInterval;            ///< ARP packet interval (seconds)
+		unsigned int resolveTimeoutMs = 200; ///< MAC resolution wait after first request (milliseconds)
+		unsigned int resolveAttempts = 4;    ///< MAC resolution requests per address
+		PlatformFactory::SocketBackend socketBackend = PlatformFactory::SocketBackend::Default; ///< Raw socket implementation (AF_XDP on Linux)
+		bool useReceiveRing = false;         ///< Receive through memory-mapped ring
+		RawSocket::RingConfig ringConfig;    ///< Receive ring geometry
+		bool segmentationOffload = false;    ///< Forward GRO super-frames whole (Linux PACKET_VNET_HDR)
+		bool kernelFilter = true;            ///< Drop unrelated frames in the kernel (BPF)
+		bool pipelined = false;              ///< Receive and transmit on dedicated threads
+		ForwardingPipeline::Config pipeline; ///< Queue size and CPU pinning of pipeline threads
+		int controlCpu = -1;                 ///< CPU for ARP/statistics thread (-1 - not pinned)
+		unsigned int workers = 1;            ///< Receive sockets in a fanout group, one thread each
+		RawSocket::FanoutMode fanoutMode = RawSocket::FanoutMode::Hash; ///< Frame distribution over workers
+		int workerCpu = -1;                  ///< CPU of first worker, next workers use following CPUs (-1 - not pinned)
+		std::string metricsAddress;          ///< OpenMetrics endpoint ("port", "host:port", "unix:/path"), empty - disabled
+		bool measureDelay = false;           ///< Record delay from kernel receive timestamp to forward
+		std::string delayFile;               ///< File for delay distribution at stop, empty - log summary only
+		CaptureWriter::Config capture;       ///< pcapng record of intercepted frames (path empty - disabled)
 	};
 
 	////////////////////////////////////////////////////////////
 	/// \brief Attack information structure
 	///
 	/// This structure contains information about the currently
-	/// running attack.
+	/// running attack. Traffic counters are kept separately,
+	/// see getStatistics().
 	///
 	/// \see getAttackInfo()
 	///
@@ -62,14 +84,11 @@ public:
 	struct AttackInfo {
 		IPAddress victimIp;         ///< Victim's IP address
 		IPAddress targetIp;         ///< Target's IP address
-		std::vector<uint8_t> victimMac;   ///< Victim's MAC address
-		std::vector<uint8_t> targetMac;   ///< Target's MAC address
-		std::vector<uint8_t> myMac;       ///< Our MAC address
+		MacAddress victimMac;             ///< Victim's MAC address
+		MacAddress targetMac;             ///< Target's MAC address
+		MacAddress myMac;                 ///< Our MAC address
 		std::string interfaceName;        ///< Interface name
 		bool isActive;                    ///< Whether attack is active
-		uint64_t packetsSent;             ///< Number of sent packets
-		uint64_t packetsReceived;         ///< Number of received packets
-		uint64_t packetsDropped;          ///< Number of dropped packets
 	};
 
 	////////////////////////////////////////////////////////////
@@ -93,9 +112,31 @@ public:
 	////////////////////////////////////////////////////////////
 	using StopCallback = std::function<void()>;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Raw socket factory type
+	///
+	/// Called once for the main socket and once per additional
+	/// worker socket.
+	///
+	////////////////////////////////////////////////////////////
+	using RawSocketFactory = std::function<std::unique_ptr<RawSocket>()>;
+
 private:
 	std::unique_ptr<NetworkInterface> networkInterface; ///< Network interface
+	RawSocketFactory socketFactory;                     ///< Creates rawSocket and worker sockets
+	FramePool receivePool;                              ///< Receive buffer of rawSocket (attack loop or receive thread)
 	std::unique_ptr<RawSocket> rawSocket;               ///< Raw socket
+	PlatformFactory::SocketBackend socketBackend = PlatformFactory::SocketBackend::Default; ///< Kind of rawSocket
+	std::unique_ptr<EventLoop> eventLoop;               ///< Main loop (timers, socket, signals)
+	TrafficStatistics statistics;                       ///< Per-thread traffic counters (outlive the threads below)
+	TrafficStatistics::Block* controlStatistics = nullptr; ///< Counters of the attack loop thread
+	uint64_t receiveWakeTime = 0;                       ///< Time of current socket wakeup (attack loop)
+	uint64_t truncatedFrames = 0;                       ///< Frames too long for the receive buffer (updateLostPackets())
+	std::unique_ptr<ForwardingPipeline> pipeline;       ///< Receive/transmit threads (pipelined mode)
+	std::vector<std::unique_ptr<RawSocket>> workerSockets; ///< Fanout group members besides rawSocket
+	std::vector<std::unique_ptr<ForwardingWorker>> workers; ///< One thread per fanout socket
+	std::unique_ptr<CaptureWriter> capture;             ///< Record of intercepted frames (written by the threads above)
+	std::unique_ptr<MetricsServer> metricsServer;       ///< Metrics endpoint (reads the threads above)
 	std::atomic<bool> stopFlag;                         ///< Stop flag
 	std::atomic<bool> isRunning;                        ///< Whether application is running
 	
@@ -108,16 +149,36 @@ private:
 	// Singleton pattern
 	static std::unique_ptr<App> instance;               ///< Singleton instance
 
+	// Benchmarks drive the per-frame path directly (bench/AppBench.cpp)
+	friend class AppBench;
+
 public:
 	////////////////////////////////////////////////////////////
 	/// \brief Constructor
 	///
 	/// Private constructor for Singleton pattern.
 	/// Initializes the application with default values.
+	/// Raw sockets come from PlatformFactory, of the kind
+	/// selected by AttackConfig::socketBackend.
 	///
 	////////////////////////////////////////////////////////////
 	App();
 
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor with injected platform components
+	///
+	/// Lets tests and benchmarks run the attack on a simulated
+	/// network instead of the system's interfaces. The event
+	/// loop still comes from PlatformFactory.
+	///
+	/// \param networkInterface Interface list and address resolution
+	/// \param socketFactory Creates the raw sockets
+	///
+	/// \see InMemoryNetwork
+	///
+	////////////////////////////////////////////////////////////
+	App(std::unique_ptr<NetworkInterface> networkInterface, RawSocketFactory socketFactory);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Destructor
 	///
@@ -179,8 +240,10 @@ public:
 	/// 2. Intercepts and forwards network traffic
 	/// 3. Handles interrupt signals
 	///
-	/// The function runs in a loop until stopAttack() is called
-	/// or the stop flag is set.
+	/// The loop is event-driven (EventLoop): it sleeps until
+	/// a frame arrives, a timer expires or a stop is requested
+	/// with requestStop() or Ctrl+C. Before returning it calls
+	/// stopAttack() to restore the ARP caches.
 	///
 	/// \return bool true if attack ended successfully
 	///
@@ -205,12 +268,18 @@ public:
 	/// \brief Sets the attack stop flag
 	///
 	/// This function is called by signal handler
-	/// to safely stop the main attack loop.
+	/// to safely stop the main attack loop. Wakes the
+	/// event loop, so the attack stops immediately.
 	///
 	/// \see startAttack(), stopAttack()
 	///
 	////////////////////////////////////////////////////////////
-	void requestStop() { stopFlag = true; }
+	void requestStop() {
+		stopFlag = true;
+		if (eventLoop) {
+			eventLoop->stop();
+		}
+	}
 
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if attack is currently active
@@ -252,6 +321,41 @@ public:
 	////////////////////////////////////////////////////////////
 	const AttackInfo& getAttackInfo() const { return attackInfo; }
 
+	////////////////////////////////////////////////////////////
+	/// \brief Gets traffic counters of the current or last attack
+	///
+	/// Sums the counters of all forwarding threads. Safe to call
+	/// from any thread while the attack runs.
+	///
+	/// \return TrafficStatistics::Snapshot Counter values
+	///
+	////////////////////////////////////////////////////////////
+	TrafficStatistics::Snapshot getStatistics() const { return statistics.snapshot(); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Formats current counters in OpenMetrics text format
+	///
+	/// Only reads counters; called by the metrics endpoint
+	/// thread while the attack runs.
+	///
+	/// \return std::string Exposition ending with "# EOF"
+	///
+	////////////////////////////////////////////////////////////
+	std::string renderMetrics() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Formats distribution of added forwarding delay
+	///
+	/// Delay runs from the kernel receive timestamp to the end
+	/// of the send; recorded only with AttackConfig::measureDelay.
+	/// Served by the metrics endpoint on /latency.
+	///
+	/// \return std::string HdrHistogram-style percentile table
+	///         in microseconds
+	///
+	////////////////////////////////////////////////////////////
+	std::string renderLatency() const { return statistics.snapshot().addedDelay.format(); }
+
 private:
 	////////////////////////////////////////////////////////////
 	/// \brief Creates ARP spoofing packet
@@ -267,18 +371,61 @@ private:
 	////////////////////////////////////////////////////////////
 	std::vector<uint8_t> createArpPacket(
 		const IPAddress& victimIp,
-		const std::vector<uint8_t>& victimMac,
+		const MacAddress& victimMac,
 		const IPAddress& spoofedIp,
-		const std::vector<uint8_t>& myMac
+		const MacAddress& myMac
 	);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Decides what to do with received frame
+	///
+	/// Frames to forward get their MAC addresses rewritten in
+	/// place. Used directly by the forwarding pipeline.
+	///
+	/// \param data Packet data (valid only during the call)
+	/// \param direction Set for intercepted frames
+	///
+	/// \return ForwardingPipeline::Action Ignore, Drop or Forward
+	///
+	////////////////////////////////////////////////////////////
+	ForwardingPipeline::Action classifyPacket(ByteSpan data, TrafficStatistics::Direction& direction);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Handles received network packet
 	///
-	/// \param data Packet data
+	/// Frames to forward have their MAC addresses rewritten
+	/// in place and are sent straight from data, without
+	/// copying or allocating.
+	///
+	/// \param data Packet data (valid only during the call)
+	///
+	////////////////////////////////////////////////////////////
+	void handlePacket(ByteSpan data);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Updates kernel drop counter from socket statistics
+	///
+	////////////////////////////////////////////////////////////
+	void updateLostPackets();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Stops pipeline and worker threads, if any
+	///
+	////////////////////////////////////////////////////////////
+	void stopThreads();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Logs periodic attack statistics
+	///
+	////////////////////////////////////////////////////////////
+	void logStatistics();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Logs added delay percentiles and writes the
+	///        distribution to AttackConfig::delayFile
 	///
 	////////////////////////////////////////////////////////////
-	void handlePacket(const std::vector<uint8_t>& data);
+	void logAddedDelay(const LatencyHistogram::Distribution& delay);
 
 	////////////////////////////////////////////////////////////
 	/// \brief Logs a message using the callback
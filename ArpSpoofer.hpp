@@ -35,9 +35,9 @@ private:
 	
 	IPAddress victimIp;                ///< Adres IP ofiary
 	IPAddress targetIp;                ///< Adres IP celu
-	uint8_t victimMac[6];              ///< Adres MAC ofiary
-	uint8_t targetMac[6];              ///< Adres MAC celu
-	uint8_t myMac[6];                  ///< Nasz adres MAC
+	MacAddress victimMac;              ///< Adres MAC ofiary
+	MacAddress targetMac;              ///< Adres MAC celu
+	MacAddress myMac;                  ///< Nasz adres MAC
 	
 	bool oneWayMode;                   ///< Tryb jednokierunkowy
 	
@@ -61,6 +61,21 @@ public:
 	////////////////////////////////////////////////////////////
 	ArpSpoofer(const IPAddress& victimIp, const IPAddress& targetIp, bool oneWayMode = false);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Konstruktor z podanym gniazdem
+	///
+	/// Pozwala uruchomić atak na symulowanej sieci, np. w
+	/// benchmarkach z InMemoryRawSocket.
+	///
+	/// \param victimIp Adres IP ofiary
+	/// \param targetIp Adres IP celu
+	/// \param socket Gniazdo używane zamiast systemowego
+	/// \param oneWayMode Tryb jednokierunkowy (true = oszukuj tylko ofiarę)
+	///
+	////////////////////////////////////////////////////////////
+	ArpSpoofer(const IPAddress& victimIp, const IPAddress& targetIp, std::unique_ptr<RawSocket> socket,
+	           bool oneWayMode = false);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Destruktor
 	///
@@ -74,32 +89,32 @@ public:
 	////////////////////////////////////////////////////////////
 	/// \brief Ustawia adres MAC ofiary
 	///
-	/// \param mac Tablica 6 bajtów reprezentująca adres MAC
+	/// \param mac Adres MAC
 	///
 	/// \see setTargetMac(), setMyMac()
 	///
 	////////////////////////////////////////////////////////////
-	void setVictimMac(const uint8_t mac[6]);
+	void setVictimMac(const MacAddress& mac);
 
 	////////////////////////////////////////////////////////////
 	/// \brief Ustawia adres MAC celu
 	///
-	/// \param mac Tablica 6 bajtów reprezentująca adres MAC
+	/// \param mac Adres MAC
 	///
 	/// \see setVictimMac(), setMyMac()
 	///
 	////////////////////////////////////////////////////////////
-	void setTargetMac(const uint8_t mac[6]);
+	void setTargetMac(const MacAddress& mac);
 
 	////////////////////////////////////////////////////////////
 	/// \brief Ustawia nasz adres MAC
 	///
-	/// \param mac Tablica 6 bajtów reprezentująca adres MAC
+	/// \param mac Adres MAC
 	///
 	/// \see setVictimMac(), setTargetMac()
 	///
 	////////////////////////////////////////////////////////////
-	void setMyMac(const uint8_t mac[6]);
+	void setMyMac(const MacAddress& mac);
 
 	////////////////////////////////////////////////////////////
 	/// \brief Ustawia callback do logowania
@@ -170,7 +185,7 @@ public:
 	/// \see sendSpoofPacket()
 	///
 	////////////////////////////////////////////////////////////
-	bool sendArpReply(const IPAddress& targetIp, const uint8_t targetMac[6], const IPAddress& spoofedIp);
+	bool sendArpReply(const IPAddress& targetIp, const MacAddress& targetMac, const IPAddress& spoofedIp);
 
 	////////////////////////////////////////////////////////////
 	/// \brief Wysyła pakiet ARP request
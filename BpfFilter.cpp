@@ -0,0 +1,117 @@
+#include "BpfFilter.hpp"
+
+namespace {
+
+// Classic BPF operation codes (identical on Linux and BSD)
+constexpr uint16_t OpLoadWord = 0x20;   ///< BPF_LD | BPF_W | BPF_ABS
+constexpr uint16_t OpLoadHalf = 0x28;   ///< BPF_LD | BPF_H | BPF_ABS
+constexpr uint16_t OpJumpEqual = 0x15;  ///< BPF_JMP | BPF_JEQ | BPF_K
+constexpr uint16_t OpJump = 0x05;       ///< BPF_JMP | BPF_JA
+constexpr uint16_t OpReturn = 0x06;     ///< BPF_RET | BPF_K
+
+// Field offsets in untagged Ethernet frame carrying IPv4
+constexpr uint32_t DestinationMacOffset = 0;
+constexpr uint32_t SourceMacOffset = 6;
+constexpr uint32_t EtherTypeOffset = 12;
+constexpr uint32_t IpSourceOffset = 26;
+constexpr uint32_t IpDestinationOffset = 30;
+
+constexpr size_t MaxJump = 255; ///< Conditional jump offsets are 8-bit
+
+} // namespace
+
+static_assert(sizeof(BpfInstruction) == 8, "BpfInstruction musi odpowiadać sock_filter/bpf_insn");
+
+////////////////////////////////////////////////////////////
+void BpfFilterBuilder::matchEtherType(uint16_t etherType) {
+	conditions.push_back({{{OpLoadHalf, EtherTypeOffset, etherType}}});
+}
+
+////////////////////////////////////////////////////////////
+void BpfFilterBuilder::matchDestinationMac(const MacAddress& mac) {
+	if (!mac.isEmpty()) {
+		conditions.push_back({macChecks(DestinationMacOffset, mac)});
+	}
+}
+
+////////////////////////////////////////////////////////////
+void BpfFilterBuilder::matchSourceMac(const std::vector<MacAddress>& macs) {
+	Condition condition;
+	for (const auto& mac : macs) {
+		if (!mac.isEmpty()) {
+			condition.push_back(macChecks(SourceMacOffset, mac));
+		}
+	}
+	
+	if (!condition.empty()) {
+		conditions.push_back(std::move(condition));
+	}
+}
+
+////////////////////////////////////////////////////////////
+void BpfFilterBuilder::matchIpAddress(const IPAddress& address) {
+	conditions.push_back({
+		{{OpLoadWord, IpSourceOffset, address.toUint32()}},
+		{{OpLoadWord, IpDestinationOffset, address.toUint32()}}
+	});
+}
+
+////////////////////////////////////////////////////////////
+BpfFilterBuilder::Alternative BpfFilterBuilder::macChecks(uint32_t offset, const MacAddress& mac) {
+	uint64_t value = mac.toUint64();
+	uint32_t high = static_cast<uint32_t>(value >> 16);
+	uint32_t low = static_cast<uint32_t>(value & 0xFFFF);
+	return {{OpLoadWord, offset, high}, {OpLoadHalf, offset + 4, low}};
+}
+
+////////////////////////////////////////////////////////////
+std::vector<BpfInstruction> BpfFilterBuilder::build() const {
+	// Every check is a load and a compare; every alternative except the
+	// last of its condition ends with a jump to the next condition
+	auto alternativeSize = [](const Alternative& alternative, bool last) {
+		return 2 * alternative.size() + (last ? 0 : 1);
+	};
+	
+	size_t total = 0;
+	for (const auto& condition : conditions) {
+		for (size_t i = 0; i < condition.size(); ++i) {
+			total += alternativeSize(condition[i], i + 1 == condition.size());
+		}
+	}
+	
+	// Program layout: conditions..., accept, reject
+	const size_t reject = total + 1;
+	std::vector<BpfInstruction> program;
+	program.reserve(total + 2);
+	
+	for (const auto& condition : conditions) {
+		size_t conditionEnd = program.size();
+		for (size_t i = 0; i < condition.size(); ++i) {
+			conditionEnd += alternativeSize(condition[i], i + 1 == condition.size());
+		}
+		
+		for (size_t i = 0; i < condition.size(); ++i) {
+			bool last = i + 1 == condition.size();
+			size_t nextAlternative = program.size() + alternativeSize(condition[i], last);
+			
+			for (const auto& check : condition[i]) {
+				program.push_back({check.load, 0, 0, check.offset});
+				
+				// On mismatch try the next alternative, after the last one reject
+				size_t onFalse = (last ? reject : nextAlternative) - program.size() - 1;
+				if (onFalse > MaxJump) {
+					return {};
+				}
+				program.push_back({OpJumpEqual, 0, static_cast<uint8_t>(onFalse), check.value});
+			}
+			
+			if (!last) {
+				program.push_back({OpJump, 0, 0, static_cast<uint32_t>(conditionEnd - program.size() - 1)});
+			}
+		}
+	}
+	
+	program.push_back({OpReturn, 0, 0, AcceptLength});
+	program.push_back({OpReturn, 0, 0, 0});
+	return program;
+}
\ No newline at end of file
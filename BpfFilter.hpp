@@ -0,0 +1,124 @@
+#pragma once
+
+#include "IPAddress.hpp"
+#include "MacAddress.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+////////////////////////////////////////////////////////////
+/// \brief Single classic BPF instruction
+///
+/// Same layout as Linux struct sock_filter and BSD/macOS
+/// struct bpf_insn, so a program can be handed to the
+/// kernel without conversion.
+///
+/// The structure name "BpfInstruction" comes from:
+/// - "Bpf" - denotes Berkeley Packet Filter
+/// - "Instruction" - denotes one filter machine instruction
+///
+/// \see BpfFilterBuilder, RawSocket::attachFilter()
+///
+////////////////////////////////////////////////////////////
+struct BpfInstruction {
+	uint16_t code;  ///< Operation code
+	uint8_t jt;     ///< Jump offset if condition is true
+	uint8_t jf;     ///< Jump offset if condition is false
+	uint32_t k;     ///< Constant operand
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Builder of classic BPF capture filters
+///
+/// Builds a program that accepts an Ethernet frame only if
+/// every added condition holds. A condition is a list of
+/// alternatives, at least one of which must match, e.g.
+/// "source MAC is the victim's or the target's". Offsets
+/// assume untagged Ethernet frames carrying IPv4.
+///
+/// Example:
+/// \code
+/// BpfFilterBuilder builder;
+/// builder.matchEtherType(ETHERTYPE_IP);
+/// builder.matchSourceMac({victimMac, targetMac});
+/// builder.matchIpAddress(victimIp);
+/// rawSocket->attachFilter(builder.build());
+/// \endcode
+///
+/// The class name "BpfFilterBuilder" comes from:
+/// - "Bpf" - denotes Berkeley Packet Filter
+/// - "Filter" - denotes capture filter program
+/// - "Builder" - denotes builder design pattern
+///
+/// \see BpfInstruction, RawSocket::attachFilter()
+///
+////////////////////////////////////////////////////////////
+class BpfFilterBuilder {
+public:
+	static constexpr uint32_t AcceptLength = 262144; ///< Bytes of accepted frame passed to user space
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requires given EtherType
+	///
+	/// \param etherType Protocol type, e.g. 0x0800 for IPv4
+	///
+	////////////////////////////////////////////////////////////
+	void matchEtherType(uint16_t etherType);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requires destination MAC address
+	///
+	/// \param mac Accepted destination address; an empty
+	///            address adds no condition
+	///
+	////////////////////////////////////////////////////////////
+	void matchDestinationMac(const MacAddress& mac);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requires source MAC to be one of given addresses
+	///
+	/// \param macs Accepted source addresses; empty addresses
+	///             are skipped and an empty list adds no condition
+	///
+	////////////////////////////////////////////////////////////
+	void matchSourceMac(const std::vector<MacAddress>& macs);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requires IPv4 source or destination address
+	///
+	/// \param address Address that must appear in either field
+	///
+	////////////////////////////////////////////////////////////
+	void matchIpAddress(const IPAddress& address);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Builds filter program
+	///
+	/// \return std::vector<BpfInstruction> Program, or empty vector
+	///         if it is too large for 8-bit jump offsets
+	///
+	////////////////////////////////////////////////////////////
+	std::vector<BpfInstruction> build() const;
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Comparison of one field against a constant
+	///
+	////////////////////////////////////////////////////////////
+	struct Check {
+		uint16_t load;     ///< Load instruction (word, half-word or byte)
+		uint32_t offset;   ///< Byte offset in frame
+		uint32_t value;    ///< Expected value
+	};
+
+	using Alternative = std::vector<Check>;        ///< All checks must match
+	using Condition = std::vector<Alternative>;    ///< One alternative must match
+
+	////////////////////////////////////////////////////////////
+	/// \brief Creates checks comparing 6-byte MAC at offset
+	///
+	////////////////////////////////////////////////////////////
+	static Alternative macChecks(uint32_t offset, const MacAddress& mac);
+
+	std::vector<Condition> conditions; ///< All conditions must match
+};
\ No newline at end of file
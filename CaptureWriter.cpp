@@ -0,0 +1,386 @@
+#include "CaptureWriter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+namespace {
+
+// pcapng block types and options (draft-ietf-opsawg-pcapng)
+constexpr uint32_t SectionHeaderBlock = 0x0A0D0D0A;
+constexpr uint32_t InterfaceDescriptionBlock = 0x00000001;
+constexpr uint32_t EnhancedPacketBlock = 0x00000006;
+constexpr uint32_t ByteOrderMagic = 0x1A2B3C4D;
+constexpr uint16_t LinkTypeEthernet = 1;
+constexpr uint16_t OptionEnd = 0;
+constexpr uint16_t OptionInterfaceName = 2;
+constexpr uint16_t OptionTimestampResolution = 9;
+constexpr uint8_t NanosecondResolution = 9;           ///< 10^-9 s
+constexpr size_t PacketBlockOverhead = 32;            ///< Enhanced packet block without data
+
+size_t padded(size_t size) {
+	return (size + 3) & ~static_cast<size_t>(3);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Appends values in host byte order
+///
+/// pcapng readers detect the byte order from the section
+/// header's magic.
+///
+////////////////////////////////////////////////////////////
+struct BlockWriter {
+	uint8_t* data;
+
+	void put16(uint16_t value) { std::memcpy(data, &value, 2); data += 2; }
+	void put32(uint32_t value) { std::memcpy(data, &value, 4); data += 4; }
+	void put64(uint64_t value) { std::memcpy(data, &value, 8); data += 8; }
+	void putBytes(const uint8_t* bytes, size_t size) {
+		std::memcpy(data, bytes, size);
+		std::memset(data + size, 0, padded(size) - size);
+		data += padded(size);
+	}
+};
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+CaptureWriter::~CaptureWriter() {
+	close();
+}
+
+////////////////////////////////////////////////////////////
+std::string CaptureWriter::fileName(uint64_t index) const {
+	if (config.rotateBytes == 0 && config.rotateSeconds == 0) {
+		return config.path;
+	}
+
+	char number[24];
+	std::snprintf(number, sizeof(number), "_%05llu", static_cast<unsigned long long>(index));
+	size_t slash = config.path.find_last_of("/\\");
+	size_t dot = config.path.rfind('.');
+	if (dot == std::string::npos || dot == 0 || (slash != std::string::npos && dot < slash + 2)) {
+		return config.path + number;
+	}
+	return config.path.substr(0, dot) + number + config.path.substr(dot);
+}
+
+////////////////////////////////////////////////////////////
+bool CaptureWriter::write(ConstByteSpan frame, uint64_t timestamp) {
+	// Another thread is in the buffer - never wait for it on the packet path
+	std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+	if (!lock.owns_lock()) {
+		busyDrops.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	if (stopping) {
+		return false;
+	}
+
+	size_t captured = std::min(frame.size(), static_cast<size_t>(config.snapLength));
+	size_t blockSize = PacketBlockOverhead + padded(captured);
+
+	bool rotate = (config.rotateBytes != 0 && fileBytes != 0 && fileBytes + blockSize > config.rotateBytes) ||
+	              (config.rotateSeconds != 0 && timestamp >= fileStart &&
+	               timestamp - fileStart >= static_cast<uint64_t>(config.rotateSeconds) * 1000000000ull);
+	if (rotate || buffers[active].used + blockSize > config.bufferSize) {
+		if (pending) {
+			statistics.dropped++; // Writer is behind - never wait for the disk
+			return false;
+		}
+		swapBuffers(rotate, false, timestamp);
+	}
+
+	Buffer& buffer = buffers[active];
+	BlockWriter block{buffer.data + buffer.used};
+	block.put32(EnhancedPacketBlock);
+	block.put32(static_cast<uint32_t>(blockSize));
+	block.put32(0); // Interface ID
+	block.put32(static_cast<uint32_t>(timestamp >> 32));
+	block.put32(static_cast<uint32_t>(timestamp));
+	block.put32(static_cast<uint32_t>(captured));
+	block.put32(static_cast<uint32_t>(frame.size()));
+	block.putBytes(frame.data(), captured);
+	block.put32(static_cast<uint32_t>(blockSize));
+
+	buffer.used += blockSize;
+	fileBytes += blockSize;
+	statistics.frames++;
+	statistics.bytes += captured;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+CaptureWriter::Statistics CaptureWriter::getStatistics() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	Statistics result = statistics;
+	result.dropped += busyDrops.load(std::memory_order_relaxed);
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+void CaptureWriter::swapBuffers(bool endsFile, bool lastFile, uint64_t timestamp) {
+	Buffer& full = buffers[active];
+	Buffer& next = buffers[1 - active];
+	next.used = 0;
+
+	// O_DIRECT writes whole blocks; the rest is written with the next buffer
+	if (config.directIo && !endsFile) {
+		size_t carry = full.used % Alignment;
+		std::memcpy(next.data, full.data + full.used - carry, carry);
+		full.used -= carry;
+		next.used = carry;
+	}
+
+	full.endsFile = endsFile;
+	full.lastFile = lastFile;
+	pending = true;
+	active = 1 - active;
+
+	if (endsFile && !lastFile) {
+		fileBytes = 0;
+		appendFileHeader(timestamp);
+		statistics.files++;
+	}
+	wake.notify_one();
+}
+
+////////////////////////////////////////////////////////////
+void CaptureWriter::appendFileHeader(uint64_t timestamp) {
+	Buffer& buffer = buffers[active];
+	BlockWriter block{buffer.data + buffer.used};
+
+	const uint32_t sectionSize = 28;
+	block.put32(SectionHeaderBlock);
+	block.put32(sectionSize);
+	block.put32(ByteOrderMagic);
+	block.put16(1); // Version 1.0
+	block.put16(0);
+	block.put64(~static_cast<uint64_t>(0)); // Section length not known
+	block.put32(sectionSize);
+
+	size_t nameSize = std::min(config.interfaceName.size(), static_cast<size_t>(255));
+	size_t interfaceSize = 20 + 8 + 4;
+	if (nameSize != 0) {
+		interfaceSize += 4 + padded(nameSize);
+	}
+	block.put32(InterfaceDescriptionBlock);
+	block.put32(static_cast<uint32_t>(interfaceSize));
+	block.put16(LinkTypeEthernet);
+	block.put16(0);
+	block.put32(config.snapLength);
+	if (nameSize != 0) {
+		block.put16(OptionInterfaceName);
+		block.put16(static_cast<uint16_t>(nameSize));
+		block.putBytes(reinterpret_cast<const uint8_t*>(config.interfaceName.data()), nameSize);
+	}
+	block.put16(OptionTimestampResolution);
+	block.put16(1);
+	block.putBytes(&NanosecondResolution, 1);
+	block.put16(OptionEnd);
+	block.put16(0);
+	block.put32(static_cast<uint32_t>(interfaceSize));
+
+	buffer.used += sectionSize + interfaceSize;
+	fileStart = timestamp;
+}
+
+#ifdef _WIN32
+
+////////////////////////////////////////////////////////////
+bool CaptureWriter::open(const Config&) {
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+void CaptureWriter::close() {
+}
+
+////////////////////////////////////////////////////////////
+void CaptureWriter::run() {
+}
+
+////////////////////////////////////////////////////////////
+bool CaptureWriter::store(const Buffer&) {
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+int CaptureWriter::openFile(uint64_t) {
+	return -1;
+}
+
+#else
+
+////////////////////////////////////////////////////////////
+bool CaptureWriter::open(const Config& settings) {
+	if (thread.joinable() || settings.path.empty() || settings.snapLength == 0) {
+		return false;
+	}
+
+	config = settings;
+	config.bufferSize = (std::max(config.bufferSize, MinBufferSize) + Alignment - 1) / Alignment * Alignment;
+	if (static_cast<size_t>(config.snapLength) + 2 * Alignment > config.bufferSize) {
+		return false; // A frame must fit behind the header and an O_DIRECT carry
+	}
+
+	nextFileIndex = 1;
+	fd = openFile(nextFileIndex++);
+	if (fd < 0) {
+		return false;
+	}
+
+	// O_DIRECT needs aligned memory; both buffers start on an Alignment boundary
+	storage.assign(2 * config.bufferSize + Alignment, 0);
+	uintptr_t base = reinterpret_cast<uintptr_t>(storage.data());
+	uint8_t* aligned = storage.data() + (Alignment - base % Alignment) % Alignment;
+	buffers[0] = Buffer();
+	buffers[1] = Buffer();
+	buffers[0].data = aligned;
+	buffers[1].data = aligned + config.bufferSize;
+
+	active = 0;
+	pending = false;
+	stopping = false;
+	fileBytes = 0;
+	statistics = Statistics();
+	statistics.files = 1;
+	busyDrops = 0;
+	appendFileHeader(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count()));
+
+	thread = std::thread(&CaptureWriter::run, this);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void CaptureWriter::close() {
+	if (!thread.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_one();
+	thread.join();
+
+	if (fd >= 0) {
+		::close(fd);
+		fd = -1;
+	}
+	storage.clear();
+	storage.shrink_to_fit();
+}
+
+////////////////////////////////////////////////////////////
+void CaptureWriter::run() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		wake.wait_for(lock, std::chrono::milliseconds(FlushIntervalMs), [this]() {
+			return pending || stopping;
+		});
+		if (!pending) {
+			if (stopping) {
+				swapBuffers(true, true, 0);
+			} else if (buffers[active].used != 0) {
+				swapBuffers(false, false, 0); // Quiet period - do not keep frames in memory
+			} else {
+				continue;
+			}
+		}
+
+		// Disk work runs unlocked; writers fill the other buffer meanwhile
+		Buffer& buffer = buffers[1 - active];
+		Buffer work = buffer;
+		lock.unlock();
+
+		bool stored = store(work);
+		bool opened = true;
+		if (work.endsFile) {
+			if (fd >= 0) {
+				::close(fd);
+			}
+			fd = -1;
+			if (!work.lastFile) {
+				fd = openFile(nextFileIndex++);
+				opened = fd >= 0;
+			}
+		}
+
+		lock.lock();
+		statistics.writeErrors += (stored ? 0 : 1) + (opened ? 0 : 1);
+		buffer.used = 0;
+		pending = false;
+		if (work.lastFile) {
+			return;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool CaptureWriter::store(const Buffer& buffer) {
+	if (buffer.used == 0) {
+		return true;
+	}
+	if (fd < 0) {
+		return false;
+	}
+
+	// Only the last buffer of a file may end off a block boundary
+	size_t direct = fdDirect ? buffer.used - buffer.used % Alignment : buffer.used;
+	size_t written = 0;
+	while (written < buffer.used) {
+		bool fallback = false;
+		if (written == direct) {
+			fallback = true;
+		} else {
+			ssize_t count = ::write(fd, buffer.data + written, direct - written);
+			if (count < 0 && errno == EINTR) {
+				continue;
+			}
+			if (count < 0 && errno == EINVAL && fdDirect) {
+				fallback = true; // Accepted at open, rejected on write by some file systems
+			} else if (count <= 0) {
+				return false;
+			} else {
+				written += static_cast<size_t>(count);
+			}
+		}
+		if (fallback) {
+#ifdef O_DIRECT
+			fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT);
+#endif
+			fdDirect = false;
+			direct = buffer.used;
+		}
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+int CaptureWriter::openFile(uint64_t index) {
+	std::string name = fileName(index);
+	int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+	fdDirect = false;
+#ifdef O_DIRECT
+	if (config.directIo) {
+		int file = ::open(name.c_str(), flags | O_DIRECT, 0644);
+		if (file >= 0) {
+			fdDirect = true;
+			return file;
+		}
+		// E.g. tmpfs rejects O_DIRECT - fall back to buffered writes
+	}
+#endif
+	return ::open(name.c_str(), flags, 0644);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "PlatformAbstraction.hpp"
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+
+////////////////////////////////////////////////////////////
+/// \brief pcapng capture file writer with a background thread
+///
+/// write() copies a frame as an Enhanced Packet Block with a
+/// nanosecond timestamp into the active buffer and returns;
+/// it never touches the disk. There are two buffers: while
+/// one is filled, the writer thread stores the other with one
+/// large sequential write. If the writer falls behind and both
+/// buffers are full, frames are dropped and counted instead of
+/// stalling the caller, so disk latency never reaches the
+/// forwarding path. Partially filled buffers are written at
+/// least every FlushIntervalMs.
+///
+/// With Config::directIo the files are opened with O_DIRECT
+/// (Linux), bypassing the page cache. Writes then cover whole
+/// Alignment blocks; the unaligned tail of a buffer moves to
+/// the start of the next one, and only the last write of a file
+/// is made without O_DIRECT. File systems that do not support
+/// O_DIRECT get buffered writes.
+///
+/// With rotation enabled, a new file is started when the
+/// current one would exceed rotateBytes or is rotateSeconds
+/// old (checked when a frame arrives). Files are then named
+/// after the path with a sequence number before the extension:
+/// capture.pcapng -> capture_00001.pcapng, capture_00002.pcapng...
+///
+/// write() may be called from several threads. It only tries
+/// the lock: a frame arriving while another thread fills the
+/// buffer, or the writer thread swaps it, is dropped and
+/// counted, so threads never queue behind each other on the
+/// capture. Not available
+/// on Windows; open() returns false there.
+///
+/// Example:
+/// \code
+/// CaptureWriter::Config config;
+/// config.path = "capture.pcapng";
+/// config.rotateBytes = 100000000;
+/// CaptureWriter writer;
+/// writer.open(config);
+/// writer.write(frame, TrafficStatistics::systemNow()); // receive thread
+/// writer.close();
+/// \endcode
+///
+/// The class name "CaptureWriter" comes from:
+/// - "Capture" - denotes recorded traffic
+/// - "Writer" - denotes it produces files
+///
+/// \see App::classifyPacket()
+///
+////////////////////////////////////////////////////////////
+class CaptureWriter {
+public:
+	static constexpr size_t Alignment = 4096;          ///< O_DIRECT block and buffer alignment
+	static constexpr size_t MinBufferSize = 262144;    ///< Smallest accepted buffer size
+	static constexpr uint32_t FlushIntervalMs = 1000;  ///< Longest time frames wait in a buffer
+
+	////////////////////////////////////////////////////////////
+	/// \brief Capture settings
+	///
+	////////////////////////////////////////////////////////////
+	struct Config {
+		std::string path;                ///< Output file, empty - capture disabled
+		std::string interfaceName;       ///< Recorded in the interface description block
+		size_t bufferSize = 4194304;     ///< Bytes per buffer (two are allocated)
+		uint32_t snapLength = 65535;     ///< Frames are truncated to this many bytes
+		bool directIo = false;           ///< Write with O_DIRECT, bypassing the page cache
+		uint64_t rotateBytes = 0;        ///< Start a new file at this size (0 - no size limit)
+		uint32_t rotateSeconds = 0;      ///< Start a new file after this time (0 - no time limit)
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Capture counters
+	///
+	////////////////////////////////////////////////////////////
+	struct Statistics {
+		uint64_t frames = 0;        ///< Frames written to buffers
+		uint64_t bytes = 0;         ///< Captured frame bytes
+		uint64_t dropped = 0;       ///< Frames lost because both buffers were full or were in use
+		uint64_t files = 0;         ///< Files opened
+		uint64_t writeErrors = 0;   ///< Failed file opens or writes (data lost)
+	};
+
+	CaptureWriter() = default;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Closes the capture.
+	///
+	////////////////////////////////////////////////////////////
+	~CaptureWriter();
+
+	CaptureWriter(const CaptureWriter&) = delete;
+	CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Opens the first file and starts the writer thread
+	///
+	/// \return bool false if the file cannot be created, the
+	///         settings are invalid or the platform is not
+	///         supported
+	///
+	////////////////////////////////////////////////////////////
+	bool open(const Config& config);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Writes buffered frames and closes the file
+	///
+	////////////////////////////////////////////////////////////
+	void close();
+
+	bool isOpen() const { return thread.joinable(); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Records one frame
+	///
+	/// \param frame Frame starting with the Ethernet header
+	/// \param timestamp Receive time in nanoseconds since the
+	///                  Unix epoch
+	///
+	/// \return bool false if the frame was dropped or the
+	///         capture is closed
+	///
+	////////////////////////////////////////////////////////////
+	bool write(ConstByteSpan frame, uint64_t timestamp);
+
+	Statistics getStatistics() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets the name of a file of the capture
+	///
+	/// \param index Sequence number (ignored without rotation)
+	///
+	////////////////////////////////////////////////////////////
+	std::string fileName(uint64_t index) const;
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief One of the two buffers
+	///
+	////////////////////////////////////////////////////////////
+	struct Buffer {
+		uint8_t* data = nullptr;  ///< Aligned start within storage
+		size_t used = 0;          ///< Bytes filled
+		bool endsFile = false;    ///< The file is closed after this buffer
+		bool lastFile = false;    ///< No file follows (close())
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Hands the active buffer to the writer thread
+	///
+	/// Called with mutex held when no buffer is pending.
+	///
+	/// \param endsFile Close the file after this buffer
+	/// \param lastFile Do not start another file
+	/// \param timestamp Start time of the next file
+	///
+	////////////////////////////////////////////////////////////
+	void swapBuffers(bool endsFile, bool lastFile, uint64_t timestamp);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Appends section header and interface description
+	///        blocks to the active buffer
+	///
+	////////////////////////////////////////////////////////////
+	void appendFileHeader(uint64_t timestamp);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Body of writer thread
+	///
+	////////////////////////////////////////////////////////////
+	void run();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Writes a buffer to the current file
+	///
+	/// Called by the writer thread without mutex held.
+	///
+	/// \return bool false if the write failed
+	///
+	////////////////////////////////////////////////////////////
+	bool store(const Buffer& buffer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Opens file with given sequence number
+	///
+	/// \return int Descriptor, -1 on failure
+	///
+	////////////////////////////////////////////////////////////
+	int openFile(uint64_t index);
+
+	Config config;                       ///< Settings of the open capture
+	std::vector<uint8_t> storage;        ///< Memory of both buffers plus alignment slack
+	Buffer buffers[2];                   ///< Active and pending buffer
+	size_t active = 0;                   ///< Index of the buffer being filled
+	bool pending = false;                ///< The other buffer waits for the writer
+	bool stopping = true;                ///< No capture open or close() was called
+	uint64_t fileBytes = 0;              ///< Frame bytes of the current file (headers not counted)
+	uint64_t fileStart = 0;              ///< Timestamp of the current file's start
+	uint64_t nextFileIndex = 0;          ///< Sequence number of the next file
+	Statistics statistics;               ///< Guarded by mutex
+	std::atomic<uint64_t> busyDrops{0};  ///< Frames dropped because mutex was held, added to statistics.dropped
+	mutable std::mutex mutex;            ///< Guards all state above
+	std::condition_variable wake;        ///< Signals the writer thread
+
+	int fd = -1;                         ///< Current file (writer thread after open())
+	bool fdDirect = false;               ///< fd was opened with O_DIRECT
+	std::thread thread;                  ///< Writer thread
+};
\ No newline at end of file
@@ -0,0 +1,346 @@
+#include "ForwardingPipeline.hpp"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+////////////////////////////////////////////////////////////
+ForwardingPipeline::ForwardingPipeline(RawSocket& socket, Classifier classifier, TrafficStatistics& statistics,
+                                       const Config& config)
+	: socket(socket), classifier(std::move(classifier)), config(config),
+	  slots(config.queueSize, config.slotSize), filled(slots.capacity()), freeSlots(slots.capacity()),
+	  receiveStatistics(statistics.createBlock()), transmitStatistics(statistics.createBlock()) {
+}
+
+////////////////////////////////////////////////////////////
+ForwardingPipeline::~ForwardingPipeline() {
+	stop();
+}
+
+////////////////////////////////////////////////////////////
+bool ForwardingPipeline::start() {
+	if (receiveThread.joinable() || transmitThread.joinable()) {
+		return false;
+	}
+	
+	receiveEvents = PlatformFactory::createEventLoop();
+	if (!receiveEvents || !receiveEvents->addSocket(socket, [this]() {
+		wakeTime = TrafficStatistics::now();
+		size_t count = socket.receivePackets([this](ByteSpan frame) {
+			handleFrame(frame);
+		}, MaxPacketsPerWake);
+		
+		// One wakeup per received batch, not per frame
+		if (queuedSinceWake) {
+			queuedSinceWake = false;
+			wakeTransmitter();
+		}
+		receiveStatistics.addLoopTime(TrafficStatistics::now() - wakeTime);
+		return count > 0;
+	})) {
+		receiveEvents.reset();
+		return false;
+	}
+	
+	stopping = false;
+	std::promise<bool> receivePinned;
+	std::promise<bool> transmitPinned;
+	std::future<bool> receiveReady = receivePinned.get_future();
+	std::future<bool> transmitReady = transmitPinned.get_future();
+	transmitThread = std::thread(&ForwardingPipeline::transmitLoop, this, std::move(transmitPinned));
+	receiveThread = std::thread(&ForwardingPipeline::receiveLoop, this, std::move(receivePinned));
+	
+	// Evaluate both futures so neither thread is left unobserved
+	bool receiveOk = receiveReady.get();
+	bool transmitOk = transmitReady.get();
+	if (!receiveOk || !transmitOk) {
+		stop();
+		return false;
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void ForwardingPipeline::stop() {
+	if (!receiveThread.joinable() && !transmitThread.joinable()) {
+		return;
+	}
+	
+	stopping = true;
+	if (receiveEvents) {
+		receiveEvents->stop();
+	}
+	if (receiveThread.joinable()) {
+		receiveThread.join();
+	}
+	
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		wakeCondition.notify_one();
+	}
+	if (transmitThread.joinable()) {
+		transmitThread.join();
+	}
+	receiveEvents.reset();
+}
+
+////////////////////////////////////////////////////////////
+ForwardingPipeline::Counters ForwardingPipeline::getCounters() const {
+	Counters counters;
+	counters.queueFull = queueFull.get();
+	counters.oversized = oversized.get();
+	counters.queueDepth = filled.size();
+	counters.maxQueueDepth = maxQueueDepth.load(std::memory_order_relaxed);
+	return counters;
+}
+
+////////////////////////////////////////////////////////////
+bool ForwardingPipeline::pinCurrentThread(int cpu) {
+	if (cpu < 0) {
+		return true;
+	}
+	
+#ifdef __linux__
+	if (cpu >= CPU_SETSIZE) {
+		return false;
+	}
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+	if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+		return false;
+	}
+	return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+#else
+	// macOS has no API to bind a thread to a CPU
+	return false;
+#endif
+}
+
+////////////////////////////////////////////////////////////
+void ForwardingPipeline::receiveLoop(std::promise<bool> pinned) {
+	bool ok = pinCurrentThread(config.rxCpu);
+	pinned.set_value(ok);
+	if (ok) {
+		receiveEvents->run();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ForwardingPipeline::transmitLoop(std::promise<bool> pinned) {
+	bool ok = pinCurrentThread(config.txCpu);
+	pinned.set_value(ok);
+	if (!ok) {
+		return;
+	}
+	
+	FrameDescriptor batch[MaxBatch];
+	ConstByteSpan frames[MaxBatch];
+	RawSocket::Offload offloads[MaxBatch];
+	while (true) {
+		size_t count = 0;
+		while (count < MaxBatch && filled.pop(batch[count])) {
+			frames[count] = slots.frame(batch[count].slot).subspan(0, batch[count].length);
+			offloads[count] = batch[count].offload;
+			++count;
+		}
+		
+		if (count == 0) {
+			// Queued frames are drained before stopping
+			if (stopping) {
+				break;
+			}
+			
+			// Announce sleep before the final emptiness check; pairs
+			// with the fence in wakeTransmitter()
+			std::unique_lock<std::mutex> lock(wakeMutex);
+			transmitterWaiting.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (filled.empty() && !stopping) {
+				wakeCondition.wait(lock);
+			}
+			transmitterWaiting.store(false, std::memory_order_relaxed);
+			continue;
+		}
+		
+		// sendBatch() sends a prefix of the batch
+		size_t sent = socket.sendBatchWithOffload(frames, offloads, count);
+		uint64_t sentTime = TrafficStatistics::now();
+		uint64_t sentSystemTime = TrafficStatistics::systemNow();
+		for (size_t i = 0; i < count; ++i) {
+			if (i < sent) {
+				transmitStatistics.addForwarded(batch[i].length);
+				transmitStatistics.addLatency(sentTime - batch[i].readyTime);
+				if (batch[i].receiveTime != 0 && sentSystemTime > batch[i].receiveTime) {
+					transmitStatistics.addAddedDelay(sentSystemTime - batch[i].receiveTime);
+				}
+			} else {
+				transmitStatistics.addSendFailure();
+			}
+			freeSlots.push(batch[i].slot);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ForwardingPipeline::handleFrame(ByteSpan frame) {
+	receiveStatistics.addReceived(frame.size());
+	
+	TrafficStatistics::Direction direction = TrafficStatistics::Direction::VictimToTarget;
+	switch (classifier(frame, direction)) {
+	case Action::Ignore:
+		return;
+	case Action::Drop:
+		receiveStatistics.addIntercepted(direction, frame.size());
+		receiveStatistics.addDropped();
+		return;
+	case Action::Forward:
+		receiveStatistics.addIntercepted(direction, frame.size());
+		break;
+	}
+	
+	if (frame.size() > config.slotSize) {
+		oversized.add(1);
+		return;
+	}
+	
+	// Slots sent by the transmit thread go back to the pool when it runs dry
+	uint32_t returned;
+	if (slots.available() == 0) {
+		while (freeSlots.pop(returned)) {
+			slots.release(returned);
+		}
+	}
+	uint32_t slot = slots.acquire();
+	if (slot == FramePool::NoFrame) {
+		queueFull.add(1); // Transmit thread is behind - backpressure
+		return;
+	}
+	
+	std::memcpy(slots.frame(slot).data(), frame.data(), frame.size());
+	const RawSocket::Offload* offload = socket.receiveOffload();
+	filled.push({slot, static_cast<uint32_t>(frame.size()), wakeTime, socket.receiveTimestamp(),
+	             offload ? *offload : RawSocket::Offload()});
+	queuedSinceWake = true;
+	
+	size_t depth = filled.size();
+	if (depth > maxQueueDepth.load(std::memory_order_relaxed)) {
+		maxQueueDepth.store(depth, std::memory_order_relaxed);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void ForwardingPipeline::wakeTransmitter() {
+	// Order the queue push before reading transmitterWaiting
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (transmitterWaiting.load(std::memory_order_relaxed)) {
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		wakeCondition.notify_one();
+	}
+}
+
+////////////////////////////////////////////////////////////
+ForwardingWorker::ForwardingWorker(RawSocket& socket, ForwardingPipeline::Classifier classifier,
+                                   TrafficStatistics& statistics, int cpu)
+	: socket(socket), classifier(std::move(classifier)), cpu(cpu), statistics(statistics.createBlock()) {
+}
+
+////////////////////////////////////////////////////////////
+ForwardingWorker::~ForwardingWorker() {
+	stop();
+}
+
+////////////////////////////////////////////////////////////
+bool ForwardingWorker::start() {
+	if (thread.joinable()) {
+		return false;
+	}
+	
+	events = PlatformFactory::createEventLoop();
+	if (!events || !events->addSocket(socket, [this]() {
+		wakeTime = TrafficStatistics::now();
+		size_t count = socket.receivePackets([this](ByteSpan frame) {
+			handleFrame(frame);
+		}, ForwardingPipeline::MaxPacketsPerWake);
+		statistics.addLoopTime(TrafficStatistics::now() - wakeTime);
+		return count > 0;
+	})) {
+		events.reset();
+		return false;
+	}
+	
+	std::promise<bool> pinned;
+	std::future<bool> ready = pinned.get_future();
+	thread = std::thread([this](std::promise<bool> pinned) {
+		bool ok = ForwardingPipeline::pinCurrentThread(cpu);
+		pinned.set_value(ok);
+		if (ok) {
+			events->run();
+		}
+	}, std::move(pinned));
+	
+	if (!ready.get()) {
+		stop();
+		return false;
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void ForwardingWorker::stop() {
+	if (!thread.joinable()) {
+		return;
+	}
+	
+	events->stop();
+	thread.join();
+	events.reset();
+}
+
+////////////////////////////////////////////////////////////
+TrafficStatistics::Snapshot ForwardingWorker::getStatistics() const {
+	TrafficStatistics::Snapshot snapshot;
+	statistics.addTo(snapshot);
+	return snapshot;
+}
+
+////////////////////////////////////////////////////////////
+void ForwardingWorker::handleFrame(ByteSpan frame) {
+	statistics.addReceived(frame.size());
+	
+	TrafficStatistics::Direction direction = TrafficStatistics::Direction::VictimToTarget;
+	switch (classifier(frame, direction)) {
+	case ForwardingPipeline::Action::Ignore:
+		break;
+	case ForwardingPipeline::Action::Drop:
+		statistics.addIntercepted(direction, frame.size());
+		statistics.addDropped();
+		break;
+	case ForwardingPipeline::Action::Forward: {
+		statistics.addIntercepted(direction, frame.size());
+		
+		// Frame was rewritten in place - send it straight from the receive buffer
+		ConstByteSpan data(frame);
+		if (socket.sendBatchWithOffload(&data, socket.receiveOffload(), 1) == 1) {
+			statistics.addForwarded(frame.size());
+			statistics.addLatency(TrafficStatistics::now() - wakeTime);
+			uint64_t receiveTime = socket.receiveTimestamp();
+			if (receiveTime != 0) {
+				uint64_t sentSystemTime = TrafficStatistics::systemNow();
+				if (sentSystemTime > receiveTime) {
+					statistics.addAddedDelay(sentSystemTime - receiveTime);
+				}
+			}
+		} else {
+			statistics.addSendFailure();
+		}
+		break;
+	}
+	}
+}
\ No newline at end of file
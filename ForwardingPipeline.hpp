@@ -0,0 +1,304 @@
+#pragma once
+
+#include "PlatformAbstraction.hpp"
+#include "SpscQueue.hpp"
+#include "FramePool.hpp"
+#include "TrafficStatistics.hpp"
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+
+////////////////////////////////////////////////////////////
+/// \brief Receive and transmit threads of the forwarder
+///
+/// Splits forwarding across two threads so that work on the
+/// control thread (ARP refresh, logging) never delays it:
+/// - the receive thread waits on the socket, classifies each
+///   frame, copies frames to forward into a preallocated
+///   slot and queues its descriptor,
+/// - the transmit thread takes descriptors from the queue
+///   and sends them in batches with RawSocket::sendBatch().
+///
+/// Slots are frames of a FramePool owned by the receive
+/// thread, each on its own cache line. They travel between
+/// the threads through two bounded lock-free SpscQueue rings
+/// (filled, and returned back to the pool), so the hot path
+/// neither locks nor allocates. If no slot is free the frame
+/// is dropped and counted in Counters::queueFull. Queued
+/// frames keep their offload state (RawSocket::Offload), so
+/// super-frames received with segmentation offload are sent
+/// whole.
+///
+/// Traffic is counted in two TrafficStatistics blocks, one
+/// per thread. Forwarding latency runs from the wakeup that
+/// delivered a frame to the end of the sendBatch() call that
+/// sent it, so it includes time spent in the queue. If the
+/// socket has receive timestamps, the delay from the kernel
+/// timestamp to the end of the send is recorded as well.
+///
+/// The socket is used concurrently: receivePackets() on the
+/// receive thread, sendBatch() on the transmit thread and
+/// sendPacket() (ARP) on the control thread.
+///
+/// The class name "ForwardingPipeline" comes from:
+/// - "Forwarding" - denotes forwarding of intercepted frames
+/// - "Pipeline" - denotes stages running on separate threads
+///
+/// \see SpscQueue, FramePool, App::startAttack()
+///
+////////////////////////////////////////////////////////////
+class ForwardingPipeline {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Decision about a received frame
+	///
+	////////////////////////////////////////////////////////////
+	enum class Action {
+		Ignore,     ///< Not intercepted traffic
+		Drop,       ///< Intercepted, must not be forwarded
+		Forward     ///< Intercepted, addresses rewritten, send it
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Classifies frame and rewrites it for forwarding
+	///
+	/// Runs on the receive thread. Sets direction for frames
+	/// classified as Drop or Forward.
+	///
+	////////////////////////////////////////////////////////////
+	using Classifier = std::function<Action(ByteSpan frame, TrafficStatistics::Direction& direction)>;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Pipeline settings
+	///
+	////////////////////////////////////////////////////////////
+	struct Config {
+		uint32_t queueSize = 4096;  ///< Frame slots
+		uint32_t slotSize = 2048;   ///< Bytes per slot, larger frames are dropped (see RawSocket::getMaxFrameSize())
+		int rxCpu = -1;             ///< CPU for receive thread (-1 - not pinned)
+		int txCpu = -1;             ///< CPU for transmit thread (-1 - not pinned)
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Snapshot of queue counters
+	///
+	/// Traffic counters are in TrafficStatistics.
+	///
+	////////////////////////////////////////////////////////////
+	struct Counters {
+		uint64_t queueFull = 0;      ///< Frames lost because no slot was free
+		uint64_t oversized = 0;      ///< Frames larger than a slot
+		size_t queueDepth = 0;       ///< Frames waiting for transmit now
+		size_t maxQueueDepth = 0;    ///< Highest observed queue depth
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// Allocates all slots and queues.
+	///
+	/// \param socket Open socket used by both threads
+	/// \param classifier Frame classifier
+	/// \param statistics Receives one counter block per thread
+	/// \param config Pipeline settings
+	///
+	////////////////////////////////////////////////////////////
+	ForwardingPipeline(RawSocket& socket, Classifier classifier, TrafficStatistics& statistics, const Config& config);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Stops the threads.
+	///
+	/// \see stop()
+	///
+	////////////////////////////////////////////////////////////
+	~ForwardingPipeline();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Starts receive and transmit threads
+	///
+	/// \return bool false if the socket cannot be waited on or
+	///         a thread cannot be pinned to its CPU
+	///
+	////////////////////////////////////////////////////////////
+	bool start();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Stops the threads
+	///
+	/// Frames already queued are sent before the transmit
+	/// thread exits.
+	///
+	////////////////////////////////////////////////////////////
+	void stop();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets current counters
+	///
+	/// Safe to call from any thread.
+	///
+	////////////////////////////////////////////////////////////
+	Counters getCounters() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Pins calling thread to a CPU
+	///
+	/// \param cpu CPU index, -1 does nothing
+	///
+	/// \return bool true if pinned (or cpu is -1), false if the
+	///         platform does not support pinning or cpu is invalid
+	///
+	////////////////////////////////////////////////////////////
+	static bool pinCurrentThread(int cpu);
+
+	static constexpr size_t MaxBatch = 64;           ///< Frames per sendBatch() call
+	static constexpr size_t MaxPacketsPerWake = 256; ///< Frames received per socket wakeup
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Queued frame
+	///
+	////////////////////////////////////////////////////////////
+	struct FrameDescriptor {
+		uint32_t slot;         ///< Slot index
+		uint32_t length;       ///< Frame length in bytes
+		uint64_t readyTime;    ///< Wakeup that delivered the frame (TrafficStatistics::now())
+		uint64_t receiveTime;  ///< Kernel receive timestamp, 0 if not requested
+		RawSocket::Offload offload; ///< Segmentation state of the frame (empty without offload)
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Body of receive thread
+	///
+	/// \param pinned Set to the result of pinning the thread
+	///
+	////////////////////////////////////////////////////////////
+	void receiveLoop(std::promise<bool> pinned);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Body of transmit thread
+	///
+	/// \param pinned Set to the result of pinning the thread
+	///
+	////////////////////////////////////////////////////////////
+	void transmitLoop(std::promise<bool> pinned);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Classifies frame and queues it for transmit
+	///
+	////////////////////////////////////////////////////////////
+	void handleFrame(ByteSpan frame);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Wakes transmit thread if it sleeps on empty queue
+	///
+	////////////////////////////////////////////////////////////
+	void wakeTransmitter();
+
+	RawSocket& socket;                        ///< Shared socket
+	Classifier classifier;                    ///< Frame classifier
+	Config config;                            ///< Settings
+	FramePool slots;                          ///< Slot storage and free list (receive thread)
+	SpscQueue<FrameDescriptor> filled;        ///< Frames from receive to transmit thread
+	SpscQueue<uint32_t> freeSlots;            ///< Sent slots from transmit back to receive thread
+	std::unique_ptr<EventLoop> receiveEvents; ///< Socket wait on receive thread
+	std::thread receiveThread;                ///< Receive thread
+	std::thread transmitThread;               ///< Transmit thread
+	bool queuedSinceWake = false;             ///< Receive thread queued frames since last wake
+	uint64_t wakeTime = 0;                    ///< Time of current receive wakeup
+
+	std::mutex wakeMutex;                         ///< Guards transmitter sleep
+	std::condition_variable wakeCondition;        ///< Wakes idle transmitter
+	std::atomic<bool> transmitterWaiting{false};  ///< Transmitter is going to sleep
+	std::atomic<bool> stopping{false};            ///< Threads must finish
+
+	TrafficStatistics::Block& receiveStatistics;  ///< Written by receive thread
+	TrafficStatistics::Block& transmitStatistics; ///< Written by transmit thread
+	alignas(CacheLineSize) ThreadCounter queueFull; ///< Written by receive thread
+	ThreadCounter oversized;                        ///< Written by receive thread
+	std::atomic<size_t> maxQueueDepth{0};           ///< Written by receive thread
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Thread that receives and forwards on one socket
+///
+/// Runs the same receive, classify and in-place forward
+/// steps as the single-threaded attack loop, on its own
+/// thread and socket. Several workers whose sockets share a
+/// fanout group (RawSocket::setFanout()) forward in
+/// parallel, one receive queue each. Each worker counts
+/// traffic in its own TrafficStatistics block.
+///
+/// The class name "ForwardingWorker" comes from:
+/// - "Forwarding" - denotes forwarding of intercepted frames
+/// - "Worker" - denotes worker thread
+///
+/// \see ForwardingPipeline, RawSocket::setFanout()
+///
+////////////////////////////////////////////////////////////
+class ForwardingWorker {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param socket Open socket used only by this worker for
+	///               receiving and forwarding
+	/// \param classifier Frame classifier
+	/// \param statistics Receives the worker's counter block
+	/// \param cpu CPU to pin the thread to (-1 - not pinned)
+	///
+	////////////////////////////////////////////////////////////
+	ForwardingWorker(RawSocket& socket, ForwardingPipeline::Classifier classifier, TrafficStatistics& statistics, int cpu);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Stops the thread.
+	///
+	////////////////////////////////////////////////////////////
+	~ForwardingWorker();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Starts worker thread
+	///
+	/// \return bool false if the socket cannot be waited on or
+	///         the thread cannot be pinned to its CPU
+	///
+	////////////////////////////////////////////////////////////
+	bool start();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Stops worker thread
+	///
+	////////////////////////////////////////////////////////////
+	void stop();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets counters of this worker only
+	///
+	/// Safe to call from any thread.
+	///
+	////////////////////////////////////////////////////////////
+	TrafficStatistics::Snapshot getStatistics() const;
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Classifies frame and forwards it in place
+	///
+	////////////////////////////////////////////////////////////
+	void handleFrame(ByteSpan frame);
+
+	RawSocket& socket;                         ///< Socket of this worker
+	ForwardingPipeline::Classifier classifier; ///< Frame classifier
+	int cpu;                                   ///< CPU for the thread
+	std::unique_ptr<EventLoop> events;         ///< Socket wait on worker thread
+	std::thread thread;                        ///< Worker thread
+	TrafficStatistics::Block& statistics;      ///< Written by worker thread
+	uint64_t wakeTime = 0;                     ///< Time of current receive wakeup
+};
\ No newline at end of file
@@ -0,0 +1,20 @@
+#include "FramePool.hpp"
+#include <new>
+
+////////////////////////////////////////////////////////////
+FramePool::FramePool(uint32_t frameCount, size_t frameSize)
+	: size(frameSize), stride((frameSize + CacheLineSize - 1) / CacheLineSize * CacheLineSize),
+	  freeFrames(frameCount > 0 ? frameCount : 1) {
+	memory = static_cast<uint8_t*>(::operator new(freeFrames.size() * stride, std::align_val_t(CacheLineSize)));
+
+	// Frame 0 on top of the stack, so a lightly used pool touches only the first frames
+	freeCount = capacity();
+	for (uint32_t i = 0; i < freeCount; ++i) {
+		freeFrames[i] = freeCount - 1 - i;
+	}
+}
+
+////////////////////////////////////////////////////////////
+FramePool::~FramePool() {
+	::operator delete(memory, std::align_val_t(CacheLineSize));
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Span.hpp"
+#include "SpscQueue.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// \brief Fixed set of preallocated frame buffers
+///
+/// All frames live in one cache-line aligned allocation made
+/// in the constructor; each frame starts on its own cache
+/// line, so frames handed to different threads never share
+/// one. Free frames are kept on a LIFO stack of indices, so
+/// the most recently released (still cached) frame is reused
+/// first. acquire() and release() are a few instructions and
+/// never allocate.
+///
+/// The pool is not thread-safe: it belongs to the thread that
+/// acquires frames. Frames passed to another thread come back
+/// through a queue (e.g. SpscQueue) and are released by the
+/// owner; frame() reads only fixed fields, so the other thread
+/// may call it.
+///
+/// Example:
+/// \code
+/// FramePool pool(64, 2048);
+/// uint32_t index = pool.acquire();
+/// if (index != FramePool::NoFrame) {
+///     size_t length = socket.receiveInto(pool.frame(index));
+///     pool.release(index);
+/// }
+/// \endcode
+///
+/// The class name "FramePool" comes from:
+/// - "Frame" - denotes buffer for one Ethernet frame
+/// - "Pool" - denotes set of reusable preallocated objects
+///
+/// \see RawSocket::setFramePool(), ForwardingPipeline
+///
+////////////////////////////////////////////////////////////
+class FramePool {
+public:
+	static constexpr uint32_t NoFrame = 0xFFFFFFFF; ///< Returned by acquire() when the pool is empty
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// Allocates all frames; every frame starts free.
+	///
+	/// \param frameCount Number of frames (at least 1)
+	/// \param frameSize Usable bytes per frame
+	///
+	////////////////////////////////////////////////////////////
+	FramePool(uint32_t frameCount, size_t frameSize);
+
+	~FramePool();
+
+	FramePool(const FramePool&) = delete;
+	FramePool& operator=(const FramePool&) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Takes a free frame
+	///
+	/// \return uint32_t Frame index, or NoFrame if all frames
+	///         are in use (counted in exhausted())
+	///
+	////////////////////////////////////////////////////////////
+	uint32_t acquire() {
+		if (freeCount == 0) {
+			++failures;
+			return NoFrame;
+		}
+		return freeFrames[--freeCount];
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Returns a frame taken with acquire()
+	///
+	/// \param index Frame index (each frame released once)
+	///
+	////////////////////////////////////////////////////////////
+	void release(uint32_t index) {
+		freeFrames[freeCount++] = index;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets the whole buffer of a frame
+	///
+	/// \return ByteSpan frameSize() bytes starting on a cache line
+	///
+	////////////////////////////////////////////////////////////
+	ByteSpan frame(uint32_t index) const {
+		return ByteSpan(memory + static_cast<size_t>(index) * stride, size);
+	}
+
+	size_t frameSize() const { return size; }
+	uint32_t capacity() const { return static_cast<uint32_t>(freeFrames.size()); }
+	uint32_t available() const { return freeCount; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets number of failed acquire() calls
+	///
+	////////////////////////////////////////////////////////////
+	uint64_t exhausted() const { return failures; }
+
+private:
+	uint8_t* memory = nullptr;          ///< capacity() * stride bytes, cache-line aligned
+	size_t size;                        ///< Usable bytes per frame
+	size_t stride;                      ///< size rounded up to CacheLineSize
+	std::vector<uint32_t> freeFrames;   ///< Stack of free indices, first freeCount valid
+	uint32_t freeCount = 0;             ///< Number of free frames
+	uint64_t failures = 0;              ///< Failed acquire() calls
+};
\ No newline at end of file
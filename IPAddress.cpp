@@ -1,75 +1,48 @@
 #include "IPAddress.hpp"
-#include <sstream>
-#include <iomanip>
 #include <stdexcept>
 #include <algorithm>
 #include <cctype>
+#include <type_traits>
 
-// Predefiniowane adresy IP
-const IPAddress IPAddress::Any(0, 0, 0, 0);
-const IPAddress IPAddress::Localhost(127, 0, 0, 1);
-const IPAddress IPAddress::Broadcast(255, 255, 255, 255);
-
-////////////////////////////////////////////////////////////
-IPAddress::IPAddress() : address(4, 0) {}
+static_assert(std::is_trivially_copyable<IPAddress>::value, "IPAddress musi być trywialnie kopiowalny");
+static_assert(sizeof(IPAddress) == sizeof(uint32_t), "IPAddress musi zajmować dokładnie 4 bajty");
 
-////////////////////////////////////////////////////////////
-IPAddress::IPAddress(const std::string& ipString) : address(4, 0) {
-	*this = fromString(ipString);
-}
+namespace {
 
 ////////////////////////////////////////////////////////////
-IPAddress::IPAddress(const uint8_t bytes[4]) : address(bytes, bytes + 4) {}
-
+/// \brief Checks if character is a decimal digit
+///
 ////////////////////////////////////////////////////////////
-IPAddress::IPAddress(const std::vector<uint8_t>& bytes) : address(bytes) {
-	if (address.size() != 4) {
-		address.resize(4, 0);
-	}
+inline bool isDigit(char c) {
+	return c >= '0' && c <= '9';
 }
 
 ////////////////////////////////////////////////////////////
-IPAddress::IPAddress(uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4) 
-	: address{b1, b2, b3, b4} {}
-
+/// \brief Checks if character separates addresses in parseAll()
+///
 ////////////////////////////////////////////////////////////
-bool IPAddress::operator==(const IPAddress& other) const {
-	return address == other.address;
+inline bool isSeparator(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';';
 }
 
-////////////////////////////////////////////////////////////
-bool IPAddress::operator!=(const IPAddress& other) const {
-	return !(*this == other);
-}
+} // namespace
 
-////////////////////////////////////////////////////////////
-bool IPAddress::operator<(const IPAddress& other) const {
-	return address < other.address;
-}
-
-////////////////////////////////////////////////////////////
-bool IPAddress::operator>(const IPAddress& other) const {
-	return other < *this;
-}
-
-////////////////////////////////////////////////////////////
-bool IPAddress::operator<=(const IPAddress& other) const {
-	return !(other < *this);
-}
-
-////////////////////////////////////////////////////////////
-bool IPAddress::operator>=(const IPAddress& other) const {
-	return !(*this < other);
-}
+// Predefiniowane adresy IP
+const IPAddress IPAddress::Any(0, 0, 0, 0);
+const IPAddress IPAddress::Localhost(127, 0, 0, 1);
+const IPAddress IPAddress::Broadcast(255, 255, 255, 255);
 
 ////////////////////////////////////////////////////////////
-uint8_t& IPAddress::operator[](size_t index) {
-	return address[index];
+IPAddress::IPAddress(const std::string& ipString) : value(0) {
+	*this = fromString(ipString);
 }
 
 ////////////////////////////////////////////////////////////
-const uint8_t& IPAddress::operator[](size_t index) const {
-	return address[index];
+IPAddress::IPAddress(const std::vector<uint8_t>& bytes) : value(0) {
+	// Brakujące bajty traktuj jako zera (jak wcześniejsze resize(4, 0))
+	for (size_t i = 0; i < 4 && i < bytes.size(); ++i) {
+		value |= static_cast<uint32_t>(bytes[i]) << (24 - 8 * i);
+	}
 }
 
 ////////////////////////////////////////////////////////////
@@ -83,197 +56,125 @@ IPAddress::operator std::vector<uint8_t>() const {
 }
 
 ////////////////////////////////////////////////////////////
-IPAddress IPAddress::operator&(const IPAddress& other) const {
-	IPAddress result;
-	for (size_t i = 0; i < 4; ++i) {
-		result.address[i] = address[i] & other.address[i];
-	}
-	return result;
+std::string IPAddress::toString() const {
+	// Maksymalnie 15 znaków - mieści się w buforze SSO, bez alokacji
+	char buffer[MaxStringLength];
+	return std::string(buffer, toChars(buffer));
 }
 
 ////////////////////////////////////////////////////////////
-IPAddress IPAddress::operator|(const IPAddress& other) const {
-	IPAddress result;
+char* IPAddress::toChars(char* buffer) const {
 	for (size_t i = 0; i < 4; ++i) {
-		result.address[i] = address[i] | other.address[i];
+		if (i > 0) {
+			*buffer++ = '.';
+		}
+		
+		unsigned octet = (*this)[i];
+		if (octet >= 100) {
+			*buffer++ = static_cast<char>('0' + octet / 100);
+			octet %= 100;
+			*buffer++ = static_cast<char>('0' + octet / 10);
+			*buffer++ = static_cast<char>('0' + octet % 10);
+		} else if (octet >= 10) {
+			*buffer++ = static_cast<char>('0' + octet / 10);
+			*buffer++ = static_cast<char>('0' + octet % 10);
+		} else {
+			*buffer++ = static_cast<char>('0' + octet);
+		}
 	}
-	return result;
+	return buffer;
 }
 
 ////////////////////////////////////////////////////////////
-IPAddress IPAddress::operator^(const IPAddress& other) const {
-	IPAddress result;
-	for (size_t i = 0; i < 4; ++i) {
-		result.address[i] = address[i] ^ other.address[i];
-	}
-	return result;
+std::vector<uint8_t> IPAddress::toBytes() const {
+	auto bytes = toArray();
+	return std::vector<uint8_t>(bytes.begin(), bytes.end());
 }
 
 ////////////////////////////////////////////////////////////
-IPAddress IPAddress::operator~() const {
+IPAddress IPAddress::fromString(std::string_view ipString) {
 	IPAddress result;
-	for (size_t i = 0; i < 4; ++i) {
-		result.address[i] = ~address[i];
+	const char* end = ipString.data() + ipString.size();
+	
+	// Cały napis musi być adresem - żadnych dodatkowych znaków
+	if (parse(ipString.data(), end, result) != end) {
+		return Any;
 	}
 	return result;
 }
 
 ////////////////////////////////////////////////////////////
-IPAddress IPAddress::operator<<(int shift) const {
-	IPAddress result = *this;
-	uint32_t value = toUint32();
-	value <<= shift;
-	result = fromUint32(value);
-	return result;
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::operator>>(int shift) const {
-	IPAddress result = *this;
-	uint32_t value = toUint32();
-	value >>= shift;
-	result = fromUint32(value);
-	return result;
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::operator+(uint32_t value) const {
-	uint32_t current = toUint32();
-	current += value;
-	return fromUint32(current);
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::operator-(uint32_t value) const {
-	uint32_t current = toUint32();
-	current -= value;
-	return fromUint32(current);
-}
-
-////////////////////////////////////////////////////////////
-IPAddress& IPAddress::operator++() {
-	uint32_t value = toUint32();
-	value++;
-	*this = fromUint32(value);
-	return *this;
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::operator++(int) {
-	IPAddress temp = *this;
-	++(*this);
-	return temp;
-}
-
-////////////////////////////////////////////////////////////
-IPAddress& IPAddress::operator--() {
-	uint32_t value = toUint32();
-	value--;
-	*this = fromUint32(value);
-	return *this;
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::operator--(int) {
-	IPAddress temp = *this;
-	--(*this);
-	return temp;
-}
-
-////////////////////////////////////////////////////////////
-bool IPAddress::isValid() const {
-	return !isEmpty();
-}
-
-////////////////////////////////////////////////////////////
-bool IPAddress::isEmpty() const {
-	return *this == Any;
-}
-
-////////////////////////////////////////////////////////////
-bool IPAddress::isLocalhost() const {
-	return address[0] == 127;
-}
-
-////////////////////////////////////////////////////////////
-bool IPAddress::isPrivate() const {
-	// 10.0.0.0/8
-	if (address[0] == 10) return true;
-	
-	// 172.16.0.0/12
-	if (address[0] == 172 && address[1] >= 16 && address[1] <= 31) return true;
+const char* IPAddress::parse(const char* first, const char* last, IPAddress& result) {
+	uint32_t address = 0;
+	const char* p = first;
 	
-	// 192.168.0.0/16
-	if (address[0] == 192 && address[1] == 168) return true;
+	for (int i = 0; i < 4; ++i) {
+		if (i > 0) {
+			if (p == last || *p != '.') {
+				return nullptr;
+			}
+			++p;
+		}
+		
+		if (p == last || !isDigit(*p)) {
+			return nullptr; // Pusty oktet
+		}
+		
+		uint32_t octet = static_cast<uint32_t>(*p++ - '0');
+		if (octet != 0) {
+			// Co najwyżej trzy cyfry w oktecie
+			for (int digits = 1; digits < 3 && p != last && isDigit(*p); ++digits) {
+				octet = octet * 10 + static_cast<uint32_t>(*p++ - '0');
+			}
+			if (octet > 255) {
+				return nullptr; // Przepełnienie
+			}
+		}
+		
+		// Cyfra po "0" to zero wiodące, cyfra po trzech cyfrach to przepełnienie
+		if (p != last && isDigit(*p)) {
+			return nullptr;
+		}
+		
+		address = (address << 8) | octet;
+	}
 	
-	return false;
-}
-
-////////////////////////////////////////////////////////////
-bool IPAddress::isPublic() const {
-	return !isLocalhost() && !isPrivate() && !isEmpty();
-}
-
-////////////////////////////////////////////////////////////
-bool IPAddress::isInSameNetwork(const IPAddress& other, const IPAddress& mask) const {
-	IPAddress network1 = getNetworkAddress(mask);
-	IPAddress network2 = other.getNetworkAddress(mask);
-	return network1 == network2;
+	result = fromUint32(address);
+	return p;
 }
 
 ////////////////////////////////////////////////////////////
-std::string IPAddress::toString() const {
-	std::ostringstream oss;
-	oss << static_cast<int>(address[0]) << "."
-		<< static_cast<int>(address[1]) << "."
-		<< static_cast<int>(address[2]) << "."
-		<< static_cast<int>(address[3]);
-	return oss.str();
-}
-
-////////////////////////////////////////////////////////////
-std::vector<uint8_t> IPAddress::toBytes() const {
-	return address;
-}
-
-////////////////////////////////////////////////////////////
-uint32_t IPAddress::toUint32() const {
-	return (static_cast<uint32_t>(address[0]) << 24) |
-		   (static_cast<uint32_t>(address[1]) << 16) |
-		   (static_cast<uint32_t>(address[2]) << 8) |
-		   static_cast<uint32_t>(address[3]);
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::fromString(const std::string& ipString) {
-	IPAddress result;
-	std::istringstream iss(ipString);
-	std::string token;
+size_t IPAddress::parseAll(std::string_view text, IPAddress* results, size_t capacity,
+                           size_t* rejected) {
+	size_t count = 0;
+	size_t skipped = 0;
+	const char* p = text.data();
+	const char* end = p + text.size();
 	
-	for (int i = 0; i < 4; ++i) {
-		if (!std::getline(iss, token, '.')) {
-			return Any; // Błąd parsowania
+	while (p != end && count < capacity) {
+		if (isSeparator(*p)) {
+			++p;
+			continue;
 		}
 		
-		// Sprawdź czy token zawiera tylko cyfry
-		if (token.empty() || token.find_first_not_of("0123456789") != std::string::npos) {
-			return Any;
+		const char* tokenEnd = p;
+		while (tokenEnd != end && !isSeparator(*tokenEnd)) {
+			++tokenEnd;
 		}
 		
-		int value = std::stoi(token);
-		if (value < 0 || value > 255) {
-			return Any; // Nieprawidłowa wartość
+		IPAddress address;
+		if (parse(p, tokenEnd, address) == tokenEnd) {
+			results[count++] = address;
+		} else {
+			++skipped;
 		}
-		
-		result.address[i] = static_cast<uint8_t>(value);
+		p = tokenEnd;
 	}
 	
-	// Sprawdź czy nie ma dodatkowych tokenów
-	if (std::getline(iss, token)) {
-		return Any;
+	if (rejected) {
+		*rejected = skipped;
 	}
-	
-	return result;
+	return count;
 }
 
 ////////////////////////////////////////////////////////////
@@ -281,60 +182,7 @@ IPAddress IPAddress::fromBytes(const std::vector<uint8_t>& bytes) {
 	if (bytes.size() != 4) {
 		return Any;
 	}
-	return IPAddress(bytes);
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::fromUint32(uint32_t value) {
-	IPAddress result;
-	result.address[0] = static_cast<uint8_t>((value >> 24) & 0xFF);
-	result.address[1] = static_cast<uint8_t>((value >> 16) & 0xFF);
-	result.address[2] = static_cast<uint8_t>((value >> 8) & 0xFF);
-	result.address[3] = static_cast<uint8_t>(value & 0xFF);
-	return result;
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::fromPrefixLength(uint8_t prefixLength) {
-	if (prefixLength > 32) {
-		return Any;
-	}
-	
-	uint32_t mask = 0xFFFFFFFF << (32 - prefixLength);
-	return fromUint32(mask);
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::getNetworkAddress(const IPAddress& mask) const {
-	return *this & mask;
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::getBroadcastAddress(const IPAddress& mask) const {
-	return *this | ~mask;
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::getFirstHostAddress(const IPAddress& mask) const {
-	IPAddress network = getNetworkAddress(mask);
-	return network + 1;
-}
-
-////////////////////////////////////////////////////////////
-IPAddress IPAddress::getLastHostAddress(const IPAddress& mask) const {
-	IPAddress broadcast = getBroadcastAddress(mask);
-	return broadcast - 1;
-}
-
-////////////////////////////////////////////////////////////
-uint32_t IPAddress::getHostCount(const IPAddress& mask) const {
-	IPAddress network = getNetworkAddress(mask);
-	IPAddress broadcast = network.getBroadcastAddress(mask);
-	
-	uint32_t networkValue = network.toUint32();
-	uint32_t broadcastValue = broadcast.toUint32();
-	
-	return broadcastValue - networkValue - 1;
+	return IPAddress(bytes.data());
 }
 
 ////////////////////////////////////////////////////////////
@@ -342,12 +190,13 @@ uint8_t IPAddress::at(size_t index) const {
 	if (index >= 4) {
 		throw std::out_of_range("IPAddress index out of range");
 	}
-	return address[index];
+	return (*this)[index];
 }
 
 ////////////////////////////////////////////////////////////
 std::ostream& operator<<(std::ostream& os, const IPAddress& ip) {
-	os << ip.toString();
+	char buffer[IPAddress::MaxStringLength];
+	os.write(buffer, ip.toChars(buffer) - buffer);
 	return os;
 }
 
@@ -357,4 +206,4 @@ std::istream& operator>>(std::istream& is, IPAddress& ip) {
 	is >> ipString;
 	ip = IPAddress::fromString(ipString);
 	return is;
-} 
\ No newline at end of file
+}
\ No newline at end of file
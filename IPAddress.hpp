@@ -1,9 +1,13 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
 #include <cstdint>
+#include <cstddef>
 #include <cstring>
+#include <iterator>
 #include <iostream>
 
 ////////////////////////////////////////////////////////////
@@ -18,24 +22,58 @@
 /// - "IP" - denotes Internet Protocol
 /// - "Address" - denotes network address
 ///
-/// The class uses modern C++17 features and provides
-/// safe memory management.
+/// The address is stored as a single 32-bit integer in host
+/// byte order, so the class is trivially copyable, never
+/// allocates and every comparison, mask and arithmetic
+/// operation compiles down to one integer instruction.
+/// Most of the interface is constexpr.
 ///
-/// \see MACAddress, NetworkUtils
+/// \see MacAddress, NetworkUtils
 ///
 ////////////////////////////////////////////////////////////
 class IPAddress {
 private:
-	std::vector<uint8_t> address; ///< IP address as vector of 4 bytes
+	uint32_t value; ///< IP address as 32-bit integer in host byte order
 
 public:
+	////////////////////////////////////////////////////////////
+	/// \brief Read-only iterator over address bytes
+	///
+	/// Yields the four bytes of the address in network order
+	/// (most significant first), independently of how the
+	/// value is laid out in memory.
+	///
+	/// \see begin(), end()
+	///
+	////////////////////////////////////////////////////////////
+	class const_iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = uint8_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const uint8_t*;
+		using reference = uint8_t;
+
+		constexpr const_iterator(const IPAddress* address, size_t index) : address(address), index(index) {}
+
+		constexpr uint8_t operator*() const { return (*address)[index]; }
+		constexpr const_iterator& operator++() { ++index; return *this; }
+		constexpr const_iterator operator++(int) { const_iterator temp = *this; ++index; return temp; }
+		constexpr bool operator==(const const_iterator& other) const { return index == other.index && address == other.address; }
+		constexpr bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+	private:
+		const IPAddress* address; ///< Iterated address
+		size_t index;             ///< Current byte index (0-4)
+	};
+
 	////////////////////////////////////////////////////////////
 	/// \brief Default constructor
 	///
 	/// Creates empty IP address (0.0.0.0).
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress();
+	constexpr IPAddress() : value(0) {}
 
 	////////////////////////////////////////////////////////////
 	/// \brief Constructor from string
@@ -52,19 +90,25 @@ public:
 	////////////////////////////////////////////////////////////
 	/// \brief Constructor from byte array
 	///
-	/// Creates IP address from array of 4 bytes.
+	/// Creates IP address from array of 4 bytes in network
+	/// order, e.g. straight from a packet header.
 	///
 	/// \param bytes Array of 4 bytes representing IP address
 	///
 	////////////////////////////////////////////////////////////
-	explicit IPAddress(const uint8_t bytes[4]);
+	constexpr explicit IPAddress(const uint8_t bytes[4])
+		: value((static_cast<uint32_t>(bytes[0]) << 24) |
+		        (static_cast<uint32_t>(bytes[1]) << 16) |
+		        (static_cast<uint32_t>(bytes[2]) << 8) |
+		        static_cast<uint32_t>(bytes[3])) {}
 
 	////////////////////////////////////////////////////////////
 	/// \brief Constructor from byte vector
 	///
 	/// Creates IP address from byte vector.
 	///
-	/// \param bytes Byte vector (must have 4 elements)
+	/// \param bytes Byte vector (must have 4 elements,
+	///              otherwise missing bytes are zero)
 	///
 	////////////////////////////////////////////////////////////
 	explicit IPAddress(const std::vector<uint8_t>& bytes);
@@ -80,7 +124,11 @@ public:
 	/// \param b4 Fourth byte
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress(uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4);
+	constexpr IPAddress(uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4)
+		: value((static_cast<uint32_t>(b1) << 24) |
+		        (static_cast<uint32_t>(b2) << 16) |
+		        (static_cast<uint32_t>(b3) << 8) |
+		        static_cast<uint32_t>(b4)) {}
 
 	////////////////////////////////////////////////////////////
 	/// \brief Copy constructor
@@ -88,7 +136,7 @@ public:
 	/// \param other IP address to copy
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress(const IPAddress& other) = default;
+	constexpr IPAddress(const IPAddress& other) = default;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Copy assignment operator
@@ -98,30 +146,12 @@ public:
 	/// \return IPAddress& Reference to this object
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress& operator=(const IPAddress& other) = default;
-
-	////////////////////////////////////////////////////////////
-	/// \brief Move constructor
-	///
-	/// \param other IP address to move
-	///
-	////////////////////////////////////////////////////////////
-	IPAddress(IPAddress&& other) noexcept = default;
-
-	////////////////////////////////////////////////////////////
-	/// \brief Move assignment operator
-	///
-	/// \param other IP address to move
-	///
-	/// \return IPAddress& Reference to this object
-	///
-	////////////////////////////////////////////////////////////
-	IPAddress& operator=(IPAddress&& other) noexcept = default;
+	constexpr IPAddress& operator=(const IPAddress& other) = default;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Destructor
 	///
-	/// Automatically releases resources.
+	/// Trivial - the class owns no resources.
 	///
 	////////////////////////////////////////////////////////////
 	~IPAddress() = default;
@@ -136,7 +166,7 @@ public:
 	/// \see operator!=()
 	///
 	////////////////////////////////////////////////////////////
-	bool operator==(const IPAddress& other) const;
+	constexpr bool operator==(const IPAddress& other) const { return value == other.value; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Inequality comparison operator
@@ -148,7 +178,7 @@ public:
 	/// \see operator==()
 	///
 	////////////////////////////////////////////////////////////
-	bool operator!=(const IPAddress& other) const;
+	constexpr bool operator!=(const IPAddress& other) const { return value != other.value; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Less than comparison operator
@@ -162,7 +192,7 @@ public:
 	/// \see operator>(), operator<=(), operator>=()
 	///
 	////////////////////////////////////////////////////////////
-	bool operator<(const IPAddress& other) const;
+	constexpr bool operator<(const IPAddress& other) const { return value < other.value; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Greater than comparison operator
@@ -176,7 +206,7 @@ public:
 	/// \see operator<(), operator<=(), operator>=()
 	///
 	////////////////////////////////////////////////////////////
-	bool operator>(const IPAddress& other) const;
+	constexpr bool operator>(const IPAddress& other) const { return value > other.value; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Less than or equal comparison operator
@@ -188,7 +218,7 @@ public:
 	/// \see operator<(), operator>(), operator>=()
 	///
 	////////////////////////////////////////////////////////////
-	bool operator<=(const IPAddress& other) const;
+	constexpr bool operator<=(const IPAddress& other) const { return value <= other.value; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Greater than or equal comparison operator
@@ -200,7 +230,7 @@ public:
 	/// \see operator<(), operator>(), operator<=()
 	///
 	////////////////////////////////////////////////////////////
-	bool operator>=(const IPAddress& other) const;
+	constexpr bool operator>=(const IPAddress& other) const { return value >= other.value; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Bitwise AND operator
@@ -215,7 +245,7 @@ public:
 	/// \see operator|(), operator~()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress operator&(const IPAddress& other) const;
+	constexpr IPAddress operator&(const IPAddress& other) const { return fromUint32(value & other.value); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Bitwise OR operator
@@ -230,7 +260,7 @@ public:
 	/// \see operator&(), operator~()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress operator|(const IPAddress& other) const;
+	constexpr IPAddress operator|(const IPAddress& other) const { return fromUint32(value | other.value); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Bitwise NOT operator
@@ -243,7 +273,7 @@ public:
 	/// \see operator&(), operator|()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress operator~() const;
+	constexpr IPAddress operator~() const { return fromUint32(~value); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Bitwise XOR operator
@@ -257,12 +287,14 @@ public:
 	/// \see operator&(), operator|(), operator~()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress operator^(const IPAddress& other) const;
+	constexpr IPAddress operator^(const IPAddress& other) const { return fromUint32(value ^ other.value); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Array access operator (non-const)
 	///
 	/// Provides access to individual bytes of IP address.
+	/// Index 0 is the most significant byte ("192" in
+	/// "192.168.1.1").
 	///
 	/// \param index Byte index (0-3)
 	///
@@ -271,7 +303,9 @@ public:
 	/// \see operator[] const
 	///
 	////////////////////////////////////////////////////////////
-	uint8_t& operator[](size_t index);
+	uint8_t& operator[](size_t index) {
+		return reinterpret_cast<uint8_t*>(&value)[byteOffset(index)];
+	}
 
 	////////////////////////////////////////////////////////////
 	/// \brief Array access operator (const)
@@ -280,12 +314,14 @@ public:
 	///
 	/// \param index Byte index (0-3)
 	///
-	/// \return const uint8_t& Reference to byte at index
+	/// \return uint8_t Byte at index
 	///
 	/// \see operator[]
 	///
 	////////////////////////////////////////////////////////////
-	const uint8_t& operator[](size_t index) const;
+	constexpr uint8_t operator[](size_t index) const {
+		return static_cast<uint8_t>(value >> (24 - 8 * index));
+	}
 
 	////////////////////////////////////////////////////////////
 	/// \brief Left shift operator
@@ -299,7 +335,7 @@ public:
 	/// \see operator>>()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress operator<<(int shift) const;
+	constexpr IPAddress operator<<(int shift) const { return fromUint32(value << shift); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Right shift operator
@@ -313,7 +349,7 @@ public:
 	/// \see operator<<()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress operator>>(int shift) const;
+	constexpr IPAddress operator>>(int shift) const { return fromUint32(value >> shift); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Addition operator
@@ -327,7 +363,7 @@ public:
 	/// \see operator-()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress operator+(uint32_t value) const;
+	constexpr IPAddress operator+(uint32_t value) const { return fromUint32(this->value + value); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Subtraction operator
@@ -341,7 +377,7 @@ public:
 	/// \see operator+()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress operator-(uint32_t value) const;
+	constexpr IPAddress operator-(uint32_t value) const { return fromUint32(this->value - value); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Pre-increment operator
@@ -353,7 +389,7 @@ public:
 	/// \see operator++(int), operator--()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress& operator++();
+	constexpr IPAddress& operator++() { ++value; return *this; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Post-increment operator
@@ -365,7 +401,7 @@ public:
 	/// \see operator++(), operator--(int)
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress operator++(int);
+	constexpr IPAddress operator++(int) { IPAddress temp = *this; ++value; return temp; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Pre-decrement operator
@@ -377,7 +413,7 @@ public:
 	/// \see operator--(int), operator++()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress& operator--();
+	constexpr IPAddress& operator--() { --value; return *this; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Post-decrement operator
@@ -389,7 +425,7 @@ public:
 	/// \see operator--(), operator++(int)
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress operator--(int);
+	constexpr IPAddress operator--(int) { IPAddress temp = *this; --value; return temp; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief String conversion operator
@@ -418,35 +454,35 @@ public:
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if IP address is valid
 	///
-	/// Validates that the IP address contains exactly 4 bytes
-	/// and all values are within valid range (0-255).
+	/// Every bit pattern is a well-formed IPv4 address, so
+	/// the address is considered valid unless it is 0.0.0.0.
 	///
 	/// \return bool true if address is valid
 	///
 	/// \see isEmpty()
 	///
 	////////////////////////////////////////////////////////////
-	bool isValid() const;
+	constexpr bool isValid() const { return !isEmpty(); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if IP address is empty
 	///
-	/// \return bool true if address is empty (no bytes)
+	/// \return bool true if address is 0.0.0.0
 	///
 	/// \see isValid()
 	///
 	////////////////////////////////////////////////////////////
-	bool isEmpty() const;
+	constexpr bool isEmpty() const { return value == 0; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if IP address is localhost
 	///
-	/// \return bool true if address is 127.0.0.1
+	/// \return bool true if address is in 127.0.0.0/8
 	///
 	/// \see isPrivate(), isPublic()
 	///
 	////////////////////////////////////////////////////////////
-	bool isLocalhost() const;
+	constexpr bool isLocalhost() const { return (value >> 24) == 127; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if IP address is private
@@ -459,7 +495,11 @@ public:
 	/// \see isLocalhost(), isPublic()
 	///
 	////////////////////////////////////////////////////////////
-	bool isPrivate() const;
+	constexpr bool isPrivate() const {
+		return (value & 0xFF000000u) == 0x0A000000u ||  // 10.0.0.0/8
+		       (value & 0xFFF00000u) == 0xAC100000u ||  // 172.16.0.0/12
+		       (value & 0xFFFF0000u) == 0xC0A80000u;    // 192.168.0.0/16
+	}
 
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if IP address is public
@@ -469,7 +509,7 @@ public:
 	/// \see isLocalhost(), isPrivate()
 	///
 	////////////////////////////////////////////////////////////
-	bool isPublic() const;
+	constexpr bool isPublic() const { return !isLocalhost() && !isPrivate() && !isEmpty(); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if IP address is in same network
@@ -480,28 +520,63 @@ public:
 	/// \return bool true if addresses are in same network
 	///
 	////////////////////////////////////////////////////////////
-	bool isInSameNetwork(const IPAddress& other, const IPAddress& mask) const;
+	constexpr bool isInSameNetwork(const IPAddress& other, const IPAddress& mask) const {
+		return ((value ^ other.value) & mask.value) == 0;
+	}
 
 	////////////////////////////////////////////////////////////
 	/// \brief Converts IP address to string
 	///
 	/// \return std::string IP address in "192.168.1.1" format
 	///
-	/// \see fromString()
+	/// \see fromString(), toChars()
 	///
 	////////////////////////////////////////////////////////////
 	std::string toString() const;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Formats IP address into character buffer
+	///
+	/// Writes the dotted form without terminating null and
+	/// without allocating. The buffer must hold at least
+	/// MaxStringLength characters.
+	///
+	/// \param buffer Destination buffer
+	///
+	/// \return char* Pointer one past the last written character
+	///
+	/// \see toString(), parse()
+	///
+	////////////////////////////////////////////////////////////
+	char* toChars(char* buffer) const;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Converts IP address to byte vector
 	///
+	/// Allocates - prefer toArray() on hot paths.
+	///
 	/// \return std::vector<uint8_t> Vector of 4 bytes
 	///
-	/// \see fromBytes()
+	/// \see fromBytes(), toArray()
 	///
 	////////////////////////////////////////////////////////////
 	std::vector<uint8_t> toBytes() const;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Converts IP address to byte array
+	///
+	/// Allocation-free counterpart of toBytes(), suitable for
+	/// copying the address into packet headers.
+	///
+	/// \return std::array<uint8_t, 4> Bytes in network order
+	///
+	/// \see toBytes()
+	///
+	////////////////////////////////////////////////////////////
+	constexpr std::array<uint8_t, 4> toArray() const {
+		return {{(*this)[0], (*this)[1], (*this)[2], (*this)[3]}};
+	}
+
 	////////////////////////////////////////////////////////////
 	/// \brief Converts IP address to 32-bit integer
 	///
@@ -510,21 +585,62 @@ public:
 	/// \see fromUint32()
 	///
 	////////////////////////////////////////////////////////////
-	uint32_t toUint32() const;
+	constexpr uint32_t toUint32() const { return value; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Creates IP address from string
 	///
 	/// Static factory method to create IP address from string.
+	/// The whole string must be a dotted-quad address.
 	///
 	/// \param ipString IP address string
 	///
-	/// \return IPAddress IP address object
+	/// \return IPAddress IP address object (Any if string is invalid)
 	///
-	/// \see toString()
+	/// \see toString(), parse()
+	///
+	////////////////////////////////////////////////////////////
+	static IPAddress fromString(std::string_view ipString);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Parses IP address from the start of a character range
+	///
+	/// Non-allocating strict parser in the spirit of
+	/// std::from_chars: accepts exactly four decimal octets
+	/// separated by dots, rejects leading zeros ("01"),
+	/// values above 255 and empty octets. Parsing stops at the
+	/// first character that cannot continue the address.
+	///
+	/// \param first Beginning of the range
+	/// \param last End of the range
+	/// \param result Parsed address (written only on success)
+	///
+	/// \return const char* Pointer past the address or nullptr on error
+	///
+	/// \see fromString(), parseAll()
+	///
+	////////////////////////////////////////////////////////////
+	static const char* parse(const char* first, const char* last, IPAddress& result);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Parses all addresses from a text buffer
+	///
+	/// Splits the buffer on whitespace, commas and semicolons
+	/// and parses each token with parse(). Tokens that are not
+	/// valid addresses are skipped.
+	///
+	/// \param text Buffer with addresses
+	/// \param results Output array
+	/// \param capacity Number of elements in results
+	/// \param rejected Optional counter of skipped tokens
+	///
+	/// \return size_t Number of addresses stored in results
+	///
+	/// \see parse()
 	///
 	////////////////////////////////////////////////////////////
-	static IPAddress fromString(const std::string& ipString);
+	static size_t parseAll(std::string_view text, IPAddress* results, size_t capacity,
+	                       size_t* rejected = nullptr);
 
 	////////////////////////////////////////////////////////////
 	/// \brief Creates IP address from byte vector
@@ -552,7 +668,11 @@ public:
 	/// \see toUint32()
 	///
 	////////////////////////////////////////////////////////////
-	static IPAddress fromUint32(uint32_t value);
+	static constexpr IPAddress fromUint32(uint32_t value) {
+		IPAddress result;
+		result.value = value;
+		return result;
+	}
 
 	////////////////////////////////////////////////////////////
 	/// \brief Creates network mask from prefix length
@@ -561,10 +681,15 @@ public:
 	///
 	/// \param prefixLength Prefix length (0-32)
 	///
-	/// \return IPAddress Network mask
+	/// \return IPAddress Network mask (0.0.0.0 if prefix is out of range)
 	///
 	////////////////////////////////////////////////////////////
-	static IPAddress fromPrefixLength(uint8_t prefixLength);
+	static constexpr IPAddress fromPrefixLength(uint8_t prefixLength) {
+		if (prefixLength == 0 || prefixLength > 32) {
+			return IPAddress();
+		}
+		return fromUint32(0xFFFFFFFFu << (32 - prefixLength));
+	}
 
 	////////////////////////////////////////////////////////////
 	/// \brief Gets network address
@@ -578,7 +703,7 @@ public:
 	/// \see getBroadcastAddress()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress getNetworkAddress(const IPAddress& mask) const;
+	constexpr IPAddress getNetworkAddress(const IPAddress& mask) const { return *this & mask; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Gets broadcast address
@@ -592,7 +717,7 @@ public:
 	/// \see getNetworkAddress()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress getBroadcastAddress(const IPAddress& mask) const;
+	constexpr IPAddress getBroadcastAddress(const IPAddress& mask) const { return *this | ~mask; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Gets first host address
@@ -606,7 +731,7 @@ public:
 	/// \see getLastHostAddress()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress getFirstHostAddress(const IPAddress& mask) const;
+	constexpr IPAddress getFirstHostAddress(const IPAddress& mask) const { return getNetworkAddress(mask) + 1; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Gets last host address
@@ -620,7 +745,7 @@ public:
 	/// \see getFirstHostAddress()
 	///
 	////////////////////////////////////////////////////////////
-	IPAddress getLastHostAddress(const IPAddress& mask) const;
+	constexpr IPAddress getLastHostAddress(const IPAddress& mask) const { return getBroadcastAddress(mask) - 1; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Gets number of hosts in network
@@ -634,7 +759,7 @@ public:
 	/// \see getFirstHostAddress(), getLastHostAddress()
 	///
 	////////////////////////////////////////////////////////////
-	uint32_t getHostCount(const IPAddress& mask) const;
+	constexpr uint32_t getHostCount(const IPAddress& mask) const { return ~mask.value - 1; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Gets byte at specified index
@@ -656,42 +781,64 @@ public:
 	/// \return size_t Always returns 4
 	///
 	////////////////////////////////////////////////////////////
-	size_t size() const { return 4; }
+	constexpr size_t size() const { return 4; }
 
 	////////////////////////////////////////////////////////////
-	/// \brief Checks if IP address is empty
+	/// \brief Checks if IP address has no bytes
+	///
+	/// An address always holds 4 bytes; kept for container-like
+	/// usage.
 	///
-	/// \return bool true if address has no bytes
+	/// \return bool Always false
 	///
 	/// \see isEmpty()
 	///
 	////////////////////////////////////////////////////////////
-	bool empty() const { return address.empty(); }
+	constexpr bool empty() const { return false; }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Gets iterator to beginning
 	///
-	/// \return std::vector<uint8_t>::const_iterator Iterator to first byte
+	/// \return const_iterator Iterator to first byte
 	///
 	/// \see end()
 	///
 	////////////////////////////////////////////////////////////
-	std::vector<uint8_t>::const_iterator begin() const { return address.begin(); }
+	constexpr const_iterator begin() const { return const_iterator(this, 0); }
 
 	////////////////////////////////////////////////////////////
 	/// \brief Gets iterator to end
 	///
-	/// \return std::vector<uint8_t>::const_iterator Iterator past last byte
+	/// \return const_iterator Iterator past last byte
 	///
 	/// \see begin()
 	///
 	////////////////////////////////////////////////////////////
-	std::vector<uint8_t>::const_iterator end() const { return address.end(); }
+	constexpr const_iterator end() const { return const_iterator(this, 4); }
+
+	static constexpr size_t MaxStringLength = 15; ///< Length of "255.255.255.255"
 
 	// Predefined addresses
 	static const IPAddress Any;        ///< 0.0.0.0 - any address
 	static const IPAddress Localhost;  ///< 127.0.0.1 - localhost
 	static const IPAddress Broadcast;  ///< 255.255.255.255 - broadcast
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Maps byte index to offset inside the stored value
+	///
+	/// \param index Byte index (0-3), 0 being most significant
+	///
+	/// \return size_t Offset of that byte in memory
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr size_t byteOffset(size_t index) {
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+		return 3 - index;
+#else
+		return index;
+#endif
+	}
 };
 
 ////////////////////////////////////////////////////////////
@@ -722,4 +869,4 @@ std::ostream& operator<<(std::ostream& os, const IPAddress& ip);
 /// \see operator<<()
 ///
 ////////////////////////////////////////////////////////////
-std::istream& operator>>(std::istream& is, IPAddress& ip); 
\ No newline at end of file
+std::istream& operator>>(std::istream& is, IPAddress& ip);
\ No newline at end of file
@@ -0,0 +1,454 @@
+#include "InMemoryPlatform.hpp"
+#include "NetworkHeaders.hpp"
+#include <cstring>
+#include <chrono>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+namespace {
+
+constexpr size_t NoPeer = static_cast<size_t>(-1);    ///< Sender index of frames from sockets
+
+uint64_t systemTime() {
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+void InMemoryNetwork::addInterface(const NetworkInterface::InterfaceInfo& info) {
+	std::lock_guard<std::mutex> lock(mutex);
+	interfaces.push_back(info);
+}
+
+////////////////////////////////////////////////////////////
+size_t InMemoryNetwork::addPeer(const Peer& peer) {
+	std::lock_guard<std::mutex> lock(mutex);
+	PeerState state;
+	state.config = peer;
+
+	// Hosts that already talked know each other's real addresses
+	for (auto& other : peers) {
+		learn(other, peer.ip.toUint32(), peer.mac);
+		learn(state, other.config.ip.toUint32(), other.config.mac);
+	}
+	peers.push_back(std::move(state));
+	return peers.size() - 1;
+}
+
+////////////////////////////////////////////////////////////
+bool InMemoryNetwork::sendFromPeer(size_t peer, const IPAddress& destination, size_t size) {
+	if (size < EthernetView::Size + Ipv4View::MinSize) {
+		size = EthernetView::Size + Ipv4View::MinSize;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	PeerState& sender = peers.at(peer);
+	const MacAddress* destinationMac = lookup(sender, destination.toUint32());
+	if (!destinationMac) {
+		return false;
+	}
+
+	// Same buffer every time - sending does not allocate after the first frame
+	frameBuffer.assign(size, 0);
+	EthernetView eth{ByteSpan(frameBuffer)};
+	eth.setDestination(*destinationMac);
+	eth.setSource(sender.config.mac);
+	eth.setEtherType(ETHERTYPE_IP);
+	Ipv4View ip(eth.payload());
+	ip.setHeaderLength(Ipv4View::MinSize);
+	ip.setTotalLength(static_cast<uint16_t>(size - EthernetView::Size));
+	ip.setTtl(64);
+	ip.setProtocol(IP_PROTO_UDP);
+	ip.setSource(sender.config.ip);
+	ip.setDestination(destination);
+
+	ConstByteSpan span(frameBuffer);
+	std::vector<std::vector<uint8_t>> replies;
+	deliverToPeers(span, peer, replies);
+	deliverToSockets(span);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+MacAddress InMemoryNetwork::getPeerArpEntry(size_t peer, const IPAddress& ip) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	const MacAddress* mac = lookup(peers.at(peer), ip.toUint32());
+	return mac ? *mac : MacAddress();
+}
+
+////////////////////////////////////////////////////////////
+InMemoryNetwork::PeerCounters InMemoryNetwork::getPeerCounters(size_t peer) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return peers.at(peer).counters;
+}
+
+////////////////////////////////////////////////////////////
+std::vector<NetworkInterface::InterfaceInfo> InMemoryNetwork::getInterfaces() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return interfaces;
+}
+
+////////////////////////////////////////////////////////////
+MacAddress InMemoryNetwork::resolve(const std::string& interfaceName, const IPAddress& ip) {
+	std::lock_guard<std::mutex> lock(mutex);
+	const NetworkInterface::InterfaceInfo* requester = nullptr;
+	for (const auto& info : interfaces) {
+		if (info.name == interfaceName) {
+			requester = &info;
+		}
+	}
+	if (!requester) {
+		return {};
+	}
+
+	for (auto& peer : peers) {
+		if (peer.config.ip == ip && peer.config.answersArp) {
+			if (requester->ip.size() == 4 && !requester->mac.isEmpty()) {
+				learn(peer, IPAddress(requester->ip).toUint32(), requester->mac);
+			}
+			return peer.config.mac;
+		}
+	}
+	return {};
+}
+
+////////////////////////////////////////////////////////////
+bool InMemoryNetwork::transmit(const InMemoryRawSocket& sender, ConstByteSpan frame) {
+	(void)sender;
+	if (frame.size() < EthernetView::Size) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<std::vector<uint8_t>> replies;
+	deliverToPeers(frame, NoPeer, replies);
+	for (const auto& reply : replies) {
+		deliverToSockets(ConstByteSpan(reply));
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool InMemoryNetwork::attach(InMemoryRawSocket& socket, const std::string& interfaceName, MacAddress& mac) {
+	std::lock_guard<std::mutex> lock(mutex);
+	for (const auto& info : interfaces) {
+		if (interfaceName.empty() || info.name == interfaceName) {
+			mac = info.mac;
+			ports.push_back({&socket, info.mac});
+			return true;
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+void InMemoryNetwork::detach(InMemoryRawSocket& socket) {
+	std::lock_guard<std::mutex> lock(mutex);
+	for (size_t i = 0; i < ports.size(); ++i) {
+		if (ports[i].socket == &socket) {
+			ports.erase(ports.begin() + static_cast<std::ptrdiff_t>(i));
+			return;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void InMemoryNetwork::deliverToPeers(ConstByteSpan frame, size_t sender, std::vector<std::vector<uint8_t>>& replies) {
+	ConstEthernetView eth(frame);
+	MacAddress destination = eth.destination();
+	bool broadcast = destination.isBroadcast();
+	uint16_t etherType = eth.etherType();
+	ConstArpView arp(eth.payload());
+
+	for (size_t i = 0; i < peers.size(); ++i) {
+		PeerState& peer = peers[i];
+		if (i == sender || (!broadcast && destination != peer.config.mac)) {
+			continue;
+		}
+
+		if (etherType == ETHERTYPE_IP) {
+			peer.counters.frames++;
+			peer.counters.bytes += frame.size();
+			peer.counters.lastSource = eth.source();
+			continue;
+		}
+		if (etherType != ETHERTYPE_ARP || !arp) {
+			continue;
+		}
+
+		// Any ARP frame updates the cache - this is what spoofing relies on
+		peer.counters.arpFrames++;
+		learn(peer, arp.senderIp().toUint32(), arp.senderMac());
+
+		if (arp.operation() != ARP_OP_REQUEST || !peer.config.answersArp || arp.targetIp() != peer.config.ip) {
+			continue;
+		}
+
+		ArpFrame reply = makeArpFrame(ARP_OP_REPLY, arp.senderMac(), peer.config.mac, peer.config.ip,
+		                              arp.senderMac(), arp.senderIp());
+		replies.emplace_back(reply.begin(), reply.end());
+	}
+}
+
+////////////////////////////////////////////////////////////
+void InMemoryNetwork::deliverToSockets(ConstByteSpan frame) {
+	MacAddress destination = ConstEthernetView(frame).destination();
+	bool broadcast = destination.isBroadcast();
+	for (auto& port : ports) {
+		if (broadcast || destination == port.mac) {
+			port.socket->deliver(frame);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void InMemoryNetwork::learn(PeerState& peer, uint32_t ip, const MacAddress& mac) {
+	for (auto& entry : peer.arpCache) {
+		if (entry.first == ip) {
+			entry.second = mac;
+			return;
+		}
+	}
+	peer.arpCache.emplace_back(ip, mac);
+}
+
+////////////////////////////////////////////////////////////
+const MacAddress* InMemoryNetwork::lookup(const PeerState& peer, uint32_t ip) {
+	for (const auto& entry : peer.arpCache) {
+		if (entry.first == ip) {
+			return &entry.second;
+		}
+	}
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////
+MacAddress InMemoryNetworkInterface::resolveMacAddress(const std::string& interfaceName,
+                                                       const std::vector<uint8_t>& ip) {
+	return resolveMacAddresses(interfaceName, {ip}, ResolverConfig()).front();
+}
+
+////////////////////////////////////////////////////////////
+std::vector<MacAddress> InMemoryNetworkInterface::resolveMacAddresses(
+	const std::string& interfaceName, const std::vector<std::vector<uint8_t>>& ips, const ResolverConfig& config) {
+	(void)config; // Peers answer at once
+	std::vector<MacAddress> macs(ips.size());
+	for (size_t i = 0; i < ips.size(); ++i) {
+		if (ips[i].size() == 4) {
+			macs[i] = network.resolve(interfaceName, IPAddress(ips[i]));
+		}
+	}
+	return macs;
+}
+
+////////////////////////////////////////////////////////////
+InMemoryRawSocket::InMemoryRawSocket(InMemoryNetwork& network, size_t queueSize)
+	: network(network), slots(queueSize * SlotSize), lengths(queueSize), times(queueSize), queueSize(queueSize) {
+	replayBuffer.resize(SlotSize);
+}
+
+////////////////////////////////////////////////////////////
+InMemoryRawSocket::~InMemoryRawSocket() {
+	close();
+}
+
+////////////////////////////////////////////////////////////
+bool InMemoryRawSocket::open(const std::string& interfaceName, bool promiscuous) {
+	(void)promiscuous; // The simulated switch delivers by destination MAC only
+	if (opened || queueSize == 0) {
+		return false;
+	}
+
+#ifndef _WIN32
+	if (pipe(notifyPipe) < 0) {
+		return false;
+	}
+	fcntl(notifyPipe[0], F_SETFL, fcntl(notifyPipe[0], F_GETFL) | O_NONBLOCK);
+#endif
+
+	if (!network.attach(*this, interfaceName, mac)) {
+		close();
+		return false;
+	}
+	opened = true;
+
+	// Replay requested before open() must wake the event loop
+	std::lock_guard<std::mutex> lock(queueMutex);
+	setReadable(head != tail || isReplaying());
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void InMemoryRawSocket::close() {
+	if (opened) {
+		network.detach(*this);
+		opened = false;
+	}
+
+	std::lock_guard<std::mutex> lock(queueMutex);
+	head = tail = 0;
+	readable = false;
+	for (int& fd : notifyPipe) {
+		if (fd >= 0) {
+#ifndef _WIN32
+			::close(fd);
+#endif
+			fd = -1;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool InMemoryRawSocket::sendPacket(const std::vector<uint8_t>& data) {
+	return opened && network.transmit(*this, ConstByteSpan(data));
+}
+
+////////////////////////////////////////////////////////////
+size_t InMemoryRawSocket::sendBatch(const ConstByteSpan* frames, size_t count) {
+	size_t sent = 0;
+	while (opened && sent < count && network.transmit(*this, frames[sent])) {
+		++sent;
+	}
+	return sent;
+}
+
+////////////////////////////////////////////////////////////
+std::vector<uint8_t> InMemoryRawSocket::receivePacket() {
+	std::vector<uint8_t> frame;
+	receivePackets([&frame](ByteSpan data) {
+		frame.assign(data.begin(), data.end());
+	}, 1);
+	return frame;
+}
+
+////////////////////////////////////////////////////////////
+size_t InMemoryRawSocket::receiveInto(ByteSpan buffer) {
+	size_t length = 0;
+	receivePackets([&buffer, &length](ByteSpan data) {
+		length = data.size() < buffer.size() ? data.size() : buffer.size();
+		std::memcpy(buffer.data(), data.data(), length);
+	}, 1);
+	return length;
+}
+
+////////////////////////////////////////////////////////////
+size_t InMemoryRawSocket::receivePackets(const PacketHandler& handler, size_t maxPackets) {
+	size_t count = 0;
+
+	// Queued frames first; the slot stays owned by this thread until head moves
+	while (count < maxPackets) {
+		size_t slot;
+		uint32_t length;
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			if (head == tail) {
+				break;
+			}
+			slot = head % queueSize;
+			length = lengths[slot];
+			frameTimestamp = times[slot];
+		}
+
+		handler(ByteSpan(slots.data() + slot * SlotSize, length));
+		++count;
+
+		std::lock_guard<std::mutex> lock(queueMutex);
+		++head;
+	}
+
+	while (count < maxPackets) {
+		size_t length;
+		if (!nextReplayFrame(length)) {
+			break;
+		}
+		frameTimestamp = timestamps ? systemTime() : 0;
+		handler(ByteSpan(replayBuffer.data(), length));
+		++count;
+	}
+
+	std::lock_guard<std::mutex> lock(queueMutex);
+	setReadable(head != tail || isReplaying());
+	return count;
+}
+
+////////////////////////////////////////////////////////////
+bool InMemoryRawSocket::getStatistics(Statistics& statistics) {
+	std::lock_guard<std::mutex> lock(queueMutex);
+	statistics.packets = delivered;
+	statistics.drops = dropped;
+	statistics.freezes = 0;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool InMemoryRawSocket::deliver(ConstByteSpan frame) {
+	std::lock_guard<std::mutex> lock(queueMutex);
+	if (!opened || tail - head == queueSize || frame.size() > SlotSize) {
+		dropped++;
+		return false;
+	}
+
+	size_t slot = tail % queueSize;
+	std::memcpy(slots.data() + slot * SlotSize, frame.data(), frame.size());
+	lengths[slot] = static_cast<uint32_t>(frame.size());
+	times[slot] = timestamps ? systemTime() : 0;
+	++tail;
+	++delivered;
+	setReadable(true);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool InMemoryRawSocket::replayPcap(const std::string& path, uint32_t cycles) {
+	std::lock_guard<std::mutex> lock(queueMutex);
+	replayRemaining.store(0, std::memory_order_release);
+	if (!replayFile.open(path) || replayFile.getFrameCount() == 0) {
+		replayFile.close();
+		return false;
+	}
+
+	replayRemaining.store(static_cast<uint64_t>(replayFile.getFrameCount()) * cycles, std::memory_order_release);
+	if (opened) {
+		setReadable(head != tail || isReplaying());
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void InMemoryRawSocket::setReadable(bool value) {
+#ifndef _WIN32
+	if (value && !readable) {
+		char byte = 0;
+		ssize_t written = write(notifyPipe[1], &byte, 1);
+		(void)written;
+	} else if (!value && readable) {
+		char byte;
+		ssize_t count = read(notifyPipe[0], &byte, 1);
+		(void)count;
+	}
+#endif
+	readable = value;
+}
+
+////////////////////////////////////////////////////////////
+bool InMemoryRawSocket::nextReplayFrame(size_t& length) {
+	uint64_t remaining = replayRemaining.load(std::memory_order_acquire);
+	if (remaining == 0) {
+		return false;
+	}
+
+	PcapFile::Frame frame;
+	if (!replayFile.next(frame)) {
+		replayFile.rewind(); // Next cycle
+		replayFile.next(frame);
+	}
+	length = frame.data.size() < SlotSize ? frame.data.size() : SlotSize;
+	std::memcpy(replayBuffer.data(), frame.data.data(), length);
+	replayRemaining.store(remaining - 1, std::memory_order_release);
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,390 @@
+#pragma once
+
+#include "PlatformAbstraction.hpp"
+#include "IPAddress.hpp"
+#include "PcapFile.hpp"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+class InMemoryRawSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Simulated Ethernet segment for tests and benchmarks
+///
+/// Connects InMemoryRawSocket instances (the attacker's
+/// interfaces) with scripted peers, like a switch: a frame is
+/// delivered to the socket or peer owning its destination MAC,
+/// or to everyone for broadcast. Everything runs in process
+/// memory, so App and ArpSpoofer can be driven without
+/// privileges or a network card, at CPU speed.
+///
+/// Peers model hosts with an ARP cache:
+/// - they answer ARP requests for their address (unless
+///   answersArp is false),
+/// - every ARP frame they receive updates their cache, so a
+///   spoofed reply poisons it just like on a real host,
+/// - sendFromPeer() sends an IPv4 frame to the MAC their cache
+///   holds for the destination, so traffic reaches the
+///   attacker only after poisoning,
+/// - IPv4 frames addressed to their MAC are counted.
+///
+/// All methods are thread-safe. Frames sent by sockets go to
+/// peers only; frames sent by peers reach sockets and peers.
+///
+/// Example:
+/// \code
+/// InMemoryNetwork network;
+/// network.addInterface(attacker);                 // InterfaceInfo of "mem0"
+/// size_t victim = network.addPeer({IPAddress("10.0.0.2"), victimMac});
+/// size_t gateway = network.addPeer({IPAddress("10.0.0.1"), gatewayMac});
+/// App app(std::make_unique<InMemoryNetworkInterface>(network),
+///         [&network]() { return std::make_unique<InMemoryRawSocket>(network); });
+/// ...
+/// network.sendFromPeer(victim, IPAddress("10.0.0.1"), 100);
+/// \endcode
+///
+/// The class name "InMemoryNetwork" comes from:
+/// - "InMemory" - denotes a simulation in process memory
+/// - "Network" - denotes the shared Ethernet segment
+///
+/// \see InMemoryRawSocket, InMemoryNetworkInterface
+///
+////////////////////////////////////////////////////////////
+class InMemoryNetwork {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Scripted host on the segment
+	///
+	////////////////////////////////////////////////////////////
+	struct Peer {
+		IPAddress ip;                ///< Peer's IPv4 address
+		MacAddress mac;              ///< Peer's MAC address
+		bool answersArp = true;      ///< Whether the peer replies to ARP requests
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Traffic received by a peer
+	///
+	////////////////////////////////////////////////////////////
+	struct PeerCounters {
+		uint64_t frames = 0;         ///< IPv4 frames addressed to the peer's MAC
+		uint64_t bytes = 0;          ///< Bytes of those frames
+		uint64_t arpFrames = 0;      ///< ARP frames received (requests and replies)
+		MacAddress lastSource;       ///< Source MAC of the last IPv4 frame
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// Peers start with each other's real addresses in their
+	/// ARP caches, as on a network that has been running.
+	///
+	////////////////////////////////////////////////////////////
+	InMemoryNetwork() = default;
+
+	InMemoryNetwork(const InMemoryNetwork&) = delete;
+	InMemoryNetwork& operator=(const InMemoryNetwork&) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Adds an interface for InMemoryRawSocket to open
+	///
+	/// \param info Interface as reported by getInterfaces()
+	///
+	////////////////////////////////////////////////////////////
+	void addInterface(const NetworkInterface::InterfaceInfo& info);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Adds a scripted host
+	///
+	/// \return size_t Peer index for the other peer methods
+	///
+	////////////////////////////////////////////////////////////
+	size_t addPeer(const Peer& peer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends an IPv4 frame from a peer
+	///
+	/// The destination MAC comes from the peer's ARP cache.
+	///
+	/// \param peer Sending peer
+	/// \param destination IPv4 destination
+	/// \param size Frame size in bytes (at least 34)
+	///
+	/// \return bool false if the destination is unknown
+	///
+	////////////////////////////////////////////////////////////
+	bool sendFromPeer(size_t peer, const IPAddress& destination, size_t size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets the MAC a peer's ARP cache holds for an address
+	///
+	/// \return MacAddress MAC address, empty if not cached
+	///
+	////////////////////////////////////////////////////////////
+	MacAddress getPeerArpEntry(size_t peer, const IPAddress& ip) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets traffic received by a peer
+	///
+	////////////////////////////////////////////////////////////
+	PeerCounters getPeerCounters(size_t peer) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets interfaces added with addInterface()
+	///
+	////////////////////////////////////////////////////////////
+	std::vector<NetworkInterface::InterfaceInfo> getInterfaces() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Resolves an address as an ARP exchange would
+	///
+	/// The answering peer learns the requesting interface's
+	/// address, like from a real ARP request.
+	///
+	/// \param interfaceName Requesting interface
+	/// \param ip Address to resolve
+	///
+	/// \return MacAddress MAC of the peer that answers, empty if
+	///         none does
+	///
+	////////////////////////////////////////////////////////////
+	MacAddress resolve(const std::string& interfaceName, const IPAddress& ip);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends a frame from a socket
+	///
+	/// Called by InMemoryRawSocket.
+	///
+	/// \return bool false if the frame is shorter than an
+	///         Ethernet header
+	///
+	////////////////////////////////////////////////////////////
+	bool transmit(const InMemoryRawSocket& sender, ConstByteSpan frame);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Attaches or detaches an open socket
+	///
+	/// Called by InMemoryRawSocket::open() and close().
+	///
+	////////////////////////////////////////////////////////////
+	bool attach(InMemoryRawSocket& socket, const std::string& interfaceName, MacAddress& mac);
+	void detach(InMemoryRawSocket& socket);
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Peer with its simulated state
+	///
+	////////////////////////////////////////////////////////////
+	struct PeerState {
+		Peer config;
+		std::vector<std::pair<uint32_t, MacAddress>> arpCache; ///< IPv4 -> MAC
+		PeerCounters counters;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Attached socket
+	///
+	////////////////////////////////////////////////////////////
+	struct Port {
+		InMemoryRawSocket* socket;
+		MacAddress mac;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Hands a frame to the peers it is addressed to
+	///
+	/// \param sender Sending peer index, or -1 for a socket
+	/// \param replies Receives ARP replies the peers send back
+	///
+	////////////////////////////////////////////////////////////
+	void deliverToPeers(ConstByteSpan frame, size_t sender, std::vector<std::vector<uint8_t>>& replies);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Hands a frame to the sockets it is addressed to
+	///
+	/// Called with the network lock held; lock order is network
+	/// first, then the socket's queue.
+	///
+	////////////////////////////////////////////////////////////
+	void deliverToSockets(ConstByteSpan frame);
+
+	static void learn(PeerState& peer, uint32_t ip, const MacAddress& mac);
+	static const MacAddress* lookup(const PeerState& peer, uint32_t ip);
+
+	mutable std::mutex mutex;                                ///< Guards all state below
+	std::vector<NetworkInterface::InterfaceInfo> interfaces; ///< Attacker's interfaces
+	std::vector<PeerState> peers;                            ///< Scripted hosts
+	std::vector<Port> ports;                                 ///< Open sockets
+	std::vector<uint8_t> frameBuffer;                        ///< Frame built by sendFromPeer()
+};
+
+////////////////////////////////////////////////////////////
+/// \brief NetworkInterface backed by an InMemoryNetwork
+///
+/// Lists the network's interfaces and resolves addresses
+/// through its peers.
+///
+/// The class name "InMemoryNetworkInterface" comes from:
+/// - "InMemory" - denotes the simulated network
+/// - "NetworkInterface" - denotes the implemented interface
+///
+/// \see InMemoryNetwork, NetworkInterface
+///
+////////////////////////////////////////////////////////////
+class InMemoryNetworkInterface : public NetworkInterface {
+public:
+	explicit InMemoryNetworkInterface(InMemoryNetwork& network) : network(network) {}
+
+	std::vector<InterfaceInfo> getInterfaces() override { return network.getInterfaces(); }
+
+	MacAddress resolveMacAddress(const std::string& interfaceName,
+	                             const std::vector<uint8_t>& ip) override;
+
+	std::vector<MacAddress> resolveMacAddresses(const std::string& interfaceName,
+	                                            const std::vector<std::vector<uint8_t>>& ips,
+	                                            const ResolverConfig& config) override;
+
+private:
+	InMemoryNetwork& network; ///< Simulated segment
+};
+
+////////////////////////////////////////////////////////////
+/// \brief RawSocket attached to an InMemoryNetwork
+///
+/// Received frames wait in a fixed ring of preallocated
+/// slots, so neither receiving nor sending allocates; when the
+/// ring is full further frames are dropped and counted, like
+/// in a kernel socket buffer. receivePackets() hands frames
+/// out in place and does not hold a lock while the handler
+/// runs, so the handler may send on the same network.
+///
+/// replayPcap() feeds frames from a memory-mapped capture file
+/// (pcap or pcapng, see PcapFile) into the receive path after
+/// the queued frames, bypassing the simulated switch. Each
+/// frame is copied into the socket's buffer before the handler
+/// sees it, so rewriting it in place does not change the
+/// replay; frames longer than SlotSize are truncated.
+///
+/// On POSIX systems getDescriptor() returns a pipe that is
+/// readable while frames are pending, so the socket works with
+/// every EventLoop.
+///
+/// The class name "InMemoryRawSocket" comes from:
+/// - "InMemory" - denotes the simulated network
+/// - "RawSocket" - denotes the implemented interface
+///
+/// \see InMemoryNetwork, RawSocket
+///
+////////////////////////////////////////////////////////////
+class InMemoryRawSocket : public RawSocket {
+public:
+	static constexpr size_t DefaultQueueSize = 4096;  ///< Receive slots
+	static constexpr size_t SlotSize = 2048;          ///< Largest frame kept, longer ones are dropped
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param network Segment to attach to on open()
+	/// \param queueSize Number of receive slots
+	///
+	////////////////////////////////////////////////////////////
+	explicit InMemoryRawSocket(InMemoryNetwork& network, size_t queueSize = DefaultQueueSize);
+
+	~InMemoryRawSocket() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Attaches to an interface of the network
+	///
+	/// An empty name selects the first interface.
+	///
+	////////////////////////////////////////////////////////////
+	bool open(const std::string& interfaceName, bool promiscuous = true) override;
+	void close() override;
+	bool isOpen() const override { return opened; }
+	bool sendPacket(const std::vector<uint8_t>& data) override;
+	size_t sendBatch(const ConstByteSpan* frames, size_t count) override;
+	std::vector<uint8_t> receivePacket() override;
+	size_t receiveInto(ByteSpan buffer) override;
+	size_t receivePackets(const PacketHandler& handler, size_t maxPackets) override;
+	bool getStatistics(Statistics& statistics) override;
+	int getDescriptor() const override { return notifyPipe[0]; }
+	bool setReceiveTimestamps() override { timestamps = true; return true; }
+	uint64_t receiveTimestamp() const override { return frameTimestamp; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Queues a received frame
+	///
+	/// Called by InMemoryNetwork; tests may also call it to
+	/// inject frames directly.
+	///
+	/// \return bool false if the frame was dropped (queue full
+	///         or frame larger than a slot)
+	///
+	////////////////////////////////////////////////////////////
+	bool deliver(ConstByteSpan frame);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Feeds frames of a capture file to the receive path
+	///
+	/// \param path pcap or pcapng file with Ethernet frames
+	/// \param cycles Times the file is replayed
+	///
+	/// \return bool false if the file cannot be read, is not a
+	///         capture file or holds no Ethernet frames
+	///
+	////////////////////////////////////////////////////////////
+	bool replayPcap(const std::string& path, uint32_t cycles = 1);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Checks whether replayed frames are still pending
+	///
+	////////////////////////////////////////////////////////////
+	bool isReplaying() const { return replayRemaining.load(std::memory_order_acquire) > 0; }
+
+	const MacAddress& getMac() const { return mac; }
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Makes the descriptor readable or clears it
+	///
+	/// Called with queueMutex held.
+	///
+	////////////////////////////////////////////////////////////
+	void setReadable(bool readable);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Takes the next replayed frame into replayBuffer
+	///
+	/// \param length Receives the frame length
+	///
+	/// \return bool false if the replay is over
+	///
+	////////////////////////////////////////////////////////////
+	bool nextReplayFrame(size_t& length);
+
+	InMemoryNetwork& network;          ///< Attached segment
+	MacAddress mac;                    ///< Interface MAC, set by open()
+	bool opened = false;               ///< Whether attached
+	bool timestamps = false;           ///< Whether frames carry receive times
+
+	std::mutex queueMutex;             ///< Guards head, tail and readable
+	std::vector<uint8_t> slots;        ///< queueSize * SlotSize bytes
+	std::vector<uint32_t> lengths;     ///< Frame length per slot
+	std::vector<uint64_t> times;       ///< Receive time per slot
+	size_t queueSize;                  ///< Number of slots
+	size_t head = 0;                   ///< Next slot to receive (monotonic)
+	size_t tail = 0;                   ///< Next slot to fill (monotonic)
+	bool readable = false;             ///< Whether the pipe holds a byte
+	int notifyPipe[2] = {-1, -1};      ///< Readable while frames are pending
+	uint64_t delivered = 0;            ///< Frames queued
+	uint64_t dropped = 0;              ///< Frames dropped
+
+	PcapFile replayFile;               ///< Replayed capture
+	std::atomic<uint64_t> replayRemaining{0}; ///< Frames left over all cycles
+	std::vector<uint8_t> replayBuffer; ///< Copy of the frame being handled
+	uint64_t frameTimestamp = 0;       ///< Receive time of the frame being handled
+};
\ No newline at end of file
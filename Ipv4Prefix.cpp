@@ -0,0 +1,122 @@
+#include "Ipv4Prefix.hpp"
+
+////////////////////////////////////////////////////////////
+bool Ipv4Prefix::parse(std::string_view text, Ipv4Prefix& result) {
+	const char* p = text.data();
+	const char* end = p + text.size();
+	
+	IPAddress address;
+	p = IPAddress::parse(p, end, address);
+	if (!p) {
+		return false;
+	}
+	
+	// Sam adres bez długości prefiksu to /32
+	if (p == end) {
+		result = Ipv4Prefix(address, MaxLength);
+		return true;
+	}
+	
+	// Po '/' jedna lub dwie cyfry, bez zer wiodących
+	if (*p++ != '/' || p == end || end - p > 2 || (end - p == 2 && *p == '0')) {
+		return false;
+	}
+	
+	unsigned length = 0;
+	for (; p != end; ++p) {
+		if (*p < '0' || *p > '9') {
+			return false;
+		}
+		length = length * 10 + static_cast<unsigned>(*p - '0');
+	}
+	
+	if (length > MaxLength) {
+		return false;
+	}
+	
+	result = Ipv4Prefix(address, static_cast<uint8_t>(length));
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+std::string Ipv4Prefix::toString() const {
+	char buffer[MaxStringLength];
+	char* p = getNetwork().toChars(buffer);
+	*p++ = '/';
+	if (length >= 10) {
+		*p++ = static_cast<char>('0' + length / 10);
+	}
+	*p++ = static_cast<char>('0' + length % 10);
+	return std::string(buffer, p);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Compile-time checks of Ipv4Prefix and Ipv4Range
+///
+/// Every expression below is evaluated by the compiler, so
+/// a regression in the prefix arithmetic breaks the build.
+///
+////////////////////////////////////////////////////////////
+namespace {
+
+constexpr Ipv4Prefix Lan(IPAddress(192, 168, 1, 77), 24);
+constexpr Ipv4Prefix Private10(IPAddress(10, 0, 0, 0), 8);
+constexpr Ipv4Prefix Everything;
+
+// Konstrukcja i maski
+static_assert(Lan.getNetwork() == IPAddress(192, 168, 1, 0), "host bits must be cleared");
+static_assert(Lan.getLength() == 24, "prefix length");
+static_assert(Lan.getMask() == IPAddress(255, 255, 255, 0), "mask /24");
+static_assert(Ipv4Prefix::maskFor(0) == 0u, "mask /0");
+static_assert(Ipv4Prefix::maskFor(1) == 0x80000000u, "mask /1");
+static_assert(Ipv4Prefix::maskFor(32) == 0xFFFFFFFFu, "mask /32");
+static_assert(Ipv4Prefix(IPAddress(1, 2, 3, 4), 40).getLength() == 32, "length is clamped");
+static_assert(Ipv4Prefix::fromMask(IPAddress(172, 16, 5, 4), IPAddress(255, 240, 0, 0)) ==
+              Ipv4Prefix(IPAddress(172, 16, 0, 0), 12), "prefix from netmask");
+static_assert(Ipv4Prefix::fromMask(IPAddress(1, 2, 3, 4), IPAddress(255, 255, 255, 255)).getLength() == 32, "mask /32");
+static_assert(Ipv4Prefix::fromMask(IPAddress(1, 2, 3, 4), IPAddress()).getLength() == 0, "mask /0");
+
+// Zawieranie adresów i prefiksów
+static_assert(Lan.contains(IPAddress(192, 168, 1, 0)), "network address is inside");
+static_assert(Lan.contains(IPAddress(192, 168, 1, 255)), "broadcast address is inside");
+static_assert(!Lan.contains(IPAddress(192, 168, 2, 1)), "next network is outside");
+static_assert(!Lan.contains(IPAddress(192, 168, 0, 255)), "previous network is outside");
+static_assert(Everything.contains(IPAddress(255, 255, 255, 255)), "/0 contains everything");
+static_assert(Private10.contains(Ipv4Prefix(IPAddress(10, 20, 0, 0), 16)), "more specific prefix is inside");
+static_assert(!Ipv4Prefix(IPAddress(10, 20, 0, 0), 16).contains(Private10), "less specific prefix is not inside");
+static_assert(Lan.contains(Lan), "prefix contains itself");
+static_assert(!Lan.contains(Private10), "disjoint prefixes");
+
+// Porównanie najdłuższego prefiksu
+static_assert(Lan.isMoreSpecificThan(Private10), "/24 is longer than /8");
+static_assert(!Private10.isMoreSpecificThan(Lan), "/8 is shorter than /24");
+static_assert(!Lan.isMoreSpecificThan(Lan), "equal lengths are not more specific");
+
+// Zakresy hostów
+static_assert(Lan.getBroadcastAddress() == IPAddress(192, 168, 1, 255), "broadcast /24");
+static_assert(Lan.getHostRange() == Ipv4Range(IPAddress(192, 168, 1, 1), IPAddress(192, 168, 1, 254)), "hosts /24");
+static_assert(Lan.getHostCount() == 254, "host count /24");
+static_assert(Ipv4Prefix(IPAddress(10, 0, 0, 0), 30).getHostCount() == 2, "host count /30");
+static_assert(Ipv4Prefix(IPAddress(10, 0, 0, 0), 31).getHostCount() == 2, "RFC 3021 /31");
+static_assert(Ipv4Prefix(IPAddress(10, 0, 0, 7), 32).getHostCount() == 1, "host count /32");
+static_assert(Everything.getHostCount() == 0xFFFFFFFEu, "host count /0");
+static_assert(Ipv4Range().isEmpty() && Ipv4Range().size() == 0, "default range is empty");
+static_assert(Ipv4Range(IPAddress(0, 0, 0, 0), IPAddress(255, 255, 255, 255)).size() == 0x100000000ull, "full range");
+static_assert(Lan.getHostRange().contains(IPAddress(192, 168, 1, 100)), "host inside range");
+static_assert(!Lan.getHostRange().contains(IPAddress(192, 168, 1, 255)), "broadcast outside host range");
+
+// Zgodność z helperami IPAddress
+static_assert(IPAddress::fromPrefixLength(24) == Lan.getMask(), "IPAddress mask matches");
+static_assert(IPAddress(192, 168, 1, 77).getNetworkAddress(Lan.getMask()) == Lan.getNetwork(), "network matches");
+static_assert(IPAddress(192, 168, 1, 77).isInSameNetwork(IPAddress(192, 168, 1, 1), Lan.getMask()), "same network");
+
+constexpr uint32_t countRange(const Ipv4Range& range) {
+	uint32_t count = 0;
+	for (IPAddress address : range) {
+		count += address.isEmpty() ? 0 : 1;
+	}
+	return count;
+}
+static_assert(countRange(Ipv4Prefix(IPAddress(10, 0, 0, 0), 29).getHostRange()) == 6, "range iteration");
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,322 @@
+#pragma once
+
+#include "IPAddress.hpp"
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////
+/// \brief Inclusive range of IPv4 addresses
+///
+/// Lightweight constexpr value type describing all addresses
+/// between first and last (both inclusive). Used for host
+/// ranges of a prefix; can be iterated with range-for.
+///
+/// The class name "Ipv4Range" comes from:
+/// - "Ipv4" - denotes Internet Protocol version 4
+/// - "Range" - denotes contiguous range of addresses
+///
+/// \see Ipv4Prefix, IPAddress
+///
+////////////////////////////////////////////////////////////
+class Ipv4Range {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Forward iterator over addresses in range
+	///
+	////////////////////////////////////////////////////////////
+	class const_iterator {
+	public:
+		constexpr const_iterator(uint64_t value) : value(value) {}
+
+		constexpr IPAddress operator*() const { return IPAddress::fromUint32(static_cast<uint32_t>(value)); }
+		constexpr const_iterator& operator++() { ++value; return *this; }
+		constexpr bool operator==(const const_iterator& other) const { return value == other.value; }
+		constexpr bool operator!=(const const_iterator& other) const { return value != other.value; }
+
+	private:
+		uint64_t value; ///< Current address (64-bit so 255.255.255.255 has an end)
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// Creates empty range.
+	///
+	////////////////////////////////////////////////////////////
+	constexpr Ipv4Range() : first(1), last(0) {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor from bounds
+	///
+	/// \param first First address in range
+	/// \param last Last address in range (inclusive)
+	///
+	////////////////////////////////////////////////////////////
+	constexpr Ipv4Range(const IPAddress& first, const IPAddress& last)
+		: first(first.toUint32()), last(last.toUint32()) {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets first address of range
+	///
+	/// \return IPAddress First address
+	///
+	////////////////////////////////////////////////////////////
+	constexpr IPAddress getFirst() const { return IPAddress::fromUint32(first); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets last address of range
+	///
+	/// \return IPAddress Last address (inclusive)
+	///
+	////////////////////////////////////////////////////////////
+	constexpr IPAddress getLast() const { return IPAddress::fromUint32(last); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Checks if range contains no addresses
+	///
+	/// \return bool true if range is empty
+	///
+	////////////////////////////////////////////////////////////
+	constexpr bool isEmpty() const { return first > last; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets number of addresses in range
+	///
+	/// \return uint64_t Number of addresses (up to 2^32)
+	///
+	////////////////////////////////////////////////////////////
+	constexpr uint64_t size() const { return isEmpty() ? 0 : static_cast<uint64_t>(last) - first + 1; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Checks if address belongs to range
+	///
+	/// \param address Address to check
+	///
+	/// \return bool true if first <= address <= last
+	///
+	////////////////////////////////////////////////////////////
+	constexpr bool contains(const IPAddress& address) const {
+		return address.toUint32() >= first && address.toUint32() <= last;
+	}
+
+	constexpr const_iterator begin() const { return const_iterator(first); }
+	constexpr const_iterator end() const { return const_iterator(isEmpty() ? first : static_cast<uint64_t>(last) + 1); }
+
+	constexpr bool operator==(const Ipv4Range& other) const {
+		return (isEmpty() && other.isEmpty()) || (first == other.first && last == other.last);
+	}
+	constexpr bool operator!=(const Ipv4Range& other) const { return !(*this == other); }
+
+private:
+	uint32_t first; ///< First address in host byte order
+	uint32_t last;  ///< Last address in host byte order
+};
+
+////////////////////////////////////////////////////////////
+/// \brief IPv4 network prefix (CIDR block)
+///
+/// Constexpr value type holding a network address and
+/// prefix length, e.g. 192.168.1.0/24. Containment checks,
+/// mask and host range calculations are single integer
+/// operations, so the type can replace the mask-based
+/// IPAddress helpers on every path, including compile time.
+///
+/// The class name "Ipv4Prefix" comes from:
+/// - "Ipv4" - denotes Internet Protocol version 4
+/// - "Prefix" - denotes CIDR routing prefix
+///
+/// \see Ipv4Range, IPAddress
+///
+////////////////////////////////////////////////////////////
+class Ipv4Prefix {
+public:
+	static constexpr uint8_t MaxLength = 32;  ///< Longest IPv4 prefix
+	static constexpr size_t MaxStringLength = IPAddress::MaxStringLength + 3; ///< "255.255.255.255/32"
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// Creates 0.0.0.0/0 prefix matching every address.
+	///
+	////////////////////////////////////////////////////////////
+	constexpr Ipv4Prefix() : network(0), length(0) {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor from address and prefix length
+	///
+	/// Host bits of the address are cleared, so any address
+	/// inside the network may be passed. Lengths above 32
+	/// are clamped to 32.
+	///
+	/// \param address Any address inside the network
+	/// \param length Prefix length (0-32)
+	///
+	////////////////////////////////////////////////////////////
+	constexpr Ipv4Prefix(const IPAddress& address, uint8_t length)
+		: network(0), length(length > MaxLength ? MaxLength : length) {
+		network = address.toUint32() & maskFor(this->length);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Creates prefix from address and netmask
+	///
+	/// The prefix length is the number of leading one bits of
+	/// the mask (non-contiguous masks are truncated at the
+	/// first zero bit).
+	///
+	/// \param address Any address inside the network
+	/// \param mask Network mask, e.g. 255.255.255.0
+	///
+	/// \return Ipv4Prefix Resulting prefix
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr Ipv4Prefix fromMask(const IPAddress& address, const IPAddress& mask) {
+		uint32_t bits = mask.toUint32();
+		uint8_t ones = 0;
+		while (ones < MaxLength && (bits & 0x80000000u)) {
+			++ones;
+			bits <<= 1;
+		}
+		return Ipv4Prefix(address, ones);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Parses prefix in "a.b.c.d/len" notation
+	///
+	/// A bare address without "/len" is treated as /32.
+	/// Uses the strict IPAddress::parse() rules for the address.
+	///
+	/// \param text Text to parse
+	/// \param result Parsed prefix (written only on success)
+	///
+	/// \return bool true if whole text was a valid prefix
+	///
+	////////////////////////////////////////////////////////////
+	static bool parse(std::string_view text, Ipv4Prefix& result);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets 32-bit netmask for prefix length
+	///
+	/// \param length Prefix length (0-32)
+	///
+	/// \return uint32_t Mask in host byte order
+	///
+	////////////////////////////////////////////////////////////
+	static constexpr uint32_t maskFor(uint8_t length) {
+		return length == 0 ? 0u : 0xFFFFFFFFu << (MaxLength - length);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets network address
+	///
+	/// \return IPAddress Network address (host bits cleared)
+	///
+	////////////////////////////////////////////////////////////
+	constexpr IPAddress getNetwork() const { return IPAddress::fromUint32(network); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets prefix length
+	///
+	/// \return uint8_t Prefix length (0-32)
+	///
+	////////////////////////////////////////////////////////////
+	constexpr uint8_t getLength() const { return length; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets network mask
+	///
+	/// \return IPAddress Mask, e.g. 255.255.255.0 for /24
+	///
+	////////////////////////////////////////////////////////////
+	constexpr IPAddress getMask() const { return IPAddress::fromUint32(maskFor(length)); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Checks if address belongs to this network
+	///
+	/// \param address Address to check
+	///
+	/// \return bool true if address is inside the prefix
+	///
+	////////////////////////////////////////////////////////////
+	constexpr bool contains(const IPAddress& address) const {
+		return ((address.toUint32() ^ network) & maskFor(length)) == 0;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Checks if another prefix is fully inside this one
+	///
+	/// \param other Prefix to check
+	///
+	/// \return bool true if other is equal to or more specific than this prefix
+	///
+	////////////////////////////////////////////////////////////
+	constexpr bool contains(const Ipv4Prefix& other) const {
+		return other.length >= length && contains(other.getNetwork());
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Longest-prefix comparison
+	///
+	/// When several prefixes contain an address, the one for
+	/// which this returns true against all others is the
+	/// longest (most specific) match.
+	///
+	/// \param other Prefix to compare with
+	///
+	/// \return bool true if this prefix is longer than other
+	///
+	////////////////////////////////////////////////////////////
+	constexpr bool isMoreSpecificThan(const Ipv4Prefix& other) const { return length > other.length; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets broadcast address
+	///
+	/// \return IPAddress Last address of the prefix
+	///
+	////////////////////////////////////////////////////////////
+	constexpr IPAddress getBroadcastAddress() const { return IPAddress::fromUint32(network | ~maskFor(length)); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets range of usable host addresses
+	///
+	/// Excludes network and broadcast addresses, except for
+	/// /31 (point-to-point, RFC 3021) and /32 where every
+	/// address is a host.
+	///
+	/// \return Ipv4Range Usable host addresses
+	///
+	/// \see getHostCount()
+	///
+	////////////////////////////////////////////////////////////
+	constexpr Ipv4Range getHostRange() const {
+		uint32_t broadcast = network | ~maskFor(length);
+		if (length >= MaxLength - 1) {
+			return Ipv4Range(IPAddress::fromUint32(network), IPAddress::fromUint32(broadcast));
+		}
+		return Ipv4Range(IPAddress::fromUint32(network + 1), IPAddress::fromUint32(broadcast - 1));
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets number of usable host addresses
+	///
+	/// \return uint32_t Number of hosts (see getHostRange())
+	///
+	////////////////////////////////////////////////////////////
+	constexpr uint32_t getHostCount() const { return static_cast<uint32_t>(getHostRange().size()); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Converts prefix to "a.b.c.d/len" string
+	///
+	/// \return std::string Prefix in CIDR notation
+	///
+	////////////////////////////////////////////////////////////
+	std::string toString() const;
+
+	constexpr bool operator==(const Ipv4Prefix& other) const { return network == other.network && length == other.length; }
+	constexpr bool operator!=(const Ipv4Prefix& other) const { return !(*this == other); }
+
+private:
+	uint32_t network; ///< Network address in host byte order
+	uint8_t length;   ///< Prefix length (0-32)
+};
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "LatencyHistogram.hpp"
+#include <cmath>
+#include <cstdio>
+
+////////////////////////////////////////////////////////////
+uint64_t LatencyHistogram::Distribution::valueAtPercentile(double percentile) const {
+	if (total == 0) {
+		return 0;
+	}
+	
+	// Rank of the wanted sample, at least the first one
+	double exactRank = percentile / 100.0 * static_cast<double>(total);
+	uint64_t rank = static_cast<uint64_t>(std::ceil(exactRank));
+	if (rank == 0) {
+		rank = 1;
+	}
+	
+	uint64_t seen = 0;
+	for (size_t i = 0; i < counts.size(); ++i) {
+		seen += counts[i];
+		if (seen >= rank) {
+			uint64_t value = highestValue(i);
+			return value < max ? value : max;
+		}
+	}
+	return max;
+}
+
+////////////////////////////////////////////////////////////
+std::string LatencyHistogram::Distribution::format() const {
+	const double TicksPerHalfDistance = 5.0;
+	std::string output = "       Value     Percentile TotalCount 1/(1-Percentile)\n\n";
+	char line[128];
+	
+	// Percentile steps halve each time the remaining distance to 100% halves
+	double percentile = 0.0;
+	while (total > 0) {
+		uint64_t value = valueAtPercentile(percentile);
+		uint64_t atOrBelow = 0;
+		for (size_t i = 0; i < counts.size() && lowestValue(i) <= value; ++i) {
+			atOrBelow += counts[i];
+		}
+		
+		if (atOrBelow >= total) {
+			std::snprintf(line, sizeof(line), "%12.3f %14.12f %10llu\n", static_cast<double>(max) / 1000.0, 1.0,
+			              static_cast<unsigned long long>(total));
+			output += line;
+			break;
+		}
+		std::snprintf(line, sizeof(line), "%12.3f %14.12f %10llu %14.2f\n", static_cast<double>(value) / 1000.0,
+		              percentile / 100.0, static_cast<unsigned long long>(atOrBelow), 100.0 / (100.0 - percentile));
+		output += line;
+		
+		double ticks = TicksPerHalfDistance * std::pow(2.0, std::floor(std::log2(100.0 / (100.0 - percentile))) + 1.0);
+		percentile += 100.0 / ticks;
+	}
+	
+	double mean = total > 0 ? static_cast<double>(sum) / static_cast<double>(total) / 1000.0 : 0.0;
+	std::snprintf(line, sizeof(line), "#[Mean    = %12.3f, Max            = %12.3f]\n", mean, static_cast<double>(max) / 1000.0);
+	output += line;
+	std::snprintf(line, sizeof(line), "#[Total count    = %12llu, Sub-buckets    = %12u]\n",
+	              static_cast<unsigned long long>(total), 1u << SubBucketBits);
+	output += line;
+	return output;
+}
+
+////////////////////////////////////////////////////////////
+void LatencyHistogram::addTo(Distribution& distribution) const {
+	if (distribution.counts.size() != BucketCount) {
+		distribution.counts.assign(BucketCount, 0);
+	}
+	for (size_t i = 0; i < BucketCount; ++i) {
+		uint64_t samples = counts[i].get();
+		distribution.counts[i] += samples;
+		distribution.total += samples;
+	}
+	distribution.sum += sum.get();
+	if (max.get() > distribution.max) {
+		distribution.max = max.get();
+	}
+}
+
+////////////////////////////////////////////////////////////
+uint64_t LatencyHistogram::lowestValue(size_t index) {
+	size_t range = index >> SubBucketBits;
+	if (range == 0) {
+		return index;
+	}
+	unsigned shift = static_cast<unsigned>(range - 1);
+	uint64_t subBucket = (index & ((static_cast<size_t>(1) << SubBucketBits) - 1)) + (static_cast<uint64_t>(1) << SubBucketBits);
+	return subBucket << shift;
+}
+
+////////////////////////////////////////////////////////////
+uint64_t LatencyHistogram::highestValue(size_t index) {
+	size_t range = index >> SubBucketBits;
+	unsigned shift = range == 0 ? 0 : static_cast<unsigned>(range - 1);
+	return lowestValue(index) + (static_cast<uint64_t>(1) << shift) - 1;
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "ThreadCounter.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+////////////////////////////////////////////////////////////
+/// \brief Log-linear latency histogram (HDR style)
+///
+/// Every power-of-two range of values is split into
+/// 2^SubBucketBits equal sub-buckets, so each recorded value
+/// is kept with a relative error below 2^-SubBucketBits
+/// (about 3%) over the whole range, like HdrHistogram with
+/// roughly 1.5 significant digits. Values below
+/// 2^SubBucketBits ns are exact.
+///
+/// record() is written by one thread only; it computes the
+/// bucket with a single bit scan and updates three counters,
+/// without locks or allocation. Any thread may take a
+/// Distribution at any time.
+///
+/// Example:
+/// \code
+/// LatencyHistogram histogram;
+/// histogram.record(1830);                        // owner thread
+/// LatencyHistogram::Distribution distribution;
+/// histogram.addTo(distribution);                 // any thread
+/// uint64_t p99 = distribution.valueAtPercentile(99.0);
+/// \endcode
+///
+/// The class name "LatencyHistogram" comes from:
+/// - "Latency" - denotes recorded durations
+/// - "Histogram" - denotes counts per value range
+///
+/// \see TrafficStatistics::Block::addLatency(), TrafficStatistics::Block::addAddedDelay()
+///
+////////////////////////////////////////////////////////////
+class LatencyHistogram {
+public:
+	static constexpr unsigned SubBucketBits = 5;   ///< Sub-buckets per power of two: 2^5 = 32
+	static constexpr unsigned MaxValueBits = 40;   ///< Values up to 2^40 ns (about 18 minutes), larger are clamped
+	static constexpr size_t BucketCount = static_cast<size_t>(MaxValueBits - SubBucketBits + 1) << SubBucketBits;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Summed histogram contents
+	///
+	////////////////////////////////////////////////////////////
+	struct Distribution {
+		std::vector<uint64_t> counts;  ///< Samples per bucket (BucketCount entries once filled)
+		uint64_t total = 0;            ///< Number of samples
+		uint64_t sum = 0;              ///< Sum of samples in nanoseconds
+		uint64_t max = 0;              ///< Largest sample in nanoseconds
+
+		////////////////////////////////////////////////////////////
+		/// \brief Gets value at a percentile
+		///
+		/// \param percentile Percentile in range 0-100
+		///
+		/// \return uint64_t Highest value equivalent to the bucket
+		///         holding the percentile (at most max), 0 without
+		///         samples
+		///
+		////////////////////////////////////////////////////////////
+		uint64_t valueAtPercentile(double percentile) const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Formats percentile distribution
+		///
+		/// Same layout as HdrHistogram's percentile output
+		/// (Value, Percentile, TotalCount, 1/(1-Percentile)), so
+		/// the text can be fed to HdrHistogram plotting tools.
+		/// Values are in microseconds.
+		///
+		/// \return std::string Table followed by mean and max
+		///
+		////////////////////////////////////////////////////////////
+		std::string format() const;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Records one value (owner thread only)
+	///
+	/// \param nanoseconds Value to record
+	///
+	////////////////////////////////////////////////////////////
+	void record(uint64_t nanoseconds) {
+		counts[indexOf(nanoseconds)].add(1);
+		sum.add(nanoseconds);
+		if (nanoseconds > max.get()) {
+			max.set(nanoseconds);
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Adds recorded values to a distribution
+	///
+	/// Safe to call from any thread.
+	///
+	////////////////////////////////////////////////////////////
+	void addTo(Distribution& distribution) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets bucket index of a value
+	///
+	////////////////////////////////////////////////////////////
+	static size_t indexOf(uint64_t value) {
+		const uint64_t limit = (static_cast<uint64_t>(1) << MaxValueBits) - 1;
+		if (value > limit) {
+			value = limit;
+		}
+		// Values below 2^SubBucketBits share the first range, with shift 0
+		unsigned shift = highestBit(value | (static_cast<uint64_t>(1) << SubBucketBits)) - SubBucketBits;
+		return (static_cast<size_t>(shift) << SubBucketBits) + static_cast<size_t>(value >> shift);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets lowest value of a bucket
+	///
+	////////////////////////////////////////////////////////////
+	static uint64_t lowestValue(size_t index);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets highest value of a bucket
+	///
+	////////////////////////////////////////////////////////////
+	static uint64_t highestValue(size_t index);
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Gets position of the highest set bit
+	///
+	/// \param value Non-zero value
+	///
+	////////////////////////////////////////////////////////////
+	static unsigned highestBit(uint64_t value) {
+#ifdef _MSC_VER
+		unsigned long position;
+		_BitScanReverse64(&position, value);
+		return static_cast<unsigned>(position);
+#else
+		return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+	}
+
+	ThreadCounter counts[BucketCount];  ///< Samples per bucket
+	ThreadCounter sum;                  ///< Sum of samples
+	ThreadCounter max;                  ///< Largest sample
+};
\ No newline at end of file
@@ -4,308 +4,675 @@
 
 #include <cstring>
 #include <cstdio>
-#include <fstream>
-#include <sstream>
 #include <algorithm>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <netinet/in.h>
 #include <linux/route.h>
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
+#include <linux/filter.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/signalfd.h>
+#include <sys/eventfd.h>
+#include <sched.h>
+#include <chrono>
+#include <unordered_map>
+#include "NetworkHeaders.hpp"
+#include "IPAddress.hpp"
+#include "Ipv4Prefix.hpp"
+
+namespace {
+
+constexpr size_t NetlinkBufferSize = 32 * 1024; ///< Receive buffer for one batch of dump messages
+
+////////////////////////////////////////////////////////////
+/// \brief Runs one rtnetlink dump request
+///
+/// Sends an NLM_F_DUMP request of the given type and calls
+/// handler for every reply message until NLMSG_DONE.
+///
+/// \param fd Bound NETLINK_ROUTE socket
+/// \param type Request type (RTM_GETLINK, RTM_GETADDR, ...)
+/// \param body Family-specific request header
+/// \param sequence Sequence number identifying the reply
+/// \param buffer Receive buffer, reused between dumps
+/// \param handler Called with each reply message
+///
+/// \return bool true if the whole dump was received
+///
+////////////////////////////////////////////////////////////
+template <typename Request, typename Handler>
+bool netlinkDump(int fd, uint16_t type, const Request& body, uint32_t sequence,
+                 std::vector<uint8_t>& buffer, Handler handler) {
+	struct {
+		struct nlmsghdr header;
+		Request body;
+	} request;
+	memset(&request, 0, sizeof(request));
+	request.header.nlmsg_len = NLMSG_LENGTH(sizeof(Request));
+	request.header.nlmsg_type = type;
+	request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+	request.header.nlmsg_seq = sequence;
+	request.body = body;
+	
+	if (send(fd, &request, request.header.nlmsg_len, 0) < 0) {
+		return false;
+	}
+	
+	while (true) {
+		ssize_t received = recv(fd, buffer.data(), buffer.size(), 0);
+		if (received < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		
+		int remaining = static_cast<int>(received);
+		for (struct nlmsghdr* msg = (struct nlmsghdr*)buffer.data(); NLMSG_OK(msg, remaining);
+		     msg = NLMSG_NEXT(msg, remaining)) {
+			if (msg->nlmsg_seq != sequence) {
+				continue;
+			}
+			if (msg->nlmsg_type == NLMSG_DONE) {
+				return true;
+			}
+			if (msg->nlmsg_type == NLMSG_ERROR) {
+				return false;
+			}
+			handler(msg);
+		}
+	}
+}
+
+constexpr uint16_t UsableNeighbourStates =  ///< Neighbour states with a valid link-layer address
+	NUD_REACHABLE | NUD_STALE | NUD_DELAY | NUD_PROBE | NUD_PERMANENT;
+constexpr size_t EthernetOverhead = 14 + 2 * 4; ///< Ethernet header and two VLAN tags on top of the MTU
+constexpr size_t DefaultMtu = 1500;          ///< Used when the MTU cannot be read
+constexpr size_t MaxSuperFrameSize = 65536 + EthernetOverhead; ///< Largest GRO frame (IPv4 total length limit)
+constexpr size_t VnetHeaderSize = sizeof(VnetHeader);
+static_assert(VnetHeaderSize == 10, "VnetHeader must match struct virtio_net_hdr");
+constexpr size_t TxFrameOffset = TPACKET_ALIGN(sizeof(struct tpacket3_hdr)); ///< Frame data in transmit slot
+constexpr int TxWaitMs = 100;               ///< Longest wait for a single frame sent through the transmit ring
+constexpr size_t ArpFrameSize = 60;         ///< Minimum Ethernet frame, holds an ARP packet
+constexpr size_t MaxPendingRequests = 250;  ///< BPF jump offsets are 8-bit
+constexpr uint32_t StopSource = UINT32_MAX; ///< epoll user data of the stop eventfd
+constexpr int MaxEvents = 16;               ///< Events taken per epoll_wait() call
+
+////////////////////////////////////////////////////////////
+/// \brief Builds classic BPF filter for awaited ARP replies
+///
+/// Accepts ARP replies addressed to ourIp whose sender is
+/// one of the wanted addresses; drops everything else in
+/// the kernel. Offsets assume untagged Ethernet frames.
+///
+/// \param ourIp Address the requests were sent from (host byte order)
+/// \param wanted Addresses being resolved (host byte order)
+///
+/// \return std::vector<sock_filter> Filter program
+///
+////////////////////////////////////////////////////////////
+std::vector<struct sock_filter> arpReplyFilter(uint32_t ourIp, const std::vector<uint32_t>& wanted) {
+	const uint8_t count = static_cast<uint8_t>(wanted.size());
+	
+	// Layout: 7 header checks, one compare per address, drop, accept
+	std::vector<struct sock_filter> code = {
+		BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),                                // EtherType
+		BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ETH_P_ARP, 0, uint8_t(count + 5)),
+		BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 20),                                // ARP opcode
+		BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ARP_OP_REPLY, 0, uint8_t(count + 3)),
+		BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 38),                                // Target IP
+		BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ourIp, 0, uint8_t(count + 1)),
+		BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 28),                                // Sender IP
+	};
+	for (uint8_t i = 0; i < count; ++i) {
+		code.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, wanted[i], uint8_t(count - i), 0));
+	}
+	code.push_back(BPF_STMT(BPF_RET | BPF_K, 0));
+	code.push_back(BPF_STMT(BPF_RET | BPF_K, 0xFFFF));
+	return code;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Opens and binds NETLINK_ROUTE socket
+///
+/// \param groups Multicast groups to join (0 for requests only)
+/// \param flags Extra socket type flags, e.g. SOCK_NONBLOCK
+///
+/// \return int Socket descriptor or -1 on error
+///
+////////////////////////////////////////////////////////////
+int openNetlinkSocket(uint32_t groups, int flags) {
+	int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | flags, NETLINK_ROUTE);
+	if (fd < 0) {
+		return -1;
+	}
+	
+	struct sockaddr_nl local;
+	memset(&local, 0, sizeof(local));
+	local.nl_family = AF_NETLINK;
+	local.nl_groups = groups;
+	if (bind(fd, (struct sockaddr*)&local, sizeof(local)) < 0) {
+		::close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Key of neighbour cache entry
+///
+////////////////////////////////////////////////////////////
+inline uint64_t neighbourKey(unsigned int index, uint32_t ip) {
+	return (static_cast<uint64_t>(index) << 32) | ip;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Reads destination and link-layer address of neighbour message
+///
+/// \return bool true if message is an IPv4 neighbour with destination
+///
+////////////////////////////////////////////////////////////
+bool parseNeighbour(struct nlmsghdr* msg, uint32_t& ip, const uint8_t*& mac) {
+	struct ndmsg* neighbour = (struct ndmsg*)NLMSG_DATA(msg);
+	if (neighbour->ndm_family != AF_INET) {
+		return false;
+	}
+	
+	bool hasDestination = false;
+	mac = nullptr;
+	int length = msg->nlmsg_len - NLMSG_LENGTH(sizeof(struct ndmsg));
+	for (struct rtattr* attr = (struct rtattr*)((char*)neighbour + NLMSG_ALIGN(sizeof(struct ndmsg)));
+	     RTA_OK(attr, length); attr = RTA_NEXT(attr, length)) {
+		if (attr->rta_type == NDA_DST && RTA_PAYLOAD(attr) == 4) {
+			ip = IPAddress((const uint8_t*)RTA_DATA(attr)).toUint32();
+			hasDestination = true;
+		} else if (attr->rta_type == NDA_LLADDR && RTA_PAYLOAD(attr) == ETH_ALEN) {
+			mac = (const uint8_t*)RTA_DATA(attr);
+		}
+	}
+	return hasDestination;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Reads NUL-terminated string attribute
+///
+////////////////////////////////////////////////////////////
+std::string attributeString(const struct rtattr* attr) {
+	const char* data = (const char*)RTA_DATA(attr);
+	return std::string(data, strnlen(data, RTA_PAYLOAD(attr)));
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Converts received VnetHeader to RawSocket::Offload
+///
+////////////////////////////////////////////////////////////
+RawSocket::Offload toOffload(const VnetHeader& header) {
+	RawSocket::Offload offload;
+	offload.flags = header.flags;
+	offload.segmentation = header.gsoType;
+	offload.headerLength = header.headerLength;
+	offload.segmentSize = header.gsoSize;
+	offload.checksumStart = header.checksumStart;
+	offload.checksumOffset = header.checksumOffset;
+	return offload;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Builds VnetHeader to send, empty for nullptr
+///
+////////////////////////////////////////////////////////////
+VnetHeader toVnetHeader(const RawSocket::Offload* offload) {
+	VnetHeader header;
+	memset(&header, 0, sizeof(header));
+	if (offload) {
+		header.flags = offload->flags;
+		header.gsoType = offload->segmentation;
+		header.headerLength = offload->headerLength;
+		header.gsoSize = offload->segmentSize;
+		header.checksumStart = offload->checksumStart;
+		header.checksumOffset = offload->checksumOffset;
+	}
+	return header;
+}
+
+} // namespace
 
 ////////////////////////////////////////////////////////////
 /// \brief LinuxNetworkInterface implementation
 ///
 ////////////////////////////////////////////////////////////
 
+LinuxNetworkInterface::~LinuxNetworkInterface() {
+	if (neighbourEventFd >= 0) {
+		::close(neighbourEventFd);
+	}
+}
+
 std::vector<NetworkInterface::InterfaceInfo> LinuxNetworkInterface::getInterfaces() {
 	std::vector<InterfaceInfo> interfaces;
 	
-	// Open /proc/net/dev to get interface list
-	std::ifstream file("/proc/net/dev");
-	if (!file.is_open()) {
+	int fd = openNetlinkSocket(0, 0);
+	if (fd < 0) {
 		return interfaces;
 	}
 	
-	std::string line;
-	// Skip header lines
-	std::getline(file, line);
-	std::getline(file, line);
-	
-	while (std::getline(file, line)) {
-		std::istringstream iss(line);
-		std::string interfaceName;
+	std::vector<uint8_t> buffer(NetlinkBufferSize);
+	std::unordered_map<int, size_t> byIndex;
 		
-		// Parse interface name (remove colon)
-		iss >> interfaceName;
-		if (interfaceName.empty() || interfaceName.back() != ':') {
-			continue;
+	// Links: name, MAC address and flags
+	struct ifinfomsg linkRequest;
+	memset(&linkRequest, 0, sizeof(linkRequest));
+	linkRequest.ifi_family = AF_UNSPEC;
+	
+	bool ok = netlinkDump(fd, RTM_GETLINK, linkRequest, 1, buffer, [&](struct nlmsghdr* msg) {
+		if (msg->nlmsg_type != RTM_NEWLINK) {
+			return;
 		}
-		interfaceName.pop_back(); // Remove colon
 		
-		// Skip loopback and down interfaces
-		if (interfaceName == "lo" || interfaceName.find("docker") != std::string::npos) {
-			continue;
-		}
+		struct ifinfomsg* link = (struct ifinfomsg*)NLMSG_DATA(msg);
 		
-		// Get interface flags
-		int flags = getInterfaceFlags(interfaceName);
-		if (!(flags & IFF_UP)) {
-			continue; // Skip down interfaces
+		// Skip loopback and down interfaces
+		if ((link->ifi_flags & IFF_LOOPBACK) || !(link->ifi_flags & IFF_UP)) {
+			return;
 		}
 		
 		InterfaceInfo info;
-		info.name = interfaceName;
-		info.description = interfaceName;
+		info.index = static_cast<unsigned int>(link->ifi_index);
+		info.prefixLength = 0;
 		info.isUp = true;
 		
-		// Get MAC address
-		info.mac = getInterfaceMacAddress(interfaceName);
+		int length = IFLA_PAYLOAD(msg);
+		for (struct rtattr* attr = IFLA_RTA(link); RTA_OK(attr, length); attr = RTA_NEXT(attr, length)) {
+			switch (attr->rta_type) {
+			case IFLA_IFNAME:
+				info.name = attributeString(attr);
+				break;
+			case IFLA_IFALIAS:
+				info.description = attributeString(attr);
+				break;
+			case IFLA_ADDRESS:
+				if (RTA_PAYLOAD(attr) == ETH_ALEN) {
+					info.mac = MacAddress((const uint8_t*)RTA_DATA(attr));
+				}
+				break;
+			}
+		}
 		
-		// Get IP address
-		info.ip = getInterfaceIpAddress(interfaceName);
+		if (info.description.empty()) {
+			info.description = info.name;
+		}
 		
-		// Get netmask
-		info.prefixLength = getInterfaceNetmask(interfaceName);
+		byIndex[link->ifi_index] = interfaces.size();
+		interfaces.push_back(std::move(info));
+	});
 		
-		// Get gateway
-		info.gateway = getDefaultGateway(interfaceName);
+	// Addresses: every IPv4 address of every interface
+	struct ifaddrmsg addressRequest;
+	memset(&addressRequest, 0, sizeof(addressRequest));
+	addressRequest.ifa_family = AF_INET;
 		
-		interfaces.push_back(std::move(info));
-	}
+	ok = ok && netlinkDump(fd, RTM_GETADDR, addressRequest, 2, buffer, [&](struct nlmsghdr* msg) {
+		if (msg->nlmsg_type != RTM_NEWADDR) {
+			return;
+		}
+		
+		struct ifaddrmsg* address = (struct ifaddrmsg*)NLMSG_DATA(msg);
+		auto it = byIndex.find(static_cast<int>(address->ifa_index));
+		if (address->ifa_family != AF_INET || it == byIndex.end()) {
+			return;
+		}
+		
+		// IFA_LOCAL is the local address; IFA_ADDRESS is the peer on point-to-point links
+		const uint8_t* local = nullptr;
+		const uint8_t* peer = nullptr;
+		int length = IFA_PAYLOAD(msg);
+		for (struct rtattr* attr = IFA_RTA(address); RTA_OK(attr, length); attr = RTA_NEXT(attr, length)) {
+			if (RTA_PAYLOAD(attr) != 4) {
+				continue;
+			}
+			if (attr->rta_type == IFA_LOCAL) {
+				local = (const uint8_t*)RTA_DATA(attr);
+			} else if (attr->rta_type == IFA_ADDRESS) {
+				peer = (const uint8_t*)RTA_DATA(attr);
+			}
+		}
+		
+		const uint8_t* ip = local ? local : peer;
+		if (!ip) {
+			return;
+		}
+		
+		InterfaceInfo& info = interfaces[it->second];
+		InterfaceInfo::AddressInfo entry;
+		entry.ip.assign(ip, ip + 4);
+		entry.prefixLength = address->ifa_prefixlen;
+		
+		if (info.addresses.empty()) {
+			info.ip = entry.ip;
+			info.prefixLength = entry.prefixLength;
+		}
+		info.addresses.push_back(std::move(entry));
+	});
 	
-	return interfaces;
-}
-
-std::vector<uint8_t> LinuxNetworkInterface::resolveMacAddress(const std::string& interfaceName, 
-                                                             const std::vector<uint8_t>& ip) {
-	if (ip.size() != 4) {
-		return {};
-	}
+	// Routes: default gateway with the lowest metric per interface
+	struct rtmsg routeRequest;
+	memset(&routeRequest, 0, sizeof(routeRequest));
+	routeRequest.rtm_family = AF_INET;
 	
-	// Try to get MAC from ARP table first
-	std::ifstream arpFile("/proc/net/arp");
-	if (arpFile.is_open()) {
-		std::string line;
-		std::getline(arpFile, line); // Skip header
+	std::unordered_map<int, uint32_t> gatewayMetric;
+	ok = ok && netlinkDump(fd, RTM_GETROUTE, routeRequest, 3, buffer, [&](struct nlmsghdr* msg) {
+		if (msg->nlmsg_type != RTM_NEWROUTE) {
+			return;
+		}
 		
-		while (std::getline(arpFile, line)) {
-			std::istringstream iss(line);
-			std::string ipStr, hwType, flags, mac, mask, device;
-			
-			iss >> ipStr >> hwType >> flags >> mac >> mask >> device;
-			
-			if (device == interfaceName && mac != "00:00:00:00:00:00") {
-				// Convert IP string to bytes
-				struct in_addr addr;
-				if (inet_pton(AF_INET, ipStr.c_str(), &addr) == 1) {
-					std::vector<uint8_t> arpIp(4);
-					memcpy(arpIp.data(), &addr.s_addr, 4);
-					
-					if (arpIp == ip) {
-						// Parse MAC address
-						std::vector<uint8_t> macBytes;
-						std::istringstream macStream(mac);
-						std::string byteStr;
-						
-						while (std::getline(macStream, byteStr, ':')) {
-							macBytes.push_back(std::stoi(byteStr, nullptr, 16));
-						}
-						
-						if (macBytes.size() == 6) {
-							return macBytes;
-						}
-					}
+		struct rtmsg* route = (struct rtmsg*)NLMSG_DATA(msg);
+		if (route->rtm_family != AF_INET || route->rtm_dst_len != 0 ||
+		    route->rtm_table != RT_TABLE_MAIN || route->rtm_type != RTN_UNICAST) {
+			return;
+		}
+		
+		int outputIndex = 0;
+		uint32_t metric = 0;
+		const uint8_t* gateway = nullptr;
+		int length = RTM_PAYLOAD(msg);
+		for (struct rtattr* attr = RTM_RTA(route); RTA_OK(attr, length); attr = RTA_NEXT(attr, length)) {
+			switch (attr->rta_type) {
+			case RTA_OIF:
+				memcpy(&outputIndex, RTA_DATA(attr), sizeof(outputIndex));
+				break;
+			case RTA_PRIORITY:
+				memcpy(&metric, RTA_DATA(attr), sizeof(metric));
+				break;
+			case RTA_GATEWAY:
+				if (RTA_PAYLOAD(attr) == 4) {
+					gateway = (const uint8_t*)RTA_DATA(attr);
 				}
+				break;
 			}
 		}
+		
+		auto it = byIndex.find(outputIndex);
+		if (!gateway || it == byIndex.end()) {
+			return;
+		}
+		
+		auto best = gatewayMetric.find(outputIndex);
+		if (best == gatewayMetric.end() || metric < best->second) {
+			gatewayMetric[outputIndex] = metric;
+			interfaces[it->second].gateway.assign(gateway, gateway + 4);
+		}
+	});
+	
+	::close(fd);
+	
+	if (!ok) {
+		interfaces.clear();
 	}
+	return interfaces;
+}
+
+MacAddress LinuxNetworkInterface::resolveMacAddress(const std::string& interfaceName,
+                                                   const std::vector<uint8_t>& ip) {
+	return resolveMacAddresses(interfaceName, {ip}, ResolverConfig()).front();
+}
+
+std::vector<MacAddress> LinuxNetworkInterface::resolveMacAddresses(
+	const std::string& interfaceName, const std::vector<std::vector<uint8_t>>& ips,
+	const ResolverConfig& config) {
+	std::vector<MacAddress> macs(ips.size());
 	
-	// If not found in ARP table, send ARP request
-	int sock = socket(AF_INET, SOCK_DGRAM, 0);
-	if (sock < 0) {
-		return {};
+	unsigned int index = if_nametoindex(interfaceName.c_str());
+	if (index == 0) {
+		return macs;
 	}
 	
-	// Set interface
-	struct ifreq ifr;
-	memset(&ifr, 0, sizeof(ifr));
-	strncpy(ifr.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
+	// Try the neighbour table first
+	lookupNeighbours(index, ips, macs);
 	
-	if (ioctl(sock, SIOCGIFINDEX, &ifr) < 0) {
-		::close(sock);
-		return {};
+	bool missing = false;
+	for (size_t i = 0; i < ips.size(); ++i) {
+		missing = missing || (macs[i].isEmpty() && ips[i].size() == 4);
 	}
 	
-	// Create ARP request packet
-	std::vector<uint8_t> arpPacket(60, 0); // Minimum Ethernet frame size
-	
-	// Ethernet header
-	uint8_t* eth = arpPacket.data();
-	// Destination: broadcast
-	memset(eth, 0xFF, 6);
-	// Source: our MAC (will be filled by kernel)
-	memset(eth + 6, 0x00, 6);
-	// Type: ARP
-	eth[12] = 0x08;
-	eth[13] = 0x06;
-	
-	// ARP header
-	uint8_t* arp = eth + 14;
-	arp[0] = 0x00; arp[1] = 0x01; // Hardware type: Ethernet
-	arp[2] = 0x08; arp[3] = 0x00; // Protocol type: IP
-	arp[4] = 0x06; // Hardware size
-	arp[5] = 0x04; // Protocol size
-	arp[6] = 0x00; arp[7] = 0x01; // Operation: request
-	// Sender MAC (will be filled by kernel)
-	memset(arp + 8, 0x00, 6);
-	// Sender IP (our IP)
-	memcpy(arp + 14, ip.data(), 4);
-	// Target MAC: unknown
-	memset(arp + 18, 0x00, 6);
-	// Target IP
-	memcpy(arp + 24, ip.data(), 4);
-	
-	// Send ARP request
-	struct sockaddr_ll addr;
-	memset(&addr, 0, sizeof(addr));
-	addr.sll_family = AF_PACKET;
-	addr.sll_protocol = htons(ETH_P_ARP);
-	addr.sll_ifindex = ifr.ifr_ifindex;
-	addr.sll_halen = ETH_ALEN;
-	memset(addr.sll_addr, 0xFF, ETH_ALEN); // Broadcast
-	
-	if (sendto(sock, arpPacket.data(), arpPacket.size(), 0, 
-	           (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-		::close(sock);
-		return {};
+	if (!missing) {
+		return macs;
 	}
 	
-	// Wait for response (simplified - in real implementation would need timeout)
-	::close(sock);
+	// Resolve the rest with our own requests
+	for (const auto& iface : getInterfaces()) {
+		if (iface.index == index) {
+			sendArpRequests(iface, ips, macs, config);
+			break;
+		}
+	}
 	
-	// For now, return empty (would need to implement ARP response parsing)
-	return {};
+	return macs;
 }
 
-int LinuxNetworkInterface::getInterfaceFlags(const std::string& interfaceName) {
-	int sock = socket(AF_INET, SOCK_DGRAM, 0);
-	if (sock < 0) {
-		return 0;
-	}
-	
-	struct ifreq ifr;
-	memset(&ifr, 0, sizeof(ifr));
-	strncpy(ifr.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
-	
-	int flags = 0;
-	if (ioctl(sock, SIOCGIFFLAGS, &ifr) == 0) {
-		flags = ifr.ifr_flags;
+bool LinuxNetworkInterface::enableNeighbourCache() {
+	if (neighbourEventFd >= 0) {
+		return true;
 	}
 	
-	::close(sock);
-	return flags;
+	neighbourEventFd = openNetlinkSocket(RTMGRP_NEIGH, SOCK_NONBLOCK);
+	neighbourCache.clear();
+	return neighbourEventFd >= 0;
 }
-
-std::vector<uint8_t> LinuxNetworkInterface::getInterfaceMacAddress(const std::string& interfaceName) {
-	int sock = socket(AF_INET, SOCK_DGRAM, 0);
-	if (sock < 0) {
-		return {};
+		
+void LinuxNetworkInterface::lookupNeighbours(unsigned int index,
+                                             const std::vector<std::vector<uint8_t>>& ips,
+                                             std::vector<MacAddress>& macs) {
+	bool missing = false;
+			
+	if (neighbourEventFd >= 0) {
+		processNeighbourEvents();
+	}
+			
+	for (size_t i = 0; i < ips.size(); ++i) {
+		if (ips[i].size() != 4) {
+			continue;
+		}
+					
+		auto cached = neighbourCache.find(neighbourKey(index, IPAddress(ips[i]).toUint32()));
+		if (cached != neighbourCache.end()) {
+			macs[i] = cached->second;
+		} else {
+			missing = true;
+		}
+	}
+						
+	if (!missing) {
+		return;
+	}
+						
+	int fd = openNetlinkSocket(0, 0);
+	if (fd < 0) {
+		return;
 	}
 	
-	struct ifreq ifr;
-	memset(&ifr, 0, sizeof(ifr));
-	strncpy(ifr.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
+	// Dump filtered by interface in the kernel (NDA_IFINDEX)
+	struct {
+		struct ndmsg message;
+		struct rtattr indexAttribute;
+		uint32_t index;
+	} request;
+	memset(&request, 0, sizeof(request));
+	request.message.ndm_family = AF_INET;
+	request.indexAttribute.rta_type = NDA_IFINDEX;
+	request.indexAttribute.rta_len = RTA_LENGTH(sizeof(uint32_t));
+	request.index = index;
 	
-	std::vector<uint8_t> mac(6);
-	if (ioctl(sock, SIOCGIFHWADDR, &ifr) == 0) {
-		memcpy(mac.data(), ifr.ifr_hwaddr.sa_data, 6);
-	} else {
-		mac.clear();
-	}
+	std::vector<uint8_t> buffer(NetlinkBufferSize);
+	netlinkDump(fd, RTM_GETNEIGH, request, 1, buffer, [&](struct nlmsghdr* msg) {
+		struct ndmsg* neighbour = (struct ndmsg*)NLMSG_DATA(msg);
+		uint32_t ip = 0;
+		const uint8_t* mac = nullptr;
+		
+		if (msg->nlmsg_type != RTM_NEWNEIGH || neighbour->ndm_ifindex != static_cast<int>(index) ||
+		    !(neighbour->ndm_state & UsableNeighbourStates) || !parseNeighbour(msg, ip, mac) || !mac) {
+			return;
+		}
+		
+		for (size_t i = 0; i < ips.size(); ++i) {
+			if (macs[i].isEmpty() && ips[i].size() == 4 && IPAddress(ips[i]).toUint32() == ip) {
+				macs[i] = MacAddress(mac);
+				if (neighbourEventFd >= 0) {
+					neighbourCache[neighbourKey(index, ip)] = macs[i];
+				}
+			}
+		}
+	});
 	
-	::close(sock);
-	return mac;
+	::close(fd);
 }
 
-std::vector<uint8_t> LinuxNetworkInterface::getInterfaceIpAddress(const std::string& interfaceName) {
-	int sock = socket(AF_INET, SOCK_DGRAM, 0);
-	if (sock < 0) {
-		return {};
-	}
-	
-	struct ifreq ifr;
-	memset(&ifr, 0, sizeof(ifr));
-	strncpy(ifr.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
+void LinuxNetworkInterface::processNeighbourEvents() {
+	std::vector<uint8_t> buffer(NetlinkBufferSize);
 	
-	std::vector<uint8_t> ip(4);
-	if (ioctl(sock, SIOCGIFADDR, &ifr) == 0) {
-		struct sockaddr_in* addr = (struct sockaddr_in*)&ifr.ifr_addr;
-		memcpy(ip.data(), &addr->sin_addr.s_addr, 4);
-	} else {
-		ip.clear();
+	while (true) {
+		ssize_t received = recv(neighbourEventFd, buffer.data(), buffer.size(), MSG_DONTWAIT);
+		if (received < 0) {
+			if (errno == ENOBUFS) {
+				neighbourCache.clear(); // Notifications lost - nothing cached can be trusted
+				continue;
+			}
+			if (errno == EINTR) {
+				continue;
+			}
+			return;
+		}
+		
+		int remaining = static_cast<int>(received);
+		for (struct nlmsghdr* msg = (struct nlmsghdr*)buffer.data(); NLMSG_OK(msg, remaining);
+		     msg = NLMSG_NEXT(msg, remaining)) {
+			if (msg->nlmsg_type != RTM_NEWNEIGH && msg->nlmsg_type != RTM_DELNEIGH) {
+				continue;
+			}
+			
+			struct ndmsg* neighbour = (struct ndmsg*)NLMSG_DATA(msg);
+			uint32_t ip = 0;
+			const uint8_t* mac = nullptr;
+			if (parseNeighbour(msg, ip, mac)) {
+				neighbourCache.erase(neighbourKey(static_cast<unsigned int>(neighbour->ndm_ifindex), ip));
+			}
+		}
 	}
-	
-	::close(sock);
-	return ip;
 }
 
-uint8_t LinuxNetworkInterface::getInterfaceNetmask(const std::string& interfaceName) {
-	int sock = socket(AF_INET, SOCK_DGRAM, 0);
-	if (sock < 0) {
-		return 0;
+void LinuxNetworkInterface::sendArpRequests(const InterfaceInfo& iface,
+                                            const std::vector<std::vector<uint8_t>>& ips,
+                                            std::vector<MacAddress>& macs,
+                                            const ResolverConfig& config) {
+	if (iface.mac.isEmpty() || iface.index == 0) {
+		return;
 	}
 	
-	struct ifreq ifr;
-	memset(&ifr, 0, sizeof(ifr));
-	strncpy(ifr.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
+	std::vector<size_t> pending;
+	for (size_t i = 0; i < ips.size(); ++i) {
+		if (macs[i].isEmpty() && ips[i].size() == 4) {
+			pending.push_back(i);
+		}
+	}
+	if (pending.empty() || pending.size() > MaxPendingRequests) {
+		return;
+	}
 	
-	uint8_t prefixLength = 0;
-	if (ioctl(sock, SIOCGIFNETMASK, &ifr) == 0) {
-		struct sockaddr_in* addr = (struct sockaddr_in*)&ifr.ifr_netmask;
-		uint32_t netmask = ntohl(addr->sin_addr.s_addr);
-		
-		// Count leading ones
-		while (netmask & 0x80000000) {
-			prefixLength++;
-			netmask <<= 1;
+	// Sender address: the interface address on the same network as the first
+	// unresolved host, otherwise the primary one (0.0.0.0 if none, an ARP probe)
+	uint32_t sourceIp = 0;
+	for (const auto& address : iface.addresses) {
+		Ipv4Prefix network(IPAddress(address.ip), address.prefixLength);
+		if (sourceIp == 0 || network.contains(IPAddress(ips[pending.front()]))) {
+			sourceIp = IPAddress(address.ip).toUint32();
 		}
 	}
 	
-	::close(sock);
-	return prefixLength;
-}
-
-std::vector<uint8_t> LinuxNetworkInterface::getDefaultGateway(const std::string& interfaceName) {
-	// Read routing table from /proc/net/route
-	std::ifstream routeFile("/proc/net/route");
-	if (!routeFile.is_open()) {
-		return {};
+	std::vector<uint32_t> wanted;
+	for (size_t index : pending) {
+		wanted.push_back(IPAddress(ips[index]).toUint32());
 	}
 	
-	std::string line;
-	std::getline(routeFile, line); // Skip header
+	// Open unbound, attach the filter, then bind - no unfiltered frame can be queued
+	int fd = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		return;
+	}
 	
-	while (std::getline(routeFile, line)) {
-		std::istringstream iss(line);
-		std::string iface, dest, gateway, flags, refcnt, use, metric, mask, mtu, window, irtt;
-		
-		iss >> iface >> dest >> gateway >> flags >> refcnt >> use >> metric >> mask >> mtu >> window >> irtt;
+	std::vector<struct sock_filter> code = arpReplyFilter(sourceIp, wanted);
+	struct sock_fprog program;
+	program.len = static_cast<unsigned short>(code.size());
+	program.filter = code.data();
+	
+	struct sockaddr_ll addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sll_family = AF_PACKET;
+	addr.sll_protocol = htons(ETH_P_ARP);
+	addr.sll_ifindex = static_cast<int>(iface.index);
+	
+	if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) < 0 ||
+	    bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+		::close(fd);
+		return;
+	}
+	
+	// Broadcast request frame; only the target IP changes between requests
+	uint8_t request[ArpFrameSize] = {};
+	ArpFrame header = makeArpFrame(ARP_OP_REQUEST, MacAddress::Broadcast, iface.mac,
+	                               IPAddress::fromUint32(sourceIp), MacAddress(), IPAddress());
+	memcpy(request, header.data(), header.size());
+	ArpView arp(ByteSpan(request, sizeof(request)).subspan(EthernetView::Size));
+	
+	memset(addr.sll_addr, 0xFF, ETH_ALEN);
+	addr.sll_halen = ETH_ALEN;
+	
+	uint8_t reply[ArpFrameSize];
+	unsigned int timeoutMs = config.timeoutMs;
+	
+	for (unsigned int attempt = 0; attempt < config.maxAttempts && !pending.empty(); ++attempt) {
+		// Every outstanding address is asked at once
+		for (size_t index : pending) {
+			arp.setTargetIp(IPAddress(ips[index]));
+			sendto(fd, request, sizeof(request), 0, (struct sockaddr*)&addr, sizeof(addr));
+		}
 		
-		if (iface == interfaceName && dest == "00000000") { // Default route
-			// Convert hex gateway to bytes
-			if (gateway != "00000000") {
-				std::vector<uint8_t> gatewayBytes(4);
-				for (int i = 0; i < 4; i++) {
-					std::string byteStr = gateway.substr(i * 2, 2);
-					gatewayBytes[3 - i] = std::stoi(byteStr, nullptr, 16); // Little-endian
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+		while (!pending.empty()) {
+			auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+				deadline - std::chrono::steady_clock::now()).count();
+			if (remaining <= 0) {
+				break;
+			}
+			
+			struct pollfd pfd = {fd, POLLIN, 0};
+			if (poll(&pfd, 1, static_cast<int>(remaining)) <= 0) {
+				continue; // Timeout or EINTR - deadline decides
+			}
+			
+			ssize_t received;
+			while ((received = recv(fd, reply, sizeof(reply), MSG_DONTWAIT)) >= 0) {
+				ConstArpView answer(ConstByteSpan(reply, static_cast<size_t>(received)).subspan(EthernetView::Size));
+				if (!answer) {
+					break;
+				}
+				
+				for (size_t i = 0; i < pending.size(); ++i) {
+					if (answer.senderIp() == IPAddress(ips[pending[i]])) {
+						macs[pending[i]] = answer.senderMac();
+						pending.erase(pending.begin() + i);
+						break;
+					}
 				}
-				return gatewayBytes;
 			}
 		}
+		
+		timeoutMs *= config.backoffFactor;
 	}
 	
-	return {};
+	::close(fd);
 }
 
 ////////////////////////////////////////////////////////////
@@ -313,7 +680,7 @@ std::vector<uint8_t> LinuxNetworkInterface::getDefaultGateway(const std::string&
 ///
 ////////////////////////////////////////////////////////////
 
-LinuxRawSocket::LinuxRawSocket() : socketFd(-1), isOpen(false) {
+LinuxRawSocket::LinuxRawSocket() : socketFd(-1), socketOpen(false) {
 }
 
 LinuxRawSocket::~LinuxRawSocket() {
@@ -323,12 +690,30 @@ LinuxRawSocket::~LinuxRawSocket() {
 bool LinuxRawSocket::open(const std::string& interfaceName, bool promiscuous) {
 	this->interfaceName = interfaceName;
 	
-	// Create raw socket
-	socketFd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+	// Create raw socket; protocol is set by bind() so that no frame
+	// from other interfaces is queued before the socket is bound
+	socketFd = socket(AF_PACKET, SOCK_RAW, 0);
 	if (socketFd < 0) {
 		return false;
 	}
 	
+	statistics = Statistics();
+	truncated = 0;
+	
+	// The kernel refuses PACKET_VNET_HDR once a ring exists
+	if (offloadRequested) {
+		int enable = 1;
+		if (setsockopt(socketFd, SOL_PACKET, PACKET_VNET_HDR, &enable, sizeof(enable)) < 0) {
+			close();
+			return false;
+		}
+	}
+	
+	if ((ringRequested || txRingRequested) && !setupRings()) {
+		close();
+		return false;
+	}
+	
 	// Set non-blocking mode
 	int flags = fcntl(socketFd, F_GETFL, 0);
 	fcntl(socketFd, F_SETFL, flags | O_NONBLOCK);
@@ -345,100 +730,706 @@ bool LinuxRawSocket::open(const std::string& interfaceName, bool promiscuous) {
 	strncpy(ifr.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
 	
 	if (ioctl(socketFd, SIOCGIFINDEX, &ifr) < 0) {
-		::close(socketFd);
-		socketFd = -1;
+		close();
 		return false;
 	}
 	
 	addr.sll_ifindex = ifr.ifr_ifindex;
 	
+	// Buffers hold the largest frame the interface can deliver
+	size_t mtu = DefaultMtu;
+	if (ioctl(socketFd, SIOCGIFMTU, &ifr) == 0 && ifr.ifr_mtu > 0) {
+		mtu = static_cast<size_t>(ifr.ifr_mtu);
+	}
+	maxFrameSize = offloadRequested ? std::max(MaxSuperFrameSize, mtu + EthernetOverhead) : mtu + EthernetOverhead;
+	if (ring) {
+		// Frames may fill a whole block apart from its header
+		maxFrameSize = std::min(maxFrameSize, static_cast<size_t>(ringConfig.blockSize) - TPACKET3_HDRLEN);
+	}
+	
 	if (bind(socketFd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-		::close(socketFd);
-		socketFd = -1;
+		close();
 		return false;
 	}
 	
+	// Fanout group can be joined only by a bound socket
+	if (fanoutRequested) {
+		int type = fanoutMode == FanoutMode::Cpu ? PACKET_FANOUT_CPU :
+		           PACKET_FANOUT_HASH | PACKET_FANOUT_FLAG_DEFRAG;
+		int argument = fanoutGroup | (type << 16);
+		if (setsockopt(socketFd, SOL_PACKET, PACKET_FANOUT, &argument, sizeof(argument)) < 0) {
+			close();
+			return false;
+		}
+	}
+	
+	// Ring frame headers always carry the time; plain receive needs ancillary data
+	if (timestampsRequested && !ring) {
+		int enable = 1;
+		if (setsockopt(socketFd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) < 0) {
+			close();
+			return false;
+		}
+		controlBuffer.resize(CMSG_SPACE(sizeof(struct timespec)));
+	}
+	
+	// Destination address for every send; the frame carries the MACs
+	linkAddress = addr;
+	
 	// Enable promiscuous mode if requested
 	if (promiscuous) {
 		if (ioctl(socketFd, SIOCGIFFLAGS, &ifr) < 0) {
-			::close(socketFd);
-			socketFd = -1;
+			close();
 			return false;
 		}
 		
 		ifr.ifr_flags |= IFF_PROMISC;
 		
 		if (ioctl(socketFd, SIOCSIFFLAGS, &ifr) < 0) {
-			::close(socketFd);
-			socketFd = -1;
+			close();
 			return false;
 		}
 	}
 	
-	isOpen = true;
+	if (!ring) {
+		receiveBuffer.resize(maxFrameSize);
+	}
+	batchHeaders.resize(MaxBatch);
+	batchVectors.resize(2 * MaxBatch);
+	batchOffloads.resize(MaxBatch);
+	
+	socketOpen = true;
 	return true;
 }
 
 void LinuxRawSocket::close() {
+	if (mapping) {
+		munmap(mapping, mappingSize);
+		mapping = nullptr;
+		mappingSize = 0;
+	}
+	ring = nullptr;
+	txRing = nullptr;
+	txCurrentFrame = 0;
+	currentBlock = 0;
+	packetsLeft = 0;
+	nextPacket = nullptr;
+	
 	if (socketFd >= 0) {
 		::close(socketFd);
 		socketFd = -1;
 	}
-	isOpen = false;
+	socketOpen = false;
 }
 
 bool LinuxRawSocket::sendPacket(const std::vector<uint8_t>& data) {
-	if (!isOpen || socketFd < 0) {
+	if (!socketOpen || socketFd < 0) {
 		return false;
 	}
 	
-	// Get interface index
-	struct ifreq ifr;
-	memset(&ifr, 0, sizeof(ifr));
-	strncpy(ifr.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
+	return sendFrame(ConstByteSpan(data), nullptr);
+}
 	
-	if (ioctl(socketFd, SIOCGIFINDEX, &ifr) < 0) {
+bool LinuxRawSocket::sendFrame(ConstByteSpan frame, const Offload* offload) {
+	// With a transmit ring the kernel sends only ring slots and ignores the buffer of a send call
+	if (txRing) {
+		return sendOneThroughRing(frame, offload);
+	}
+	
+	if (!offloadRequested) {
+		ssize_t sent = sendto(socketFd, frame.data(), frame.size(), 0,
+		                      (struct sockaddr*)&linkAddress, sizeof(linkAddress));
+		return sent == static_cast<ssize_t>(frame.size());
+	}
+	
+	// The frame follows its virtio_net_hdr
+	VnetHeader header = toVnetHeader(offload);
+	struct iovec vectors[2] = {{&header, VnetHeaderSize}, {const_cast<uint8_t*>(frame.data()), frame.size()}};
+	struct msghdr message;
+	memset(&message, 0, sizeof(message));
+	message.msg_name = &linkAddress;
+	message.msg_namelen = sizeof(linkAddress);
+	message.msg_iov = vectors;
+	message.msg_iovlen = 2;
+	ssize_t sent = sendmsg(socketFd, &message, 0);
+	return sent == static_cast<ssize_t>(VnetHeaderSize + frame.size());
+}
+
+std::vector<uint8_t> LinuxRawSocket::receivePacket() {
+	if (!socketOpen || socketFd < 0) {
+		return {};
+	}
+	
+	std::vector<uint8_t> buffer(maxFrameSize);
+	buffer.resize(receiveFrame(ByteSpan(buffer)));
+	return buffer;
+}
+
+size_t LinuxRawSocket::receiveInto(ByteSpan buffer) {
+	if (!socketOpen || socketFd < 0) {
+		return 0;
+	}
+	
+	return receiveFrame(buffer);
+}
+
+size_t LinuxRawSocket::receiveFrame(ByteSpan buffer) {
+	VnetHeader header;
+	struct iovec vectors[2] = {{&header, VnetHeaderSize}, {buffer.data(), buffer.size()}};
+	size_t headerSize = offloadRequested ? VnetHeaderSize : 0;
+	
+	while (true) {
+		struct msghdr message;
+		memset(&message, 0, sizeof(message));
+		message.msg_iov = offloadRequested ? vectors : vectors + 1;
+		message.msg_iovlen = offloadRequested ? 2 : 1;
+		if (!controlBuffer.empty()) {
+			message.msg_control = controlBuffer.data();
+			message.msg_controllen = controlBuffer.size();
+		}
+		
+		ssize_t received = recvmsg(socketFd, &message, MSG_DONTWAIT);
+		if (received <= static_cast<ssize_t>(headerSize)) {
+			return 0;
+		}
+		
+		// A cut frame must not be forwarded - skip it and take the next one
+		if (message.msg_flags & MSG_TRUNC) {
+			truncated.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+		
+		if (offloadRequested) {
+			frameOffload = toOffload(header);
+		}
+		if (timestampsRequested) {
+			frameTimestamp = 0;
+			for (struct cmsghdr* control = CMSG_FIRSTHDR(&message); control; control = CMSG_NXTHDR(&message, control)) {
+				if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS) {
+					struct timespec time;
+					memcpy(&time, CMSG_DATA(control), sizeof(time));
+					frameTimestamp = static_cast<uint64_t>(time.tv_sec) * 1000000000ULL + static_cast<uint64_t>(time.tv_nsec);
+				}
+			}
+		}
+		return static_cast<size_t>(received) - headerSize;
+	}
+}
+
+bool LinuxRawSocket::isOpen() const {
+	return socketOpen && socketFd >= 0;
+}
+
+bool LinuxRawSocket::setReceiveRing(const RingConfig& config) {
+	long pageSize = sysconf(_SC_PAGESIZE);
+	if (config.blockCount == 0 || config.frameSize < TPACKET3_HDRLEN ||
+	    config.frameSize % TPACKET_ALIGNMENT != 0 || config.blockSize < config.frameSize ||
+	    pageSize <= 0 || config.blockSize % static_cast<uint32_t>(pageSize) != 0) {
 		return false;
 	}
 	
-	// Prepare destination address
-	struct sockaddr_ll addr;
-	memset(&addr, 0, sizeof(addr));
-	addr.sll_family = AF_PACKET;
-	addr.sll_protocol = htons(ETH_P_ALL);
-	addr.sll_ifindex = ifr.ifr_ifindex;
-	addr.sll_halen = ETH_ALEN;
+	ringConfig = config;
+	ringRequested = true;
+	return true;
+}
+
+bool LinuxRawSocket::setFanout(uint16_t group, FanoutMode mode) {
+	fanoutRequested = true;
+	fanoutGroup = group;
+	fanoutMode = mode;
+	return true;
+}
+
+bool LinuxRawSocket::setReceiveTimestamps() {
+	timestampsRequested = true;
+	return true;
+}
+
+bool LinuxRawSocket::setSegmentationOffload() {
+	offloadRequested = true;
+	return true;
+}
+
+bool LinuxRawSocket::setTransmitRing(const RingConfig& config) {
+	long pageSize = sysconf(_SC_PAGESIZE);
+	if (config.blockCount == 0 || config.frameSize <= TxFrameOffset ||
+	    config.frameSize % TPACKET_ALIGNMENT != 0 || config.blockSize < config.frameSize ||
+	    pageSize <= 0 || config.blockSize % static_cast<uint32_t>(pageSize) != 0) {
+		return false;
+	}
 	
-	// Extract destination MAC from packet
-	if (data.size() >= 6) {
-		memcpy(addr.sll_addr, data.data(), ETH_ALEN);
+	txRingConfig = config;
+	txRingRequested = true;
+	return true;
+}
+
+bool LinuxRawSocket::setupRings() {
+	int version = TPACKET_V3;
+	if (setsockopt(socketFd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+		return false;
 	}
 	
-	// Send packet
-	ssize_t sent = sendto(socketFd, data.data(), data.size(), 0, 
-	                     (struct sockaddr*)&addr, sizeof(addr));
+	size_t rxSize = 0;
+	size_t txSize = 0;
 	
-	return sent == static_cast<ssize_t>(data.size());
+	if (ringRequested) {
+		struct tpacket_req3 request;
+		memset(&request, 0, sizeof(request));
+		request.tp_block_size = ringConfig.blockSize;
+		request.tp_block_nr = ringConfig.blockCount;
+		request.tp_frame_size = ringConfig.frameSize;
+		request.tp_frame_nr = (ringConfig.blockSize / ringConfig.frameSize) * ringConfig.blockCount;
+		request.tp_retire_blk_tov = ringConfig.blockTimeoutMs;
+		
+		if (setsockopt(socketFd, SOL_PACKET, PACKET_RX_RING, &request, sizeof(request)) < 0) {
+			return false;
+		}
+		rxSize = static_cast<size_t>(ringConfig.blockSize) * ringConfig.blockCount;
+	}
+	
+	if (txRingRequested) {
+		// Transmit ring is frame based even with TPACKET_V3
+		struct tpacket_req3 request;
+		memset(&request, 0, sizeof(request));
+		request.tp_block_size = txRingConfig.blockSize;
+		request.tp_block_nr = txRingConfig.blockCount;
+		request.tp_frame_size = txRingConfig.frameSize;
+		request.tp_frame_nr = (txRingConfig.blockSize / txRingConfig.frameSize) * txRingConfig.blockCount;
+		
+		if (setsockopt(socketFd, SOL_PACKET, PACKET_TX_RING, &request, sizeof(request)) < 0) {
+			return false;
+		}
+		txSize = static_cast<size_t>(txRingConfig.blockSize) * txRingConfig.blockCount;
+		txFrameCount = request.tp_frame_nr;
+	}
+	
+	void* mapped = mmap(nullptr, rxSize + txSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, socketFd, 0);
+	if (mapped == MAP_FAILED) {
+		return false;
+	}
+	
+	mapping = static_cast<uint8_t*>(mapped);
+	mappingSize = rxSize + txSize;
+	ring = ringRequested ? mapping : nullptr;
+	txRing = txRingRequested ? mapping + rxSize : nullptr;
+	return true;
 }
 
-std::vector<uint8_t> LinuxRawSocket::receivePacket() {
-	if (!isOpen || socketFd < 0) {
-		return {};
+void LinuxRawSocket::releaseBlock() {
+	struct tpacket_block_desc* block =
+		(struct tpacket_block_desc*)(ring + static_cast<size_t>(currentBlock) * ringConfig.blockSize);
+	__atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+	
+	currentBlock = (currentBlock + 1) % ringConfig.blockCount;
+	packetsLeft = 0;
+	nextPacket = nullptr;
+}
+
+size_t LinuxRawSocket::receivePackets(const PacketHandler& handler, size_t maxPackets) {
+	if (!socketOpen || socketFd < 0) {
+		return 0;
 	}
 	
-	std::vector<uint8_t> buffer(4096); // Max packet size
+	size_t count = 0;
 	
-	ssize_t received = recv(socketFd, buffer.data(), buffer.size(), MSG_DONTWAIT);
-	if (received <= 0) {
-		return {};
+	if (!ring) {
+		// No ring: one recvmsg() per frame, but no allocation per frame
+		size_t length;
+		while (count < maxPackets && (length = receiveFrame(ByteSpan(receiveBuffer))) > 0) {
+			handler(ByteSpan(receiveBuffer.data(), length));
+			++count;
+		}
+		return count;
 	}
 	
-	buffer.resize(received);
-	return buffer;
+	while (count < maxPackets) {
+		if (!nextPacket) {
+			// Take next block if the kernel has retired it to user space
+			struct tpacket_block_desc* block =
+				(struct tpacket_block_desc*)(ring + static_cast<size_t>(currentBlock) * ringConfig.blockSize);
+			if (!(__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER)) {
+				break;
+			}
+			
+			packetsLeft = block->hdr.bh1.num_pkts;
+			nextPacket = (uint8_t*)block + block->hdr.bh1.offset_to_first_pkt;
+			if (packetsLeft == 0) {
+				releaseBlock();
+				continue;
+			}
+		}
+		
+		struct tpacket3_hdr* header = (struct tpacket3_hdr*)nextPacket;
+		if (header->tp_snaplen < header->tp_len || header->tp_len > maxFrameSize) {
+			// Cut by the ring or longer than the link takes - skip rather than forward a broken frame
+			truncated.fetch_add(1, std::memory_order_relaxed);
+		} else {
+			if (timestampsRequested) {
+				frameTimestamp = static_cast<uint64_t>(header->tp_sec) * 1000000000ULL + header->tp_nsec;
+			}
+			if (offloadRequested) {
+				// The kernel puts virtio_net_hdr right before the frame
+				VnetHeader vnetHeader;
+				memcpy(&vnetHeader, nextPacket + header->tp_mac - VnetHeaderSize, VnetHeaderSize);
+				frameOffload = toOffload(vnetHeader);
+			}
+			handler(ByteSpan(nextPacket + header->tp_mac, header->tp_snaplen));
+			++count;
+		}
+		
+		if (--packetsLeft == 0) {
+			releaseBlock();
+		} else {
+			nextPacket += header->tp_next_offset;
+		}
+	}
+	
+	return count;
 }
 
-bool LinuxRawSocket::isOpen() const {
-	return isOpen && socketFd >= 0;
+bool LinuxRawSocket::getStatistics(Statistics& statistics) {
+	if (socketFd < 0) {
+		return false;
+	}
+	
+	// tpacket_stats_v3 starts with the tpacket_stats fields
+	struct tpacket_stats_v3 kernelStats;
+	memset(&kernelStats, 0, sizeof(kernelStats));
+	socklen_t length = ring ? sizeof(struct tpacket_stats_v3) : sizeof(struct tpacket_stats);
+	if (getsockopt(socketFd, SOL_PACKET, PACKET_STATISTICS, &kernelStats, &length) < 0) {
+		return false;
+	}
+	
+	this->statistics.packets += kernelStats.tp_packets;
+	this->statistics.drops += kernelStats.tp_drops;
+	this->statistics.freezes += kernelStats.tp_freeze_q_cnt;
+	this->statistics.truncated = truncated.load(std::memory_order_relaxed);
+	statistics = this->statistics;
+	return true;
+}
+
+bool LinuxRawSocket::attachFilter(const std::vector<BpfInstruction>& program) {
+	static_assert(sizeof(BpfInstruction) == sizeof(struct sock_filter), "BpfInstruction must match sock_filter");
+	
+	if (socketFd < 0 || program.empty()) {
+		return false;
+	}
+	
+	struct sock_fprog filter;
+	filter.len = static_cast<unsigned short>(program.size());
+	filter.filter = (struct sock_filter*)program.data();
+	
+	return setsockopt(socketFd, SOL_SOCKET, SO_ATTACH_FILTER, &filter, sizeof(filter)) == 0;
+}
+
+size_t LinuxRawSocket::sendBatch(const ConstByteSpan* frames, size_t count) {
+	return sendBatchWithOffload(frames, nullptr, count);
+}
+
+size_t LinuxRawSocket::sendBatchWithOffload(const ConstByteSpan* frames, const Offload* offloads, size_t count) {
+	if (!socketOpen || socketFd < 0) {
+		return 0;
+	}
+	
+	if (txRing) {
+		return sendThroughRing(frames, offloads, count);
+	}
+	
+	// Single forwarded frame - sendto() is cheaper than sendmmsg()
+	if (count == 1) {
+		return sendFrame(frames[0], offloads) ? 1 : 0;
+	}
+	
+	size_t sent = 0;
+	while (sent < count) {
+		size_t batch = std::min(count - sent, MaxBatch);
+		for (size_t i = 0; i < batch; ++i) {
+			// Under offload each frame follows its virtio_net_hdr
+			struct iovec* vectors = &batchVectors[2 * i];
+			size_t used = 0;
+			if (offloadRequested) {
+				batchOffloads[i] = toVnetHeader(offloads ? &offloads[sent + i] : nullptr);
+				vectors[used].iov_base = &batchOffloads[i];
+				vectors[used].iov_len = VnetHeaderSize;
+				++used;
+			}
+			vectors[used].iov_base = const_cast<uint8_t*>(frames[sent + i].data());
+			vectors[used].iov_len = frames[sent + i].size();
+			++used;
+			
+			memset(&batchHeaders[i], 0, sizeof(batchHeaders[i]));
+			batchHeaders[i].msg_hdr.msg_name = &linkAddress;
+			batchHeaders[i].msg_hdr.msg_namelen = sizeof(linkAddress);
+			batchHeaders[i].msg_hdr.msg_iov = vectors;
+			batchHeaders[i].msg_hdr.msg_iovlen = used;
+		}
+		
+		int result = sendmmsg(socketFd, batchHeaders.data(), static_cast<unsigned int>(batch), 0);
+		if (result <= 0) {
+			break;
+		}
+		sent += static_cast<size_t>(result);
+		if (static_cast<size_t>(result) < batch) {
+			break; // Socket buffer full
+		}
+	}
+	
+	return sent;
+}
+
+struct tpacket3_hdr* LinuxRawSocket::transmitSlot(uint32_t index) const {
+	const uint32_t framesPerBlock = txRingConfig.blockSize / txRingConfig.frameSize;
+	size_t offset = static_cast<size_t>(index / framesPerBlock) * txRingConfig.blockSize +
+	                static_cast<size_t>(index % framesPerBlock) * txRingConfig.frameSize;
+	return (struct tpacket3_hdr*)(txRing + offset);
+}
+
+bool LinuxRawSocket::sendOneThroughRing(ConstByteSpan frame, const Offload* offload) {
+	struct tpacket3_hdr* header = transmitSlot(txCurrentFrame);
+	if (sendThroughRing(&frame, offload, 1) != 1) {
+		return false;
+	}
+	
+	// The slot returns to TP_STATUS_AVAILABLE once the frame left; a slot the
+	// kernel could not take yet needs another send() call
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TxWaitMs);
+	while (true) {
+		uint32_t status = __atomic_load_n(&header->tp_status, __ATOMIC_ACQUIRE);
+		if (status == TP_STATUS_AVAILABLE) {
+			return true;
+		}
+		if (status == TP_STATUS_WRONG_FORMAT) {
+			__atomic_store_n(&header->tp_status, TP_STATUS_AVAILABLE, __ATOMIC_RELEASE);
+			return false;
+		}
+		if (std::chrono::steady_clock::now() >= deadline) {
+			return false; // Still queued - goes out with a later send
+		}
+		if (status == TP_STATUS_SEND_REQUEST) {
+			send(socketFd, nullptr, 0, MSG_DONTWAIT);
+		} else {
+			sched_yield();
+		}
+	}
+}
+
+size_t LinuxRawSocket::sendThroughRing(const ConstByteSpan* frames, const Offload* offloads, size_t count) {
+	const size_t headerSize = offloadRequested ? VnetHeaderSize : 0;
+	size_t queued = 0;
+	
+	for (; queued < count; ++queued) {
+		struct tpacket3_hdr* header = transmitSlot(txCurrentFrame);
+		
+		// Stop when the kernel still owns the slot (ring full) or the frame does not fit
+		if (__atomic_load_n(&header->tp_status, __ATOMIC_ACQUIRE) != TP_STATUS_AVAILABLE ||
+		    headerSize + frames[queued].size() > txRingConfig.frameSize - TxFrameOffset) {
+			break;
+		}
+		
+		// Under offload the slot holds virtio_net_hdr followed by the frame
+		uint8_t* data = (uint8_t*)header + TxFrameOffset;
+		if (offloadRequested) {
+			VnetHeader vnetHeader = toVnetHeader(offloads ? &offloads[queued] : nullptr);
+			memcpy(data, &vnetHeader, VnetHeaderSize);
+		}
+		memcpy(data + headerSize, frames[queued].data(), frames[queued].size());
+		header->tp_len = static_cast<uint32_t>(headerSize + frames[queued].size());
+		header->tp_next_offset = 0;
+		__atomic_store_n(&header->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+		
+		txCurrentFrame = (txCurrentFrame + 1) % txFrameCount;
+	}
+	
+	// One system call transmits every queued slot; slots the kernel could
+	// not send now stay queued and go out with the next call
+	if (queued > 0) {
+		send(socketFd, nullptr, 0, MSG_DONTWAIT);
+	}
+	
+	return queued;
+}
+
+LinuxEventLoop::LinuxEventLoop() {
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (epollFd < 0 || stopFd < 0) {
+		return;
+	}
+	
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.u32 = StopSource;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event);
+}
+
+LinuxEventLoop::~LinuxEventLoop() {
+	clear();
+	if (epollFd >= 0) {
+		::close(epollFd);
+	}
+	if (stopFd >= 0) {
+		::close(stopFd);
+	}
+}
+
+bool LinuxEventLoop::addSource(Source source) {
+	if (epollFd < 0) {
+		if (source.ownsFd) {
+			::close(source.fd);
+		}
+		return false;
+	}
+	
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.u32 = static_cast<uint32_t>(sources.size());
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, source.fd, &event) < 0) {
+		if (source.ownsFd) {
+			::close(source.fd);
+		}
+		return false;
+	}
+	
+	sources.push_back(std::move(source));
+	return true;
+}
+
+bool LinuxEventLoop::addTimer(uint32_t intervalMs, Handler handler) {
+	if (intervalMs == 0) {
+		return false;
+	}
+	
+	int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (fd < 0) {
+		return false;
+	}
+	
+	// First expiry right away, then every interval
+	struct itimerspec spec;
+	memset(&spec, 0, sizeof(spec));
+	spec.it_value.tv_nsec = 1;
+	spec.it_interval.tv_sec = intervalMs / 1000;
+	spec.it_interval.tv_nsec = static_cast<long>(intervalMs % 1000) * 1000000L;
+	if (timerfd_settime(fd, 0, &spec, nullptr) < 0) {
+		::close(fd);
+		return false;
+	}
+	
+	return addSource({Source::Kind::Timer, fd, true, std::move(handler), nullptr});
+}
+
+bool LinuxEventLoop::addSocket(RawSocket& socket, SocketHandler handler) {
+	int fd = socket.getDescriptor();
+	if (fd < 0) {
+		return false;
+	}
+	return addSource({Source::Kind::Socket, fd, false, nullptr, std::move(handler)});
+}
+
+bool LinuxEventLoop::addStopSignals(Handler handler) {
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	
+	// Blocked signals stay pending and are read from signalfd
+	sigset_t previous;
+	if (pthread_sigmask(SIG_BLOCK, &signals, &previous) != 0) {
+		return false;
+	}
+	
+	// addSource() closes the descriptor on failure
+	int fd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+	if (fd < 0 || !addSource({Source::Kind::Signal, fd, true, std::move(handler), nullptr})) {
+		if (!signalsBlocked) {
+			pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+		}
+		return false;
+	}
+	
+	if (!signalsBlocked) {
+		previousMask = previous;
+		signalsBlocked = true;
+	}
+	return true;
+}
+
+void LinuxEventLoop::clear() {
+	for (const auto& source : sources) {
+		if (source.ownsFd) {
+			::close(source.fd);
+		} else {
+			epoll_ctl(epollFd, EPOLL_CTL_DEL, source.fd, nullptr);
+		}
+	}
+	sources.clear();
+	
+	if (signalsBlocked) {
+		pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+		signalsBlocked = false;
+	}
+}
+
+bool LinuxEventLoop::run() {
+	if (epollFd < 0 || stopFd < 0) {
+		return false;
+	}
+	
+	struct epoll_event events[MaxEvents];
+	while (true) {
+		int count = epoll_wait(epollFd, events, MaxEvents, -1);
+		if (count < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		
+		for (int i = 0; i < count; ++i) {
+			uint32_t index = events[i].data.u32;
+			if (index == StopSource) {
+				uint64_t value;
+				ssize_t result = read(stopFd, &value, sizeof(value));
+				(void)result;
+				return true;
+			}
+			
+			Source& source = sources[index];
+			switch (source.kind) {
+			case Source::Kind::Timer: {
+				// Expiry count is ignored - missed ticks are coalesced
+				uint64_t expirations;
+				if (read(source.fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+					source.handler();
+				}
+				break;
+			}
+			case Source::Kind::Signal: {
+				struct signalfd_siginfo info;
+				bool received = false;
+				while (read(source.fd, &info, sizeof(info)) == sizeof(info)) {
+					received = true;
+				}
+				if (received) {
+					source.handler();
+				}
+				break;
+			}
+			case Source::Kind::Socket:
+				source.socketHandler();
+				break;
+			}
+		}
+	}
+}
+
+void LinuxEventLoop::stop() {
+	// write() on eventfd is async-signal-safe
+	uint64_t value = 1;
+	ssize_t result = write(stopFd, &value, sizeof(value));
+	(void)result;
 }
 
 #endif // __linux__ 
\ No newline at end of file
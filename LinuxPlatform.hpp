@@ -6,8 +6,11 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <cstdint>
+#include <atomic>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <net/if.h>
 #include <linux/if_packet.h>
@@ -17,12 +20,13 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <signal.h>
 
 ////////////////////////////////////////////////////////////
 /// \brief Linux implementation of NetworkInterface
 ///
 /// This class implements the NetworkInterface interface
-/// using Linux system calls (ioctl, socket). Provides access
+/// using Linux system calls (rtnetlink, socket). Provides access
 /// to network interface information and MAC address resolution
 /// on Linux platform.
 ///
@@ -47,16 +51,20 @@ public:
 	////////////////////////////////////////////////////////////
 	/// \brief Destructor
 	///
-	/// Releases Linux system resources.
+	/// Closes neighbour event socket, if open.
 	///
 	////////////////////////////////////////////////////////////
-	~LinuxNetworkInterface() override = default;
+	~LinuxNetworkInterface() override;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Gets list of all network interfaces
 	///
-	/// Linux implementation using ioctl() calls
-	/// to retrieve information about all network interfaces.
+	/// Linux implementation using a single rtnetlink socket.
+	/// Links, IPv4 addresses and routes are fetched with one
+	/// RTM_GETLINK, RTM_GETADDR and RTM_GETROUTE dump each and
+	/// merged by interface index. Every address of an interface
+	/// is reported; loopback and down interfaces are skipped
+	/// based on link flags, not on interface names.
 	///
 	/// \return std::vector<InterfaceInfo> List of network interfaces
 	///
@@ -68,80 +76,122 @@ public:
 	////////////////////////////////////////////////////////////
 	/// \brief Resolves IP address to MAC address
 	///
-	/// Linux implementation using ARP table lookup
-	/// to search for MAC address in system ARP table.
+	/// Linux implementation: looks the address up in the kernel
+	/// neighbour table and, if missing, sends ARP requests.
 	///
 	/// \param interfaceName Interface name to search on
 	/// \param ip IP address to resolve
 	///
-	/// \return std::vector<uint8_t> MAC address (6 bytes) or empty vector
+	/// \return MacAddress MAC address or empty address
 	///
-	/// \see NetworkInterface::resolveMacAddress()
+	/// \see NetworkInterface::resolveMacAddress(), resolveMacAddresses()
 	///
 	////////////////////////////////////////////////////////////
-	std::vector<uint8_t> resolveMacAddress(const std::string& interfaceName, 
-	                                       const std::vector<uint8_t>& ip) override;
+	MacAddress resolveMacAddress(const std::string& interfaceName,
+	                             const std::vector<uint8_t>& ip) override;
 
-private:
 	////////////////////////////////////////////////////////////
-	/// \brief Gets interface flags
+	/// \brief Resolves several IP addresses to MAC addresses
+	///
+	/// Addresses missing from the kernel neighbour table are resolved
+	/// together: a well-formed request from the interface's own
+	/// MAC and IP address is sent for each of them, and replies
+	/// are read from one packet socket whose BPF filter accepts
+	/// only ARP replies from the requested addresses. Unanswered
+	/// requests are repeated with growing timeout.
 	///
-	/// Helper function to get interface status flags.
+	/// \param interfaceName Interface name to search on
+	/// \param ips IP addresses to resolve (4 bytes each)
+	/// \param config Timeout and retry settings
 	///
-	/// \param interfaceName Interface name
+	/// \return std::vector<MacAddress> MAC address for each IP, empty if not resolved
 	///
-	/// \return int Interface flags
+	/// \see NetworkInterface::resolveMacAddresses()
 	///
 	////////////////////////////////////////////////////////////
-	int getInterfaceFlags(const std::string& interfaceName);
+	std::vector<MacAddress> resolveMacAddresses(const std::string& interfaceName,
+	                                            const std::vector<std::vector<uint8_t>>& ips,
+	                                            const ResolverConfig& config) override;
 
 	////////////////////////////////////////////////////////////
-	/// \brief Gets interface MAC address
+	/// \brief Enables neighbour lookup cache
 	///
-	/// Helper function to get interface MAC address.
+	/// Subscribes to rtnetlink neighbour notifications
+	/// (RTM_NEWNEIGH / RTM_DELNEIGH). Cached entries are
+	/// dropped when the kernel reports a change, and the whole
+	/// cache is dropped if notifications were lost. A cached
+	/// resolution replaces the RTM_GETNEIGH dump with one
+	/// non-blocking read of the notification socket; the
+	/// interface index is still looked up.
 	///
-	/// \param interfaceName Interface name
+	/// \return bool true if subscription succeeded
 	///
-	/// \return std::vector<uint8_t> MAC address
+	/// \see NetworkInterface::enableNeighbourCache()
 	///
 	////////////////////////////////////////////////////////////
-	std::vector<uint8_t> getInterfaceMacAddress(const std::string& interfaceName);
+	bool enableNeighbourCache() override;
 
+private:
 	////////////////////////////////////////////////////////////
-	/// \brief Gets interface IP address
+	/// \brief Looks IP addresses up in kernel neighbour table
 	///
-	/// Helper function to get interface IP address.
+	/// Uses one RTM_GETNEIGH dump filtered by interface index
+	/// in the kernel; destinations are matched while reading
+	/// the reply. Only entries with a usable link-layer address
+	/// are taken. Served from cache when it is enabled.
 	///
-	/// \param interfaceName Interface name
-	///
-	/// \return std::vector<uint8_t> IP address
+	/// \param index Interface index
+	/// \param ips IP addresses (4 bytes each)
+	/// \param macs Found MAC addresses (same order as ips)
 	///
 	////////////////////////////////////////////////////////////
-	std::vector<uint8_t> getInterfaceIpAddress(const std::string& interfaceName);
+	void lookupNeighbours(unsigned int index, const std::vector<std::vector<uint8_t>>& ips,
+	                      std::vector<MacAddress>& macs);
 
 	////////////////////////////////////////////////////////////
-	/// \brief Gets interface netmask
-	///
-	/// Helper function to get interface netmask.
-	///
-	/// \param interfaceName Interface name
+	/// \brief Applies pending neighbour notifications to cache
 	///
-	/// \return uint8_t Netmask prefix length
+	/// Reads the notification socket without blocking.
 	///
 	////////////////////////////////////////////////////////////
-	uint8_t getInterfaceNetmask(const std::string& interfaceName);
+	void processNeighbourEvents();
 
 	////////////////////////////////////////////////////////////
-	/// \brief Gets default gateway
+	/// \brief Resolves addresses by sending ARP requests
 	///
-	/// Helper function to get default gateway address.
+	/// Fills every empty entry of macs for which a reply
+	/// arrived before the last attempt timed out.
 	///
-	/// \param interfaceName Interface name
-	///
-	/// \return std::vector<uint8_t> Gateway IP address
+	/// \param iface Interface to send requests on
+	/// \param ips IP addresses to resolve
+	/// \param macs Resolved MAC addresses (same order as ips)
+	/// \param config Timeout and retry settings
 	///
 	////////////////////////////////////////////////////////////
-	std::vector<uint8_t> getDefaultGateway(const std::string& interfaceName);
+	void sendArpRequests(const InterfaceInfo& iface, const std::vector<std::vector<uint8_t>>& ips,
+	                     std::vector<MacAddress>& macs, const ResolverConfig& config);
+
+	int neighbourEventFd = -1; ///< Neighbour notification socket (-1 if cache disabled)
+	std::unordered_map<uint64_t, MacAddress> neighbourCache; ///< (index << 32 | IP) -> MAC
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Header of frames on a PACKET_VNET_HDR socket
+///
+/// Same layout as struct virtio_net_hdr, which cannot be
+/// included from C++ (<linux/virtio_net.h> has a field named
+/// "class"). Fields are in host byte order.
+///
+/// \see RawSocket::Offload
+///
+////////////////////////////////////////////////////////////
+struct VnetHeader {
+	uint8_t flags;           ///< VIRTIO_NET_HDR_F_*
+	uint8_t gsoType;         ///< VIRTIO_NET_HDR_GSO_*
+	uint16_t headerLength;   ///< hdr_len
+	uint16_t gsoSize;        ///< gso_size
+	uint16_t checksumStart;  ///< csum_start
+	uint16_t checksumOffset; ///< csum_offset
 };
 
 ////////////////////////////////////////////////////////////
@@ -185,6 +235,8 @@ public:
 	///
 	/// Linux implementation using socket() and setsockopt()
 	/// to create raw socket with optional promiscuous mode.
+	/// Receive buffers are sized from the interface MTU, or
+	/// for 64 KB super-frames with segmentation offload.
 	///
 	/// \param interfaceName Network interface name
 	/// \param promiscuous Whether to enable promiscuous mode
@@ -211,7 +263,8 @@ public:
 	/// \brief Sends packet through raw socket
 	///
 	/// Linux implementation using sendto()
-	/// to send data through raw socket.
+	/// to send data through raw socket (sendmsg() with an
+	/// empty VnetHeader under segmentation offload).
 	///
 	/// \param data Data to send
 	///
@@ -225,7 +278,7 @@ public:
 	////////////////////////////////////////////////////////////
 	/// \brief Receives packet from raw socket
 	///
-	/// Linux implementation using recvfrom()
+	/// Linux implementation using recvmsg()
 	/// to receive data from raw socket.
 	///
 	/// \return std::vector<uint8_t> Received data or empty vector
@@ -235,6 +288,16 @@ public:
 	////////////////////////////////////////////////////////////
 	std::vector<uint8_t> receivePacket() override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Receives packet into caller-provided buffer
+	///
+	/// Linux implementation using recvmsg() straight into the buffer.
+	///
+	/// \see RawSocket::receiveInto()
+	///
+	////////////////////////////////////////////////////////////
+	size_t receiveInto(ByteSpan buffer) override;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if socket is open
 	///
@@ -245,10 +308,383 @@ public:
 	////////////////////////////////////////////////////////////
 	bool isOpen() const override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Requests TPACKET_V3 receive ring
+	///
+	/// The ring is set up by open() with PACKET_RX_RING and
+	/// mapped into the process, so frames are read without a
+	/// system call or copy per frame.
+	///
+	/// \param config Ring geometry
+	///
+	/// \return bool true if geometry is valid
+	///
+	/// \see RawSocket::setReceiveRing()
+	///
+	////////////////////////////////////////////////////////////
+	bool setReceiveRing(const RingConfig& config) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Receives all pending frames
+	///
+	/// With a receive ring, walks the blocks owned by user
+	/// space and passes each frame in place, returning a block
+	/// to the kernel once all its frames were handled. Without
+	/// a ring, uses recvmsg() into one reused buffer. Frames
+	/// longer than the buffer or ring frame are dropped and
+	/// counted, never passed on truncated.
+	///
+	/// \param handler Called once per frame
+	/// \param maxPackets Upper bound of frames handled in this call
+	///
+	/// \return size_t Number of frames handled
+	///
+	/// \see RawSocket::receivePackets()
+	///
+	////////////////////////////////////////////////////////////
+	size_t receivePackets(const PacketHandler& handler, size_t maxPackets) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets receive counters
+	///
+	/// Reads PACKET_STATISTICS (which the kernel resets on
+	/// every read) and adds it to the totals since open().
+	///
+	/// \param statistics Filled with current counters
+	///
+	/// \return bool true if counters were read
+	///
+	/// \see RawSocket::getStatistics()
+	///
+	////////////////////////////////////////////////////////////
+	bool getStatistics(Statistics& statistics) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Attaches classic BPF program
+	///
+	/// Linux implementation using SO_ATTACH_FILTER.
+	///
+	/// \param program Filter program
+	///
+	/// \return bool true if the filter is active
+	///
+	/// \see RawSocket::attachFilter()
+	///
+	////////////////////////////////////////////////////////////
+	bool attachFilter(const std::vector<BpfInstruction>& program) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends several frames
+	///
+	/// Linux implementation: with a transmit ring, fills free
+	/// ring slots and flushes them with a single send();
+	/// otherwise passes up to MaxBatch frames to one sendmmsg().
+	///
+	/// \param frames Frames to send
+	/// \param count Number of frames
+	///
+	/// \return size_t Number of frames sent
+	///
+	/// \see RawSocket::sendBatch()
+	///
+	////////////////////////////////////////////////////////////
+	size_t sendBatch(const ConstByteSpan* frames, size_t count) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends several frames with their offload state
+	///
+	/// Under segmentation offload every frame goes out behind
+	/// its VnetHeader (in the transmit ring slot or as the
+	/// first iovec), so the kernel or the card cuts
+	/// super-frames into segments and completes checksums.
+	///
+	/// \see RawSocket::sendBatchWithOffload()
+	///
+	////////////////////////////////////////////////////////////
+	size_t sendBatchWithOffload(const ConstByteSpan* frames, const Offload* offloads, size_t count) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requests PACKET_TX_RING
+	///
+	/// \param config Ring geometry
+	///
+	/// \return bool true if geometry is valid
+	///
+	/// \see RawSocket::setTransmitRing()
+	///
+	////////////////////////////////////////////////////////////
+	bool setTransmitRing(const RingConfig& config) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets socket descriptor
+	///
+	/// The packet socket (or its receive ring) is readable
+	/// when frames are pending.
+	///
+	/// \see RawSocket::getDescriptor()
+	///
+	////////////////////////////////////////////////////////////
+	int getDescriptor() const override { return socketFd; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requests PACKET_FANOUT group joined in open()
+	///
+	/// Hash mode also sets PACKET_FANOUT_FLAG_DEFRAG, so all
+	/// fragments of a datagram reach the same socket.
+	///
+	/// \see RawSocket::setFanout()
+	///
+	////////////////////////////////////////////////////////////
+	bool setFanout(uint16_t group, FanoutMode mode) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requests kernel receive timestamps
+	///
+	/// The receive ring always carries them in the frame
+	/// headers; without a ring open() enables SO_TIMESTAMPNS
+	/// and frames are read with recvmsg().
+	///
+	/// \see RawSocket::setReceiveTimestamps()
+	///
+	////////////////////////////////////////////////////////////
+	bool setReceiveTimestamps() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets kernel receive time of the current frame
+	///
+	/// \see RawSocket::receiveTimestamp()
+	///
+	////////////////////////////////////////////////////////////
+	uint64_t receiveTimestamp() const override { return frameTimestamp; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requests PACKET_VNET_HDR set in open()
+	///
+	/// Every frame is then received and sent behind a
+	/// VnetHeader. With a ring, this needs Linux 4.14 or
+	/// later.
+	///
+	/// \see RawSocket::setSegmentationOffload()
+	///
+	////////////////////////////////////////////////////////////
+	bool setSegmentationOffload() override;
+
+	const Offload* receiveOffload() const override { return offloadRequested ? &frameOffload : nullptr; }
+	size_t getMaxFrameSize() const override { return maxFrameSize; }
+
+	static constexpr size_t MaxBatch = 64; ///< Frames per sendmmsg() call
+
 private:
+	////////////////////////////////////////////////////////////
+	/// \brief Sets up requested rings and maps them
+	///
+	/// The kernel maps the receive ring followed by the
+	/// transmit ring in a single region.
+	///
+	/// \return bool true on success
+	///
+	////////////////////////////////////////////////////////////
+	bool setupRings();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Returns current ring block to the kernel
+	///
+	////////////////////////////////////////////////////////////
+	void releaseBlock();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends batch through transmit ring
+	///
+	////////////////////////////////////////////////////////////
+	size_t sendThroughRing(const ConstByteSpan* frames, const Offload* offloads, size_t count);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends one frame through transmit ring and waits
+	///
+	/// Used by sendPacket() and single-frame sends: once the
+	/// ring is mapped the kernel ignores buffers passed to
+	/// sendto() and sendmsg().
+	///
+	/// \return bool true if the frame left the ring within
+	///              TxWaitMs
+	///
+	////////////////////////////////////////////////////////////
+	bool sendOneThroughRing(ConstByteSpan frame, const Offload* offload);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets header of a transmit ring slot
+	///
+	////////////////////////////////////////////////////////////
+	struct tpacket3_hdr* transmitSlot(uint32_t index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Receives one frame without ring
+	///
+	/// Reads the frame's VnetHeader into frameOffload and
+	/// its timestamp into frameTimestamp when requested. Frames
+	/// longer than the buffer are skipped and counted.
+	///
+	/// \return size_t Frame length, 0 if nothing is pending
+	///
+	////////////////////////////////////////////////////////////
+	size_t receiveFrame(ByteSpan buffer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends one frame with sendto() or sendmsg()
+	///
+	/// \param offload Offload state, nullptr for none
+	///
+	////////////////////////////////////////////////////////////
+	bool sendFrame(ConstByteSpan frame, const Offload* offload);
+
 	int socketFd;     ///< Linux socket file descriptor
-	bool isOpen;      ///< Whether socket is open
+	bool socketOpen;  ///< Whether socket is open
 	std::string interfaceName; ///< Interface name
+	struct sockaddr_ll linkAddress; ///< Bound interface address, set once in open()
+
+	bool ringRequested = false;    ///< Whether open() sets up receive ring
+	RingConfig ringConfig;         ///< Requested ring geometry
+	uint8_t* mapping = nullptr;    ///< Mapped rings (nullptr if none)
+	size_t mappingSize = 0;        ///< Mapped size in bytes
+	uint8_t* ring = nullptr;       ///< Receive ring inside mapping (nullptr if not used)
+	uint32_t currentBlock = 0;     ///< Block read next
+	uint32_t packetsLeft = 0;      ///< Frames left in current block
+	uint8_t* nextPacket = nullptr; ///< Next frame header (nullptr if no block held)
+	Statistics statistics;         ///< Totals since open()
+	std::vector<uint8_t> receiveBuffer; ///< Buffer for receive without ring (maxFrameSize bytes)
+	size_t maxFrameSize = 0;       ///< Largest frame received whole, set by open()
+	std::atomic<uint64_t> truncated{0}; ///< Frames dropped as too long (receive thread)
+
+	bool txRingRequested = false;  ///< Whether open() sets up transmit ring
+	RingConfig txRingConfig;       ///< Requested transmit ring geometry
+	uint8_t* txRing = nullptr;     ///< Mapped transmit ring (nullptr if not used)
+	uint32_t txFrameCount = 0;     ///< Frames in transmit ring
+	uint32_t txCurrentFrame = 0;   ///< Next transmit slot
+	std::vector<struct mmsghdr> batchHeaders; ///< sendmmsg() headers, allocated in open()
+	std::vector<struct iovec> batchVectors;   ///< sendmmsg() buffers (two per frame), allocated in open()
+	std::vector<VnetHeader> batchOffloads; ///< sendmmsg() offload headers, allocated in open()
+
+	bool fanoutRequested = false;             ///< Whether open() joins a fanout group
+	uint16_t fanoutGroup = 0;                 ///< Fanout group identifier
+	FanoutMode fanoutMode = FanoutMode::Hash; ///< Fanout distribution
+
+	bool timestampsRequested = false;         ///< Whether frames carry receive timestamps
+	uint64_t frameTimestamp = 0;              ///< Receive time of frame being handled (ns since epoch)
+	std::vector<uint8_t> controlBuffer;       ///< recvmsg() ancillary data, allocated in open()
+
+	bool offloadRequested = false;            ///< Whether open() sets PACKET_VNET_HDR
+	Offload frameOffload;                     ///< Offload state of frame being handled
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Linux implementation of EventLoop
+///
+/// Waits in epoll_wait() on timerfd timers, the packet
+/// socket, a signalfd for SIGINT/SIGTERM and an eventfd
+/// used by stop(). Nothing runs while all of them are idle.
+///
+/// The class name "LinuxEventLoop" comes from:
+/// - "Linux" - denotes Linux platform
+/// - "Event" - denotes timer, socket or signal event
+/// - "Loop" - denotes main dispatch loop
+///
+/// \see EventLoop, PlatformFactory
+///
+////////////////////////////////////////////////////////////
+class LinuxEventLoop : public EventLoop {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// Creates epoll instance and stop eventfd.
+	///
+	////////////////////////////////////////////////////////////
+	LinuxEventLoop();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Closes all descriptors and restores signal mask.
+	///
+	////////////////////////////////////////////////////////////
+	~LinuxEventLoop() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Adds periodic timer backed by timerfd
+	///
+	/// \see EventLoop::addTimer()
+	///
+	////////////////////////////////////////////////////////////
+	bool addTimer(uint32_t intervalMs, Handler handler) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Adds socket descriptor to epoll set
+	///
+	/// \see EventLoop::addSocket()
+	///
+	////////////////////////////////////////////////////////////
+	bool addSocket(RawSocket& socket, SocketHandler handler) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Blocks SIGINT/SIGTERM and reads them from signalfd
+	///
+	/// \see EventLoop::addStopSignals()
+	///
+	////////////////////////////////////////////////////////////
+	bool addStopSignals(Handler handler) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Closes all sources and unblocks signals
+	///
+	/// \see EventLoop::clear()
+	///
+	////////////////////////////////////////////////////////////
+	void clear() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Dispatches events from epoll_wait()
+	///
+	/// \see EventLoop::run()
+	///
+	////////////////////////////////////////////////////////////
+	bool run() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Writes to stop eventfd
+	///
+	/// \see EventLoop::stop()
+	///
+	////////////////////////////////////////////////////////////
+	void stop() override;
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Registered event source
+	///
+	////////////////////////////////////////////////////////////
+	struct Source {
+		enum class Kind { Timer, Socket, Signal };
+
+		Kind kind;                    ///< Type of source
+		int fd;                       ///< Watched descriptor
+		bool ownsFd;                  ///< Whether clear() closes fd
+		Handler handler;              ///< Timer and signal handler
+		SocketHandler socketHandler;  ///< Socket handler
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Registers descriptor in epoll set
+	///
+	/// \return bool true if descriptor was added
+	///
+	////////////////////////////////////////////////////////////
+	bool addSource(Source source);
+
+	int epollFd = -1;                ///< epoll instance
+	int stopFd = -1;                 ///< eventfd written by stop()
+	std::vector<Source> sources;     ///< Index is epoll user data
+	bool signalsBlocked = false;     ///< Whether previousMask must be restored
+	sigset_t previousMask;           ///< Signal mask before addStopSignals()
 };
 
 #endif // __linux__ 
\ No newline at end of file
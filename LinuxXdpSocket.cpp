@@ -0,0 +1,641 @@
+#include "LinuxXdpSocket.hpp"
+
+#ifdef __linux__
+
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <net/if.h>
+#include <linux/bpf.h>
+#include <linux/if_ether.h>
+#include <linux/if_link.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+
+namespace {
+
+constexpr uint64_t ReceiveArea = static_cast<uint64_t>(LinuxXdpSocket::RingSize) * LinuxXdpSocket::FrameSize; ///< UMEM bytes of receive frames
+constexpr uint64_t FrameMask = ~static_cast<uint64_t>(LinuxXdpSocket::FrameSize - 1); ///< Frame start of a UMEM offset
+constexpr uint32_t QueueId = 0;         ///< Receive queue the socket is bound to
+constexpr int MaxWakeups = LinuxXdpSocket::RingSize / 16; ///< sendto() calls per batch in copy mode (16+ frames each)
+constexpr uint32_t MaxInFlight = LinuxXdpSocket::RingSize / 2; ///< Receive frames sent in place at once, the rest stays with the NIC
+constexpr char License[] = "Dual MIT/GPL";
+
+static_assert(LinuxXdpSocket::Headroom == XDP_PACKET_HEADROOM, "Headroom must match the kernel");
+
+// eBPF registers of the XDP program
+constexpr uint8_t Context = 1;      ///< struct xdp_md (argument), then map for the helper call
+constexpr uint8_t FrameStart = 2;   ///< xdp_md::data, then queue index for the helper call
+constexpr uint8_t FrameEnd = 3;     ///< xdp_md::data_end, then default action for the helper call
+constexpr uint8_t ReadEnd = 4;      ///< FrameStart plus bytes the filter reads
+constexpr uint8_t Accumulator = 5;  ///< Classic BPF register A
+constexpr uint8_t SavedContext = 6; ///< Context kept across the filter
+
+////////////////////////////////////////////////////////////
+/// \brief Runs bpf(2) system call
+///
+/// \return long Descriptor or 0 on success, -1 on error
+///
+////////////////////////////////////////////////////////////
+long bpf(int command, union bpf_attr& attributes) {
+	return syscall(__NR_bpf, command, &attributes, sizeof(attributes));
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Builds one eBPF instruction
+///
+////////////////////////////////////////////////////////////
+struct bpf_insn instruction(uint8_t code, uint8_t destination, uint8_t source, int16_t offset, int32_t immediate) {
+	struct bpf_insn result;
+	memset(&result, 0, sizeof(result));
+	result.code = code;
+	result.dst_reg = destination & 0x0F;
+	result.src_reg = source & 0x0F;
+	result.off = offset;
+	result.imm = immediate;
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Gets eBPF length of a classic BPF instruction
+///
+/// \return size_t Number of eBPF instructions, 0 if unsupported
+///
+////////////////////////////////////////////////////////////
+size_t translatedLength(const BpfInstruction& classic) {
+	switch (classic.code) {
+	case BPF_LD | BPF_W | BPF_ABS:
+	case BPF_LD | BPF_H | BPF_ABS:
+		return 2; // Load, byte swap
+	case BPF_LD | BPF_B | BPF_ABS:
+		return 1;
+	case BPF_JMP | BPF_JEQ | BPF_K:
+		return 2; // Jump if equal, jump otherwise
+	case BPF_JMP | BPF_JA:
+	case BPF_RET | BPF_K:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Builds XDP program running a classic BPF filter
+///
+/// Frames the filter accepts are redirected to the socket in
+/// the XSKMAP slot of their receive queue; rejected frames,
+/// frames shorter than the filter reads and frames of queues
+/// without a socket go on to the kernel stack. Classic jumps
+/// are forward only, so the result needs no loop checks.
+///
+/// \param filter Program of absolute loads, equality jumps and returns
+/// \param mapFd XSKMAP descriptor
+///
+/// \return std::vector<struct bpf_insn> Program, empty if the filter is unsupported
+///
+////////////////////////////////////////////////////////////
+std::vector<struct bpf_insn> translateFilter(const std::vector<BpfInstruction>& filter, int mapFd) {
+	const size_t PrologueLength = 7;
+
+	// Start of every classic instruction in the result, then the two exits
+	std::vector<size_t> start(filter.size() + 1, PrologueLength);
+	uint32_t readEnd = 0;
+	for (size_t i = 0; i < filter.size(); ++i) {
+		size_t length = translatedLength(filter[i]);
+		if (length == 0) {
+			return {};
+		}
+		start[i + 1] = start[i] + length;
+		if (BPF_CLASS(filter[i].code) == BPF_LD) {
+			uint32_t size = BPF_SIZE(filter[i].code) == BPF_W ? 4 : BPF_SIZE(filter[i].code) == BPF_H ? 2 : 1;
+			if (filter[i].k > INT16_MAX - size) {
+				return {};
+			}
+			readEnd = std::max(readEnd, filter[i].k + size);
+		}
+	}
+	const size_t pass = start[filter.size()];
+	const size_t redirect = pass + 2;
+
+	std::vector<struct bpf_insn> program;
+	auto jumpTo = [&program](size_t target) { return static_cast<int16_t>(target - program.size() - 1); };
+	auto classicTarget = [&start, &filter](size_t next, uint32_t skip, size_t& target) {
+		if (next + skip >= filter.size()) {
+			return false;
+		}
+		target = start[next + skip];
+		return true;
+	};
+
+	// One bounds check covers every load of the filter
+	program.push_back(instruction(BPF_LDX | BPF_W | BPF_MEM, FrameStart, Context, offsetof(struct xdp_md, data), 0));
+	program.push_back(instruction(BPF_LDX | BPF_W | BPF_MEM, FrameEnd, Context, offsetof(struct xdp_md, data_end), 0));
+	program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_X, SavedContext, Context, 0, 0));
+	program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_K, Accumulator, 0, 0, 0));
+	program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_X, ReadEnd, FrameStart, 0, 0));
+	program.push_back(instruction(BPF_ALU64 | BPF_ADD | BPF_K, ReadEnd, 0, 0, static_cast<int32_t>(readEnd)));
+	program.push_back(instruction(BPF_JMP | BPF_JGT | BPF_X, ReadEnd, FrameEnd, jumpTo(pass), 0));
+
+	for (size_t i = 0; i < filter.size(); ++i) {
+		const BpfInstruction& classic = filter[i];
+		int16_t offset = static_cast<int16_t>(classic.k);
+		size_t target = 0;
+		size_t otherwise = 0;
+		switch (classic.code) {
+		case BPF_LD | BPF_W | BPF_ABS:
+			program.push_back(instruction(BPF_LDX | BPF_W | BPF_MEM, Accumulator, FrameStart, offset, 0));
+			program.push_back(instruction(BPF_ALU | BPF_END | BPF_TO_BE, Accumulator, 0, 0, 32));
+			break;
+		case BPF_LD | BPF_H | BPF_ABS:
+			program.push_back(instruction(BPF_LDX | BPF_H | BPF_MEM, Accumulator, FrameStart, offset, 0));
+			program.push_back(instruction(BPF_ALU | BPF_END | BPF_TO_BE, Accumulator, 0, 0, 16));
+			break;
+		case BPF_LD | BPF_B | BPF_ABS:
+			program.push_back(instruction(BPF_LDX | BPF_B | BPF_MEM, Accumulator, FrameStart, offset, 0));
+			break;
+		case BPF_JMP | BPF_JEQ | BPF_K:
+			// 32-bit compare: the constant must not be sign-extended
+			if (!classicTarget(i + 1, classic.jt, target) || !classicTarget(i + 1, classic.jf, otherwise)) {
+				return {};
+			}
+			program.push_back(instruction(BPF_JMP32 | BPF_JEQ | BPF_K, Accumulator, 0, jumpTo(target),
+			                              static_cast<int32_t>(classic.k)));
+			program.push_back(instruction(BPF_JMP | BPF_JA, 0, 0, jumpTo(otherwise), 0));
+			break;
+		case BPF_JMP | BPF_JA:
+			if (!classicTarget(i + 1, classic.k, target)) {
+				return {};
+			}
+			program.push_back(instruction(BPF_JMP | BPF_JA, 0, 0, jumpTo(target), 0));
+			break;
+		case BPF_RET | BPF_K:
+			program.push_back(instruction(BPF_JMP | BPF_JA, 0, 0, jumpTo(classic.k != 0 ? redirect : pass), 0));
+			break;
+		}
+	}
+
+	// Pass: leave the frame to the kernel
+	program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_K, 0, 0, 0, XDP_PASS));
+	program.push_back(instruction(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+
+	// Redirect: bpf_redirect_map(map, rx_queue_index, XDP_PASS if the slot is empty)
+	program.push_back(instruction(BPF_LD | BPF_DW | BPF_IMM, Context, BPF_PSEUDO_MAP_FD, 0, mapFd));
+	program.push_back(instruction(0, 0, 0, 0, 0));
+	program.push_back(instruction(BPF_LDX | BPF_W | BPF_MEM, FrameStart, SavedContext,
+	                              offsetof(struct xdp_md, rx_queue_index), 0));
+	program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_K, FrameEnd, 0, 0, XDP_PASS));
+	program.push_back(instruction(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map));
+	program.push_back(instruction(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+	return program;
+}
+
+} // namespace
+
+LinuxXdpSocket::LinuxXdpSocket(bool forceGeneric) : forceGeneric(forceGeneric) {
+	memset(&linkAddress, 0, sizeof(linkAddress));
+}
+
+LinuxXdpSocket::~LinuxXdpSocket() {
+	close();
+}
+
+////////////////////////////////////////////////////////////
+bool LinuxXdpSocket::open(const std::string& interfaceName, bool promiscuous) {
+	close();
+
+	// Packet socket with protocol 0 receives nothing; it sends ARP and serves ioctls
+	packetFd = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+	if (packetFd < 0) {
+		return false;
+	}
+
+	struct ifreq ifr;
+	memset(&ifr, 0, sizeof(ifr));
+	strncpy(ifr.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
+	if (ioctl(packetFd, SIOCGIFINDEX, &ifr) < 0) {
+		close();
+		return false;
+	}
+	const int ifindex = ifr.ifr_ifindex;
+
+	linkAddress.sll_family = AF_PACKET;
+	linkAddress.sll_protocol = htons(ETH_P_ALL);
+	linkAddress.sll_ifindex = ifindex;
+
+	if (promiscuous) {
+		if (ioctl(packetFd, SIOCGIFFLAGS, &ifr) < 0) {
+			close();
+			return false;
+		}
+		ifr.ifr_flags |= IFF_PROMISC;
+		if (ioctl(packetFd, SIOCSIFFLAGS, &ifr) < 0) {
+			close();
+			return false;
+		}
+	}
+
+	socketFd = socket(AF_XDP, SOCK_RAW | SOCK_CLOEXEC, 0);
+	if (socketFd < 0) {
+		close();
+		return false;
+	}
+
+	// UMEM: receive frames, then transmit frames
+	const size_t umemSize = 2 * ReceiveArea;
+	void* area = mmap(nullptr, umemSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+	if (area == MAP_FAILED) {
+		close();
+		return false;
+	}
+	umem = static_cast<uint8_t*>(area);
+
+	struct xdp_umem_reg registration;
+	memset(&registration, 0, sizeof(registration));
+	registration.addr = reinterpret_cast<uint64_t>(umem);
+	registration.len = umemSize;
+	registration.chunk_size = FrameSize;
+	registration.headroom = 0;
+
+	uint32_t ringSize = RingSize;
+	if (setsockopt(socketFd, SOL_XDP, XDP_UMEM_REG, &registration, sizeof(registration)) < 0 ||
+	    setsockopt(socketFd, SOL_XDP, XDP_UMEM_FILL_RING, &ringSize, sizeof(ringSize)) < 0 ||
+	    setsockopt(socketFd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &ringSize, sizeof(ringSize)) < 0 ||
+	    setsockopt(socketFd, SOL_XDP, XDP_RX_RING, &ringSize, sizeof(ringSize)) < 0 ||
+	    setsockopt(socketFd, SOL_XDP, XDP_TX_RING, &ringSize, sizeof(ringSize)) < 0) {
+		close();
+		return false;
+	}
+
+	struct xdp_mmap_offsets offsets;
+	socklen_t length = sizeof(offsets);
+	if (getsockopt(socketFd, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &length) < 0 ||
+	    !mapRing(fillRing, offsets.fr, XDP_UMEM_PGOFF_FILL_RING, sizeof(uint64_t)) ||
+	    !mapRing(completionRing, offsets.cr, XDP_UMEM_PGOFF_COMPLETION_RING, sizeof(uint64_t)) ||
+	    !mapRing(rxRing, offsets.rx, XDP_PGOFF_RX_RING, sizeof(struct xdp_desc)) ||
+	    !mapRing(txRing, offsets.tx, XDP_PGOFF_TX_RING, sizeof(struct xdp_desc))) {
+		close();
+		return false;
+	}
+
+	// Every receive frame starts in the fill ring, every transmit frame is free
+	recycled.resize(RingSize);
+	completed.resize(RingSize);
+	txFrames.clear();
+	txFrames.reserve(RingSize);
+	for (uint32_t i = 0; i < RingSize; ++i) {
+		recycled[i] = static_cast<uint64_t>(i) * FrameSize;
+		txFrames.push_back(ReceiveArea + static_cast<uint64_t>(RingSize - 1 - i) * FrameSize);
+	}
+	fill(recycled.data(), RingSize);
+
+	// Until the socket is in the map, redirects fall back to XDP_PASS
+	union bpf_attr attributes;
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.map_type = BPF_MAP_TYPE_XSKMAP;
+	attributes.key_size = sizeof(uint32_t);
+	attributes.value_size = sizeof(int);
+	attributes.max_entries = QueueId + 1;
+	mapFd = static_cast<int>(bpf(BPF_MAP_CREATE, attributes));
+	if (mapFd < 0) {
+		close();
+		return false;
+	}
+
+	programFd = loadProgram({});
+	if (programFd < 0 || !attachProgram(ifindex)) {
+		close();
+		return false;
+	}
+
+	// Zero-copy needs driver support for the queue; copy mode works everywhere
+	struct sockaddr_xdp address;
+	memset(&address, 0, sizeof(address));
+	address.sxdp_family = AF_XDP;
+	address.sxdp_ifindex = static_cast<uint32_t>(ifindex);
+	address.sxdp_queue_id = QueueId;
+	address.sxdp_flags = XDP_ZEROCOPY | XDP_USE_NEED_WAKEUP;
+	zeroCopy = nativeMode && bind(socketFd, (struct sockaddr*)&address, sizeof(address)) == 0;
+	if (!zeroCopy) {
+		address.sxdp_flags = XDP_COPY | XDP_USE_NEED_WAKEUP;
+		if (bind(socketFd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+			close();
+			return false;
+		}
+	}
+
+	uint32_t key = QueueId;
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.map_fd = static_cast<uint32_t>(mapFd);
+	attributes.key = reinterpret_cast<uint64_t>(&key);
+	attributes.value = reinterpret_cast<uint64_t>(&socketFd);
+	if (bpf(BPF_MAP_UPDATE_ELEM, attributes) < 0) {
+		close();
+		return false;
+	}
+
+	received = 0;
+	heldLength = 0;
+	inFlight = 0;
+	completedCount = 0;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void LinuxXdpSocket::close() {
+	// Closing the link detaches the program
+	for (int* fd : {&linkFd, &programFd, &mapFd, &socketFd, &packetFd}) {
+		if (*fd >= 0) {
+			::close(*fd);
+			*fd = -1;
+		}
+	}
+	for (Ring* ring : {&fillRing, &completionRing, &rxRing, &txRing}) {
+		if (ring->mapping) {
+			munmap(ring->mapping, ring->mappingSize);
+		}
+		*ring = Ring();
+	}
+	if (umem) {
+		munmap(umem, 2 * ReceiveArea);
+		umem = nullptr;
+	}
+	nativeMode = false;
+	zeroCopy = false;
+}
+
+////////////////////////////////////////////////////////////
+bool LinuxXdpSocket::mapRing(Ring& ring, const struct xdp_ring_offset& offsets, uint64_t offset, size_t entrySize) {
+	size_t size = offsets.desc + RingSize * entrySize;
+	void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, socketFd,
+	                     static_cast<off_t>(offset));
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+
+	uint8_t* base = static_cast<uint8_t*>(mapping);
+	ring.mapping = mapping;
+	ring.mappingSize = size;
+	ring.producer = reinterpret_cast<uint32_t*>(base + offsets.producer);
+	ring.consumer = reinterpret_cast<uint32_t*>(base + offsets.consumer);
+	ring.flags = reinterpret_cast<uint32_t*>(base + offsets.flags);
+	ring.descriptors = base + offsets.desc;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+int LinuxXdpSocket::loadProgram(const std::vector<BpfInstruction>& filter) {
+	// No filter: accept every frame
+	static const std::vector<BpfInstruction> AcceptAll = {{BPF_RET | BPF_K, 0, 0, 1}};
+	std::vector<struct bpf_insn> program = translateFilter(filter.empty() ? AcceptAll : filter, mapFd);
+	if (program.empty()) {
+		return -1;
+	}
+
+	union bpf_attr attributes;
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.prog_type = BPF_PROG_TYPE_XDP;
+	attributes.expected_attach_type = BPF_XDP;
+	attributes.insns = reinterpret_cast<uint64_t>(program.data());
+	attributes.insn_cnt = static_cast<uint32_t>(program.size());
+	attributes.license = reinterpret_cast<uint64_t>(License);
+	return static_cast<int>(bpf(BPF_PROG_LOAD, attributes));
+}
+
+////////////////////////////////////////////////////////////
+bool LinuxXdpSocket::attachProgram(int ifindex) {
+	union bpf_attr attributes;
+	for (uint32_t mode : {XDP_FLAGS_DRV_MODE, XDP_FLAGS_SKB_MODE}) {
+		if (mode == XDP_FLAGS_DRV_MODE && forceGeneric) {
+			continue;
+		}
+		memset(&attributes, 0, sizeof(attributes));
+		attributes.link_create.prog_fd = static_cast<uint32_t>(programFd);
+		attributes.link_create.target_ifindex = static_cast<uint32_t>(ifindex);
+		attributes.link_create.attach_type = BPF_XDP;
+		attributes.link_create.flags = mode;
+		linkFd = static_cast<int>(bpf(BPF_LINK_CREATE, attributes));
+		if (linkFd >= 0) {
+			nativeMode = mode == XDP_FLAGS_DRV_MODE;
+			return true;
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+bool LinuxXdpSocket::attachFilter(const std::vector<BpfInstruction>& program) {
+	if (linkFd < 0) {
+		return false;
+	}
+
+	int filtered = loadProgram(program);
+	if (filtered < 0) {
+		return false;
+	}
+
+	union bpf_attr attributes;
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.link_update.link_fd = static_cast<uint32_t>(linkFd);
+	attributes.link_update.new_prog_fd = static_cast<uint32_t>(filtered);
+	if (bpf(BPF_LINK_UPDATE, attributes) < 0) {
+		::close(filtered);
+		return false;
+	}
+	::close(programFd);
+	programFd = filtered;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void LinuxXdpSocket::fill(const uint64_t* addresses, uint32_t count) {
+	if (count == 0) {
+		return;
+	}
+
+	// The ring has a slot for every receive frame, so it is never full
+	uint32_t producer = *fillRing.producer;
+	uint64_t* entries = reinterpret_cast<uint64_t*>(fillRing.descriptors);
+	for (uint32_t i = 0; i < count; ++i) {
+		entries[(producer + i) & (RingSize - 1)] = addresses[i] & FrameMask;
+	}
+	__atomic_store_n(fillRing.producer, producer + count, __ATOMIC_RELEASE);
+
+	if (__atomic_load_n(fillRing.flags, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP) {
+		recvfrom(socketFd, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+	}
+}
+
+////////////////////////////////////////////////////////////
+size_t LinuxXdpSocket::receivePackets(const PacketHandler& handler, size_t maxPackets) {
+	if (socketFd < 0) {
+		return 0;
+	}
+
+	// Frames sent in place complete after sendBatch() returned; hand them
+	// back to the NIC here, as the fill ring belongs to this thread
+	if (inFlight != 0) {
+		reclaimCompleted();
+	}
+	fill(completed.data(), completedCount);
+	completedCount = 0;
+
+	uint32_t consumer = *rxRing.consumer;
+	uint32_t available = __atomic_load_n(rxRing.producer, __ATOMIC_ACQUIRE) - consumer;
+	uint32_t count = static_cast<uint32_t>(std::min<size_t>(available, maxPackets));
+	const struct xdp_desc* descriptors = reinterpret_cast<const struct xdp_desc*>(rxRing.descriptors);
+
+	uint32_t handled = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		const struct xdp_desc& descriptor = descriptors[(consumer + i) & (RingSize - 1)];
+		heldAddress = descriptor.addr;
+		heldLength = descriptor.len;
+		heldSent = false;
+		handler(ByteSpan(umem + descriptor.addr, descriptor.len));
+
+		// A frame sent in place returns through the completion ring
+		if (!heldSent) {
+			recycled[handled++] = descriptor.addr;
+		}
+	}
+	heldLength = 0;
+
+	__atomic_store_n(rxRing.consumer, consumer + count, __ATOMIC_RELEASE);
+	fill(recycled.data(), handled);
+	received.fetch_add(count, std::memory_order_relaxed);
+	return count;
+}
+
+////////////////////////////////////////////////////////////
+std::vector<uint8_t> LinuxXdpSocket::receivePacket() {
+	std::vector<uint8_t> frame;
+	receivePackets([&frame](ByteSpan data) { frame.assign(data.begin(), data.end()); }, 1);
+	return frame;
+}
+
+////////////////////////////////////////////////////////////
+size_t LinuxXdpSocket::receiveInto(ByteSpan buffer) {
+	size_t length = 0;
+	receivePackets([&buffer, &length](ByteSpan data) {
+		length = std::min(data.size(), buffer.size());
+		memcpy(buffer.data(), data.data(), length);
+	}, 1);
+	return length;
+}
+
+////////////////////////////////////////////////////////////
+void LinuxXdpSocket::reclaimCompleted() {
+	uint32_t consumer = *completionRing.consumer;
+	uint32_t available = __atomic_load_n(completionRing.producer, __ATOMIC_ACQUIRE) - consumer;
+	const uint64_t* entries = reinterpret_cast<const uint64_t*>(completionRing.descriptors);
+
+	for (uint32_t i = 0; i < available; ++i) {
+		uint64_t frame = entries[(consumer + i) & (RingSize - 1)] & FrameMask;
+		if (frame < ReceiveArea) {
+			completed[completedCount++] = frame;
+			--inFlight;
+		} else {
+			txFrames.push_back(frame);
+		}
+	}
+
+	__atomic_store_n(completionRing.consumer, consumer + available, __ATOMIC_RELEASE);
+}
+
+////////////////////////////////////////////////////////////
+bool LinuxXdpSocket::isHeld(const ConstByteSpan& frame) const {
+	const uint8_t* heldFrame = umem + (heldAddress & FrameMask);
+	return heldLength != 0 && !heldSent && inFlight < MaxInFlight &&
+	       frame.data() >= heldFrame && frame.data() + frame.size() <= heldFrame + FrameSize;
+}
+
+////////////////////////////////////////////////////////////
+size_t LinuxXdpSocket::sendBatch(const ConstByteSpan* frames, size_t count) {
+	if (socketFd < 0) {
+		return 0;
+	}
+
+	reclaimCompleted();
+
+	uint32_t producer = *txRing.producer;
+	uint32_t room = RingSize - (producer - __atomic_load_n(txRing.consumer, __ATOMIC_ACQUIRE));
+	struct xdp_desc* descriptors = reinterpret_cast<struct xdp_desc*>(txRing.descriptors);
+
+	size_t sent = 0;
+	while (sent < count && sent < room) {
+		const ConstByteSpan& frame = frames[sent];
+		uint64_t address;
+		// Only a receive frame can be the held one; the held* members are
+		// written by the receive thread, so other buffers must not read them
+		if (frame.data() >= umem && frame.data() < umem + ReceiveArea && isHeld(frame)) {
+			// Frame in the receive handler: send it where it is
+			address = static_cast<uint64_t>(frame.data() - umem);
+			heldSent = true;
+			++inFlight;
+		} else {
+			if (txFrames.empty() || frame.size() > getMaxFrameSize()) {
+				break;
+			}
+			address = txFrames.back();
+			txFrames.pop_back();
+			memcpy(umem + address, frame.data(), frame.size());
+		}
+
+		struct xdp_desc& descriptor = descriptors[(producer + sent) & (RingSize - 1)];
+		descriptor.addr = address;
+		descriptor.len = static_cast<uint32_t>(frame.size());
+		descriptor.options = 0;
+		++sent;
+	}
+
+	if (sent == 0) {
+		return 0;
+	}
+	__atomic_store_n(txRing.producer, producer + static_cast<uint32_t>(sent), __ATOMIC_RELEASE);
+
+	// Zero-copy drivers send on their own unless they ask for a wakeup;
+	// in copy mode each sendto() transmits a limited batch (EAGAIN while frames remain)
+	if (!zeroCopy || (__atomic_load_n(txRing.flags, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP)) {
+		for (int i = 0; i < MaxWakeups; ++i) {
+			if (sendto(socketFd, nullptr, 0, MSG_DONTWAIT, nullptr, 0) >= 0 || errno != EAGAIN) {
+				break;
+			}
+		}
+	}
+	return sent;
+}
+
+////////////////////////////////////////////////////////////
+bool LinuxXdpSocket::sendPacket(const std::vector<uint8_t>& data) {
+	if (packetFd < 0) {
+		return false;
+	}
+
+	ssize_t sent = sendto(packetFd, data.data(), data.size(), 0, (struct sockaddr*)&linkAddress, sizeof(linkAddress));
+	return sent == static_cast<ssize_t>(data.size());
+}
+
+////////////////////////////////////////////////////////////
+bool LinuxXdpSocket::getStatistics(Statistics& statistics) {
+	if (socketFd < 0) {
+		return false;
+	}
+
+	struct xdp_statistics kernelStats;
+	memset(&kernelStats, 0, sizeof(kernelStats));
+	socklen_t length = sizeof(kernelStats);
+	if (getsockopt(socketFd, SOL_XDP, XDP_STATISTICS, &kernelStats, &length) < 0) {
+		return false;
+	}
+
+	// Kernel counters run since bind, unlike PACKET_STATISTICS
+	statistics = Statistics();
+	statistics.drops = kernelStats.rx_dropped + kernelStats.rx_ring_full;
+	statistics.packets = received.load(std::memory_order_relaxed) + statistics.drops;
+	return true;
+}
+
+#endif // __linux__
\ No newline at end of file
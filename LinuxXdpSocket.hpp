@@ -0,0 +1,299 @@
+#pragma once
+
+#include "PlatformAbstraction.hpp"
+
+#ifdef __linux__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <sys/socket.h>
+#include <linux/if_packet.h>
+#include <linux/if_xdp.h>
+
+////////////////////////////////////////////////////////////
+/// \brief Linux AF_XDP implementation of RawSocket
+///
+/// Frames are taken off the driver by an XDP program before
+/// the kernel allocates socket buffers, and land in a UMEM
+/// area shared with the kernel. One UMEM serves both
+/// directions: its first half feeds the receive side (fill
+/// ring), its second half the transmit side. A received
+/// frame sent from inside the receivePackets() handler, as
+/// the attack loop forwards, goes to the transmit ring in
+/// place - it is neither copied nor returned to the fill
+/// ring until its transmission completes. Other frames are
+/// copied into a free transmit frame.
+///
+/// open() loads an XDP program (built as raw eBPF, no
+/// libbpf) that redirects frames of queue 0 to the socket
+/// through an XSKMAP and leaves frames of other queues to
+/// the kernel. It attaches in native (driver) mode and binds
+/// zero-copy where the driver allows, falling back to copy
+/// mode and to generic (SKB) mode on drivers without XDP
+/// support; generic mode can also be forced. attachFilter()
+/// translates the classic BPF program into the XDP program,
+/// so only accepted frames leave the kernel stack; without a
+/// filter the socket takes every frame of the queue.
+///
+/// sendPacket() goes through a separate AF_PACKET socket, so
+/// it may be called from another thread than sendBatch().
+/// receivePackets() and sendBatch() each belong to one
+/// thread; in-place forwarding needs both on the same one.
+///
+/// Requires Linux 5.9 (XDP links); the interface should have
+/// a single receive queue, or flow steering to queue 0.
+///
+/// The class name "LinuxXdpSocket" comes from:
+/// - "Linux" - denotes Linux platform
+/// - "Xdp" - denotes eXpress Data Path
+/// - "Socket" - denotes network socket
+///
+/// \see RawSocket, LinuxRawSocket, PlatformFactory
+///
+////////////////////////////////////////////////////////////
+class LinuxXdpSocket : public RawSocket {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param forceGeneric Attach in generic (SKB) mode even if
+	///                     the driver supports native XDP
+	///
+	////////////////////////////////////////////////////////////
+	explicit LinuxXdpSocket(bool forceGeneric = false);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Closes the socket and detaches the XDP program.
+	///
+	/// \see close()
+	///
+	////////////////////////////////////////////////////////////
+	~LinuxXdpSocket() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Opens AF_XDP socket on queue 0 of the interface
+	///
+	/// Registers the UMEM, maps the four rings, binds the
+	/// socket and attaches the XDP program.
+	///
+	/// \param interfaceName Network interface name
+	/// \param promiscuous Whether to enable promiscuous mode
+	///
+	/// \return bool true if socket was successfully opened
+	///
+	/// \see RawSocket::open()
+	///
+	////////////////////////////////////////////////////////////
+	bool open(const std::string& interfaceName, bool promiscuous = true) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Closes socket, detaches XDP program
+	///
+	/// \see RawSocket::close()
+	///
+	////////////////////////////////////////////////////////////
+	void close() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends packet through the AF_PACKET socket
+	///
+	/// \see RawSocket::sendPacket()
+	///
+	////////////////////////////////////////////////////////////
+	bool sendPacket(const std::vector<uint8_t>& data) override;
+
+	std::vector<uint8_t> receivePacket() override;
+	size_t receiveInto(ByteSpan buffer) override;
+	bool isOpen() const override { return socketFd >= 0; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Receives all pending frames from the RX ring
+	///
+	/// Returns frames whose in-place transmission completed to
+	/// the fill ring, then passes each received frame in place
+	/// in the UMEM and returns the handled frames in one batch.
+	///
+	/// \see RawSocket::receivePackets()
+	///
+	////////////////////////////////////////////////////////////
+	size_t receivePackets(const PacketHandler& handler, size_t maxPackets) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets receive counters
+	///
+	/// Drops are frames the kernel could not place in the UMEM
+	/// (full RX ring, too long, no free frame), read from
+	/// XDP_STATISTICS.
+	///
+	/// \see RawSocket::getStatistics()
+	///
+	////////////////////////////////////////////////////////////
+	bool getStatistics(Statistics& statistics) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Runs classic BPF filter in the XDP program
+	///
+	/// Supports the absolute loads, equality jumps and returns
+	/// BpfFilterBuilder emits. The new program replaces the
+	/// attached one atomically.
+	///
+	/// \return bool true if the filter is active
+	///
+	/// \see RawSocket::attachFilter()
+	///
+	////////////////////////////////////////////////////////////
+	bool attachFilter(const std::vector<BpfInstruction>& program) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends several frames through the TX ring
+	///
+	/// Reclaims completed transmit frames first. The frame
+	/// currently handled by receivePackets() is sent in place
+	/// while at most half of the receive frames are in flight;
+	/// others are copied into free transmit frames. The kernel is woken
+	/// only when it asks for it (always in copy mode).
+	///
+	/// \see RawSocket::sendBatch()
+	///
+	////////////////////////////////////////////////////////////
+	size_t sendBatch(const ConstByteSpan* frames, size_t count) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets socket descriptor
+	///
+	/// The AF_XDP socket is readable when the RX ring holds
+	/// frames.
+	///
+	/// \see RawSocket::getDescriptor()
+	///
+	////////////////////////////////////////////////////////////
+	int getDescriptor() const override { return socketFd; }
+
+	size_t getMaxFrameSize() const override { return FrameSize - Headroom; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Checks if the XDP program runs in the driver
+	///
+	/// \return bool true for native mode, false for generic (SKB)
+	///
+	////////////////////////////////////////////////////////////
+	bool isNativeMode() const { return nativeMode; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Checks if the driver reads and writes the UMEM
+	///
+	/// \return bool true if bound with XDP_ZEROCOPY
+	///
+	////////////////////////////////////////////////////////////
+	bool isZeroCopy() const { return zeroCopy; }
+
+	static constexpr uint32_t FrameSize = 4096;  ///< UMEM frame (chunk) size
+	static constexpr uint32_t RingSize = 2048;   ///< Descriptors per ring, also frames per direction
+	static constexpr uint32_t Headroom = 256;    ///< XDP_PACKET_HEADROOM the kernel keeps before received frames
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief One mapped AF_XDP ring
+	///
+	/// The process owns the producer index of the fill and TX
+	/// rings and the consumer index of the RX and completion
+	/// rings; the other index is written by the kernel.
+	///
+	////////////////////////////////////////////////////////////
+	struct Ring {
+		uint32_t* producer = nullptr;  ///< Producer index (free-running)
+		uint32_t* consumer = nullptr;  ///< Consumer index (free-running)
+		uint32_t* flags = nullptr;     ///< XDP_RING_NEED_WAKEUP
+		uint8_t* descriptors = nullptr; ///< RingSize entries
+		void* mapping = nullptr;       ///< Mapped region
+		size_t mappingSize = 0;        ///< Mapped size in bytes
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Maps a ring after its size was set
+	///
+	/// \param offsets Layout from XDP_MMAP_OFFSETS
+	/// \param offset Page offset selecting the ring
+	/// \param entrySize Bytes per descriptor
+	///
+	////////////////////////////////////////////////////////////
+	bool mapRing(Ring& ring, const struct xdp_ring_offset& offsets, uint64_t offset, size_t entrySize);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Loads XDP program redirecting accepted frames
+	///
+	/// \param filter Classic BPF filter, empty to accept every frame
+	///
+	/// \return int Program descriptor or -1 on error
+	///
+	////////////////////////////////////////////////////////////
+	int loadProgram(const std::vector<BpfInstruction>& filter);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Attaches program to the interface
+	///
+	/// Tries native mode, then generic mode.
+	///
+	////////////////////////////////////////////////////////////
+	bool attachProgram(int ifindex);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Passes frames to the fill ring
+	///
+	////////////////////////////////////////////////////////////
+	void fill(const uint64_t* addresses, uint32_t count);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Moves completed transmissions back to their pool
+	///
+	/// Transmit frames go to txFrames. Receive frames sent in
+	/// place go to completed, which receivePackets() passes to
+	/// the fill ring.
+	///
+	////////////////////////////////////////////////////////////
+	void reclaimCompleted();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Checks if a frame can be sent in place
+	///
+	/// \param frame Frame inside the receive half of the UMEM
+	///
+	/// \return bool true if it lies in the frame held by the
+	///              receive handler and not too many receive
+	///              frames are in flight
+	///
+	////////////////////////////////////////////////////////////
+	bool isHeld(const ConstByteSpan& frame) const;
+
+	bool forceGeneric;            ///< Skip native mode
+	bool nativeMode = false;      ///< Program attached in driver mode
+	bool zeroCopy = false;        ///< Socket bound with XDP_ZEROCOPY
+	int socketFd = -1;            ///< AF_XDP socket
+	int packetFd = -1;            ///< AF_PACKET socket for sendPacket() and ioctls
+	int mapFd = -1;               ///< XSKMAP holding socketFd at queue 0
+	int programFd = -1;           ///< Attached XDP program
+	int linkFd = -1;              ///< XDP link, detaches the program when closed
+	struct sockaddr_ll linkAddress; ///< Destination of sendPacket()
+
+	uint8_t* umem = nullptr;      ///< 2 * RingSize frames, receive frames first
+	Ring fillRing;                ///< Free receive frames given to the kernel
+	Ring completionRing;          ///< Transmitted frames returned by the kernel
+	Ring rxRing;                  ///< Received frames
+	Ring txRing;                  ///< Frames to transmit
+	std::vector<uint64_t> txFrames;  ///< Free transmit frames (UMEM offsets)
+	std::vector<uint64_t> recycled;  ///< Handled receive frames for the fill ring, allocated in open()
+	std::vector<uint64_t> completed; ///< Receive frames back from the completion ring, allocated in open()
+	uint32_t completedCount = 0;  ///< Entries of completed not yet in the fill ring
+	uint32_t inFlight = 0;        ///< Receive frames sent in place and not completed (receive thread)
+	std::atomic<uint64_t> received{0}; ///< Frames taken from the RX ring (receive thread)
+
+	uint64_t heldAddress = 0;     ///< UMEM offset of frame in the receive handler
+	size_t heldLength = 0;        ///< Its length, 0 outside the handler
+	bool heldSent = false;        ///< Whether the held frame went to the TX ring
+};
+
+#endif // __linux__
\ No newline at end of file
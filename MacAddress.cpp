@@ -0,0 +1,105 @@
+#include "MacAddress.hpp"
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<MacAddress>::value, "MacAddress must be trivially copyable");
+static_assert(sizeof(MacAddress) == MacAddress::Size, "MacAddress must take exactly 6 bytes");
+static_assert(MacAddress::Broadcast.isBroadcast() && MacAddress().isEmpty(), "constant addresses");
+
+namespace {
+
+////////////////////////////////////////////////////////////
+/// \brief Gets value of a hexadecimal digit
+///
+/// \return int Digit value or -1 if character is not a digit
+///
+////////////////////////////////////////////////////////////
+inline int hexValue(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+std::string MacAddress::toString() const {
+	// 17 characters - fits the SSO buffer, no allocation
+	char buffer[MaxStringLength];
+	return std::string(buffer, toChars(buffer));
+}
+
+////////////////////////////////////////////////////////////
+char* MacAddress::toChars(char* buffer) const {
+	static const char digits[] = "0123456789abcdef";
+	for (size_t i = 0; i < Size; ++i) {
+		if (i > 0) {
+			*buffer++ = ':';
+		}
+		*buffer++ = digits[bytes[i] >> 4];
+		*buffer++ = digits[bytes[i] & 0x0F];
+	}
+	return buffer;
+}
+
+////////////////////////////////////////////////////////////
+MacAddress MacAddress::fromString(std::string_view text) {
+	MacAddress result;
+	const char* end = text.data() + text.size();
+	if (parse(text.data(), end, result) != end) {
+		return MacAddress();
+	}
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+const char* MacAddress::parse(const char* first, const char* last, MacAddress& result) {
+	uint8_t parsed[Size];
+	const char* p = first;
+	char separator = 0;
+
+	for (size_t i = 0; i < Size; ++i) {
+		if (i > 0) {
+			// The first separator fixes the one expected for the rest
+			if (p == last || (*p != ':' && *p != '-') || (separator != 0 && *p != separator)) {
+				return nullptr;
+			}
+			separator = *p++;
+		}
+
+		if (last - p < 2) {
+			return nullptr;
+		}
+		int high = hexValue(p[0]);
+		int low = hexValue(p[1]);
+		if (high < 0 || low < 0) {
+			return nullptr;
+		}
+		parsed[i] = static_cast<uint8_t>((high << 4) | low);
+		p += 2;
+	}
+
+	result = MacAddress(parsed);
+	return p;
+}
+
+////////////////////////////////////////////////////////////
+std::ostream& operator<<(std::ostream& os, const MacAddress& mac) {
+	char buffer[MacAddress::MaxStringLength];
+	os.write(buffer, mac.toChars(buffer) - buffer);
+	return os;
+}
+
+////////////////////////////////////////////////////////////
+std::istream& operator>>(std::istream& is, MacAddress& mac) {
+	std::string text;
+	is >> text;
+	mac = MacAddress::fromString(text);
+	return is;
+}
\ No newline at end of file
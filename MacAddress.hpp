@@ -0,0 +1,232 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+
+////////////////////////////////////////////////////////////
+/// \brief Class representing Ethernet MAC address
+///
+/// Six bytes in transmission order, stored inline: the class
+/// is trivially copyable, never allocates and fits in a
+/// register. Equality compares a 4-byte and a 2-byte word
+/// without branches, so checking the addresses of a frame
+/// costs two loads and compares per address; ordering and
+/// hashing use the address as one 48-bit integer (std::hash
+/// is specialized).
+///
+/// The empty (all-zero) address stands for "unknown", e.g. a
+/// MAC address that could not be resolved.
+///
+/// Example:
+/// \code
+/// MacAddress mac = MacAddress::fromString("02:00:00:00:00:01");
+/// if (ConstEthernetView(frame).destination() == mac) {
+///     std::cout << mac << std::endl;
+/// }
+/// \endcode
+///
+/// The class name "MacAddress" comes from:
+/// - "Mac" - denotes Media Access Control
+/// - "Address" - denotes hardware address
+///
+/// \see IPAddress, EthernetView
+///
+////////////////////////////////////////////////////////////
+class MacAddress {
+public:
+	static constexpr size_t Size = 6;              ///< Bytes in an address
+	static constexpr size_t MaxStringLength = 17;  ///< Length of "ff:ff:ff:ff:ff:ff"
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// Creates empty address 00:00:00:00:00:00.
+	///
+	////////////////////////////////////////////////////////////
+	constexpr MacAddress() : bytes{} {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor from byte array
+	///
+	/// \param data 6 bytes in transmission order, e.g. straight
+	///             from a frame header
+	///
+	////////////////////////////////////////////////////////////
+	constexpr explicit MacAddress(const uint8_t data[6])
+		: bytes{data[0], data[1], data[2], data[3], data[4], data[5]} {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor from six bytes
+	///
+	////////////////////////////////////////////////////////////
+	constexpr MacAddress(uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t b5, uint8_t b6)
+		: bytes{b1, b2, b3, b4, b5, b6} {}
+
+	constexpr bool operator==(const MacAddress& other) const {
+		return ((head() ^ other.head()) | (tail() ^ other.tail())) == 0;
+	}
+	constexpr bool operator!=(const MacAddress& other) const { return !(*this == other); }
+	constexpr bool operator<(const MacAddress& other) const { return toUint64() < other.toUint64(); }
+
+	constexpr uint8_t operator[](size_t index) const { return bytes[index]; }
+	constexpr const uint8_t* data() const { return bytes; }
+	constexpr const uint8_t* begin() const { return bytes; }
+	constexpr const uint8_t* end() const { return bytes + Size; }
+	constexpr size_t size() const { return Size; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Checks if address is 00:00:00:00:00:00
+	///
+	////////////////////////////////////////////////////////////
+	constexpr bool isEmpty() const { return (head() | tail()) == 0; }
+
+	constexpr bool isBroadcast() const { return head() == 0xFFFFFFFF && tail() == 0xFFFF; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Checks the group bit (multicast and broadcast)
+	///
+	////////////////////////////////////////////////////////////
+	constexpr bool isMulticast() const { return (bytes[0] & 1) != 0; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Converts address to 48-bit integer
+	///
+	/// The first byte is the most significant, so integers
+	/// order like the textual form.
+	///
+	/// \see fromUint64()
+	///
+	////////////////////////////////////////////////////////////
+	constexpr uint64_t toUint64() const {
+		// Written as a 32-bit and a 16-bit word, which compilers turn into byte-swapped loads
+		uint32_t high = (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+		                (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3];
+		uint16_t low = static_cast<uint16_t>((bytes[4] << 8) | bytes[5]);
+		return (static_cast<uint64_t>(high) << 16) | low;
+	}
+
+	static constexpr MacAddress fromUint64(uint64_t value) {
+		return MacAddress(static_cast<uint8_t>(value >> 40), static_cast<uint8_t>(value >> 32),
+		                  static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16),
+		                  static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value));
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Copies address into a buffer, e.g. a frame header
+	///
+	////////////////////////////////////////////////////////////
+	constexpr void copyTo(uint8_t* destination) const {
+		for (size_t i = 0; i < Size; ++i) {
+			destination[i] = bytes[i];
+		}
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Converts address to string
+	///
+	/// \return std::string Address in "02:00:5e:10:00:01" format
+	///
+	/// \see fromString(), toChars()
+	///
+	////////////////////////////////////////////////////////////
+	std::string toString() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Formats address into character buffer
+	///
+	/// Writes lowercase hexadecimal bytes separated by colons,
+	/// without terminating null and without allocating. The
+	/// buffer must hold at least MaxStringLength characters.
+	///
+	/// \return char* Pointer one past the last written character
+	///
+	/// \see toString(), parse()
+	///
+	////////////////////////////////////////////////////////////
+	char* toChars(char* buffer) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Creates address from string
+	///
+	/// The whole string must be an address as accepted by
+	/// parse().
+	///
+	/// \return MacAddress Parsed address (empty if string is invalid)
+	///
+	/// \see toString(), parse()
+	///
+	////////////////////////////////////////////////////////////
+	static MacAddress fromString(std::string_view text);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Parses address from the start of a character range
+	///
+	/// Non-allocating parser in the spirit of std::from_chars:
+	/// accepts six pairs of hexadecimal digits (either case)
+	/// separated by ':' or '-', the same separator throughout.
+	///
+	/// \param first Beginning of the range
+	/// \param last End of the range
+	/// \param result Parsed address (written only on success)
+	///
+	/// \return const char* Pointer past the address or nullptr on error
+	///
+	/// \see fromString()
+	///
+	////////////////////////////////////////////////////////////
+	static const char* parse(const char* first, const char* last, MacAddress& result);
+
+	static const MacAddress Broadcast; ///< ff:ff:ff:ff:ff:ff - broadcast
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Gets first four and last two bytes as words
+	///
+	/// Packed little-endian, so on little-endian hosts both
+	/// compile to plain loads; only meaningful for equality.
+	///
+	////////////////////////////////////////////////////////////
+	constexpr uint32_t head() const {
+		return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+		       (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+	}
+	constexpr uint32_t tail() const { return static_cast<uint32_t>(bytes[4]) | (static_cast<uint32_t>(bytes[5]) << 8); }
+
+	uint8_t bytes[Size]; ///< Address in transmission order
+};
+
+inline constexpr MacAddress MacAddress::Broadcast(0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF);
+
+////////////////////////////////////////////////////////////
+/// \brief Hash of MacAddress for unordered containers
+///
+////////////////////////////////////////////////////////////
+namespace std {
+template <>
+struct hash<MacAddress> {
+	size_t operator()(const MacAddress& mac) const noexcept {
+		return hash<uint64_t>()(mac.toUint64());
+	}
+};
+} // namespace std
+
+////////////////////////////////////////////////////////////
+/// \brief Output operator for MacAddress
+///
+/// Displays address in "02:00:5e:10:00:01" format.
+///
+////////////////////////////////////////////////////////////
+std::ostream& operator<<(std::ostream& os, const MacAddress& mac);
+
+////////////////////////////////////////////////////////////
+/// \brief Input operator for MacAddress
+///
+/// Reads address in "02:00:5e:10:00:01" or "02-00-5E-10-00-01"
+/// format; an invalid address reads as empty.
+///
+////////////////////////////////////////////////////////////
+std::istream& operator>>(std::istream& is, MacAddress& mac);
\ No newline at end of file
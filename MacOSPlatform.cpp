@@ -6,7 +6,6 @@
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
-#include <sstream>
 #include <algorithm>
 #include <sys/socket.h>
 #include <net/if.h>
@@ -88,6 +87,11 @@ std::vector<NetworkInterface::InterfaceInfo> MacOSNetworkInterface::getInterface
 			
 			// Get netmask
 			info.prefixLength = getInterfaceNetmask(interfaceName);
+			info.index = sdl->sdl_index;
+			
+			if (!info.ip.empty()) {
+				info.addresses.push_back({info.ip, info.prefixLength});
+			}
 			
 			// Get gateway
 			info.gateway = getDefaultGateway(interfaceName);
@@ -100,8 +104,8 @@ std::vector<NetworkInterface::InterfaceInfo> MacOSNetworkInterface::getInterface
 	return interfaces;
 }
 
-std::vector<uint8_t> MacOSNetworkInterface::resolveMacAddress(const std::string& interfaceName, 
-                                                             const std::vector<uint8_t>& ip) {
+MacAddress MacOSNetworkInterface::resolveMacAddress(const std::string& interfaceName,
+                                                   const std::vector<uint8_t>& ip) {
 	if (ip.size() != 4) {
 		return {};
 	}
@@ -153,8 +157,7 @@ std::vector<uint8_t> MacOSNetworkInterface::resolveMacAddress(const std::string&
 					if (sa->sa_family == AF_LINK) {
 						struct sockaddr_dl *sdl = (struct sockaddr_dl *)sa;
 						if (sdl->sdl_alen == 6) {
-							std::vector<uint8_t> mac(6);
-							memcpy(mac.data(), LLADDR(sdl), 6);
+							MacAddress mac(reinterpret_cast<const uint8_t*>(LLADDR(sdl)));
 							free(buf);
 							return mac;
 						}
@@ -194,8 +197,7 @@ std::vector<uint8_t> MacOSNetworkInterface::resolveMacAddress(const std::string&
 									if (sa->sa_family == AF_LINK) {
 										struct sockaddr_dl *sdl = (struct sockaddr_dl *)sa;
 										if (sdl->sdl_alen == 6) {
-											std::vector<uint8_t> mac(6);
-											memcpy(mac.data(), LLADDR(sdl), 6);
+											MacAddress mac(reinterpret_cast<const uint8_t*>(LLADDR(sdl)));
 											free(buf);
 											return mac;
 										}
@@ -229,19 +231,7 @@ std::vector<uint8_t> MacOSNetworkInterface::resolveMacAddress(const std::string&
 			if (onPos != std::string::npos) {
 				std::string macStr = result.substr(atPos + 4, onPos - atPos - 4);
 				// Parse MAC address (format: xx:xx:xx:xx:xx:xx)
-				std::vector<uint8_t> mac;
-				std::istringstream macStream(macStr);
-				std::string byteStr;
-				
-				while (std::getline(macStream, byteStr, ':')) {
-					if (byteStr.length() == 2) {
-						mac.push_back(std::stoi(byteStr, nullptr, 16));
-					}
-				}
-				
-				if (mac.size() == 6) {
-					return mac;
-				}
+				return MacAddress::fromString(macStr);
 			}
 		}
 	}
@@ -268,7 +258,7 @@ int MacOSNetworkInterface::getInterfaceFlags(const std::string& interfaceName) {
 	return ifr.ifr_flags;
 }
 
-std::vector<uint8_t> MacOSNetworkInterface::getInterfaceMacAddress(const std::string& interfaceName) {
+MacAddress MacOSNetworkInterface::getInterfaceMacAddress(const std::string& interfaceName) {
 	// Use sysctl to get interface MAC address on macOS
 	int mib[6];
 	size_t len;
@@ -305,8 +295,7 @@ std::vector<uint8_t> MacOSNetworkInterface::getInterfaceMacAddress(const std::st
 			// Check if this is the interface we're looking for
 			std::string currentInterface(sdl->sdl_data, sdl->sdl_nlen);
 			if (currentInterface == interfaceName && sdl->sdl_alen == 6) {
-				std::vector<uint8_t> mac(6);
-				memcpy(mac.data(), LLADDR(sdl), 6);
+				MacAddress mac(reinterpret_cast<const uint8_t*>(LLADDR(sdl)));
 				free(buf);
 				return mac;
 			}
@@ -510,9 +499,24 @@ bool MacOSRawSocket::sendPacket(const std::vector<uint8_t>& data) {
 	return written == static_cast<ssize_t>(data.size());
 }
 
+size_t MacOSRawSocket::sendBatch(const ConstByteSpan* frames, size_t count) {
+	size_t sent = 0;
+	while (bpfFd >= 0 && sent < count &&
+	       write(bpfFd, frames[sent].data(), frames[sent].size()) == static_cast<ssize_t>(frames[sent].size())) {
+		++sent;
+	}
+	return sent;
+}
+
 std::vector<uint8_t> MacOSRawSocket::receivePacket() {
+	std::vector<uint8_t> packet(65536);
+	packet.resize(receiveInto(ByteSpan(packet)));
+	return packet;
+}
+
+size_t MacOSRawSocket::receiveInto(ByteSpan packet) {
 	if (bpfFd < 0) {
-		return {};
+		return 0;
 	}
 	
 	// BPF header structure
@@ -527,24 +531,38 @@ std::vector<uint8_t> MacOSRawSocket::receivePacket() {
 	ssize_t bytesRead = read(bpfFd, buffer, sizeof(buffer));
 	
 	if (bytesRead <= 0) {
-		return {};
+		return 0;
 	}
 	
 	// Parse BPF header
 	struct bpf_hdr* header = (struct bpf_hdr*)buffer;
 	if (bytesRead < static_cast<ssize_t>(header->bh_hdrlen + header->bh_caplen)) {
-		return {};
+		return 0;
 	}
 	
 	// Extract packet data (skip BPF header)
-	std::vector<uint8_t> packet(header->bh_caplen);
-	memcpy(packet.data(), buffer + header->bh_hdrlen, header->bh_caplen);
+	size_t length = header->bh_caplen < packet.size() ? header->bh_caplen : packet.size();
+	memcpy(packet.data(), buffer + header->bh_hdrlen, length);
 	
-	return packet;
+	return length;
 }
 
 bool MacOSRawSocket::isOpen() const {
 	return bpfFd >= 0;
 }
 
+bool MacOSRawSocket::attachFilter(const std::vector<BpfInstruction>& program) {
+	static_assert(sizeof(BpfInstruction) == sizeof(struct bpf_insn), "BpfInstruction must match bpf_insn");
+	
+	if (bpfFd < 0 || program.empty()) {
+		return false;
+	}
+	
+	struct bpf_program filter;
+	filter.bf_len = static_cast<u_int>(program.size());
+	filter.bf_insns = (struct bpf_insn*)program.data();
+	
+	return ioctl(bpfFd, BIOCSETF, &filter) == 0;
+}
+
 #endif // __APPLE__ 
\ No newline at end of file
@@ -78,13 +78,13 @@ public:
 	/// \param interfaceName Interface name to search on
 	/// \param ip IP address to resolve
 	///
-	/// \return std::vector<uint8_t> MAC address (6 bytes) or empty vector
+	/// \return MacAddress MAC address or empty address
 	///
 	/// \see NetworkInterface::resolveMacAddress()
 	///
 	////////////////////////////////////////////////////////////
-	std::vector<uint8_t> resolveMacAddress(const std::string& interfaceName, 
-	                                       const std::vector<uint8_t>& ip) override;
+	MacAddress resolveMacAddress(const std::string& interfaceName,
+	                             const std::vector<uint8_t>& ip) override;
 
 private:
 	////////////////////////////////////////////////////////////
@@ -106,10 +106,10 @@ private:
 	///
 	/// \param interfaceName Interface name
 	///
-	/// \return std::vector<uint8_t> MAC address
+	/// \return MacAddress MAC address (empty if none)
 	///
 	////////////////////////////////////////////////////////////
-	std::vector<uint8_t> getInterfaceMacAddress(const std::string& interfaceName);
+	MacAddress getInterfaceMacAddress(const std::string& interfaceName);
 
 	////////////////////////////////////////////////////////////
 	/// \brief Gets interface IP address
@@ -239,6 +239,28 @@ public:
 	////////////////////////////////////////////////////////////
 	std::vector<uint8_t> receivePacket() override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Receives packet into caller-provided buffer
+	///
+	/// macOS implementation; the BPF record is read into a
+	/// stack buffer and its frame copied out.
+	///
+	/// \see RawSocket::receiveInto()
+	///
+	////////////////////////////////////////////////////////////
+	size_t receiveInto(ByteSpan buffer) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends several frames
+	///
+	/// One write() per frame, straight from the caller's
+	/// memory without copying it into a vector.
+	///
+	/// \see RawSocket::sendBatch()
+	///
+	////////////////////////////////////////////////////////////
+	size_t sendBatch(const ConstByteSpan* frames, size_t count) override;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if socket is open
 	///
@@ -249,6 +271,20 @@ public:
 	////////////////////////////////////////////////////////////
 	bool isOpen() const override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Attaches classic BPF program
+	///
+	/// macOS implementation using BIOCSETF on the BPF device.
+	///
+	/// \param program Filter program
+	///
+	/// \return bool true if the filter is active
+	///
+	/// \see RawSocket::attachFilter()
+	///
+	////////////////////////////////////////////////////////////
+	bool attachFilter(const std::vector<BpfInstruction>& program) override;
+
 private:
 	int bpfFd;        ///< macOS BPF file descriptor
 	std::string interfaceName; ///< Interface name
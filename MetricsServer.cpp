@@ -0,0 +1,318 @@
+#include "MetricsServer.hpp"
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+#ifdef MSG_NOSIGNAL
+constexpr int SendFlags = MSG_NOSIGNAL; ///< A client that went away must not raise SIGPIPE
+#else
+constexpr int SendFlags = 0;
+#endif
+
+////////////////////////////////////////////////////////////
+void OpenMetricsWriter::family(const std::string& name, const char* type, const std::string& help, const char* unit) {
+	output += "# TYPE " + name + " " + type + "\n";
+	if (unit[0] != '\0') {
+		output += "# UNIT " + name + " " + unit + "\n";
+	}
+	output += "# HELP " + name + " " + help + "\n";
+}
+
+////////////////////////////////////////////////////////////
+void OpenMetricsWriter::sample(const std::string& name, uint64_t value, const std::string& labels) {
+	output += name;
+	if (!labels.empty()) {
+		output += "{" + labels + "}";
+	}
+	output += " " + std::to_string(value) + "\n";
+}
+
+////////////////////////////////////////////////////////////
+void OpenMetricsWriter::sample(const std::string& name, double value, const std::string& labels) {
+	char text[32];
+	std::snprintf(text, sizeof(text), "%.9g", value);
+	output += name;
+	if (!labels.empty()) {
+		output += "{" + labels + "}";
+	}
+	output += std::string(" ") + text + "\n";
+}
+
+////////////////////////////////////////////////////////////
+void OpenMetricsWriter::counter(const std::string& name, const std::string& help, uint64_t value, const char* unit) {
+	family(name, "counter", help, unit);
+	sample(name + "_total", value);
+}
+
+////////////////////////////////////////////////////////////
+void OpenMetricsWriter::gauge(const std::string& name, const std::string& help, uint64_t value) {
+	family(name, "gauge", help);
+	sample(name, value);
+}
+
+////////////////////////////////////////////////////////////
+void OpenMetricsWriter::histogram(const std::string& name, const std::string& help,
+                                  const LatencyHistogram::Distribution& histogram) {
+	family(name, "histogram", help, "seconds");
+	
+	// Bounds are the highest value of every group; the last group also holds
+	// everything longer, so it is reported only as +Inf
+	uint64_t cumulative = 0;
+	for (size_t i = 0; i + BucketsPerBound < LatencyHistogram::BucketCount; ++i) {
+		cumulative += i < histogram.counts.size() ? histogram.counts[i] : 0;
+		if ((i + 1) % BucketsPerBound != 0) {
+			continue;
+		}
+		char bound[32];
+		std::snprintf(bound, sizeof(bound), "%.9g", static_cast<double>(LatencyHistogram::highestValue(i)) * 1e-9);
+		sample(name + "_bucket", cumulative, std::string("le=\"") + bound + "\"");
+	}
+	sample(name + "_bucket", histogram.total, "le=\"+Inf\"");
+	sample(name + "_count", histogram.total);
+	sample(name + "_sum", static_cast<double>(histogram.sum) * 1e-9);
+}
+
+////////////////////////////////////////////////////////////
+MetricsServer::MetricsServer(Renderer renderer)
+	: renderer(std::move(renderer)) {
+}
+
+////////////////////////////////////////////////////////////
+MetricsServer::~MetricsServer() {
+	stop();
+}
+
+////////////////////////////////////////////////////////////
+void MetricsServer::addPage(const std::string& path, Renderer renderer) {
+	pages.emplace_back(path, std::move(renderer));
+}
+
+#ifdef _WIN32
+
+////////////////////////////////////////////////////////////
+bool MetricsServer::start(const std::string&) {
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+void MetricsServer::stop() {
+}
+
+////////////////////////////////////////////////////////////
+void MetricsServer::serve() {
+}
+
+////////////////////////////////////////////////////////////
+void MetricsServer::handleClient(int) {
+}
+
+#else
+
+////////////////////////////////////////////////////////////
+bool MetricsServer::start(const std::string& address) {
+	if (listenFd >= 0) {
+		return false;
+	}
+	
+	if (address.compare(0, 5, "unix:") == 0) {
+		struct sockaddr_un local;
+		std::memset(&local, 0, sizeof(local));
+		local.sun_family = AF_UNIX;
+		std::string path = address.substr(5);
+		if (path.empty() || path.size() >= sizeof(local.sun_path)) {
+			return false;
+		}
+		std::memcpy(local.sun_path, path.c_str(), path.size());
+		
+		listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listenFd < 0) {
+			return false;
+		}
+		// A socket left over by a previous run; anything else at the path makes bind() fail
+		struct stat existing;
+		if (lstat(path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+			unlink(path.c_str());
+		}
+		if (bind(listenFd, reinterpret_cast<struct sockaddr*>(&local), sizeof(local)) < 0) {
+			close(listenFd);
+			listenFd = -1;
+			return false;
+		}
+		unixPath = path;
+	} else {
+		// "port", ":port", "host:port" or "[v6]:port"
+		std::string host = "127.0.0.1";
+		std::string port = address;
+		size_t colon = address.rfind(':');
+		if (colon != std::string::npos) {
+			port = address.substr(colon + 1);
+			if (colon > 0) {
+				host = address.substr(0, colon);
+				if (host.size() > 2 && host.front() == '[' && host.back() == ']') {
+					host = host.substr(1, host.size() - 2);
+				}
+			}
+		}
+		
+		struct addrinfo hints;
+		std::memset(&hints, 0, sizeof(hints));
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = SOCK_STREAM;
+		hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+		struct addrinfo* result = nullptr;
+		if (port.empty() || getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0) {
+			return false;
+		}
+		
+		for (struct addrinfo* entry = result; entry && listenFd < 0; entry = entry->ai_next) {
+			listenFd = socket(entry->ai_family, entry->ai_socktype, entry->ai_protocol);
+			if (listenFd < 0) {
+				continue;
+			}
+			int reuse = 1;
+			setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+			if (bind(listenFd, entry->ai_addr, entry->ai_addrlen) < 0) {
+				close(listenFd);
+				listenFd = -1;
+			}
+		}
+		freeaddrinfo(result);
+		if (listenFd < 0) {
+			return false;
+		}
+	}
+	
+	if (listen(listenFd, 8) < 0 || pipe(stopPipe) < 0) {
+		stop();
+		return false;
+	}
+	fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL) | O_NONBLOCK);
+	
+	thread = std::thread(&MetricsServer::serve, this);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void MetricsServer::stop() {
+	if (thread.joinable()) {
+		char wake = 0;
+		ssize_t written = write(stopPipe[1], &wake, 1);
+		(void)written;
+		thread.join();
+	}
+	
+	for (int* fd : {&listenFd, &stopPipe[0], &stopPipe[1]}) {
+		if (*fd >= 0) {
+			close(*fd);
+			*fd = -1;
+		}
+	}
+	if (!unixPath.empty()) {
+		unlink(unixPath.c_str());
+		unixPath.clear();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void MetricsServer::serve() {
+	struct pollfd fds[2];
+	fds[0].fd = listenFd;
+	fds[0].events = POLLIN;
+	fds[1].fd = stopPipe[0];
+	fds[1].events = POLLIN;
+	
+	while (true) {
+		fds[0].revents = 0;
+		fds[1].revents = 0;
+		if (poll(fds, 2, -1) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return;
+		}
+		if (fds[1].revents != 0) {
+			return;
+		}
+		
+		int clientFd = accept(listenFd, nullptr, nullptr);
+		if (clientFd < 0) {
+			continue;
+		}
+		
+		// A stalled client must not block the thread indefinitely
+		struct timeval timeout;
+		timeout.tv_sec = ClientTimeoutMs / 1000;
+		timeout.tv_usec = (ClientTimeoutMs % 1000) * 1000;
+		setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		setsockopt(clientFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+		int noSigpipe = 1;
+		setsockopt(clientFd, SOL_SOCKET, SO_NOSIGPIPE, &noSigpipe, sizeof(noSigpipe));
+#endif
+		
+		handleClient(clientFd);
+		close(clientFd);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void MetricsServer::handleClient(int clientFd) {
+	// Read request head; the body of a GET is empty
+	std::string request;
+	char buffer[512];
+	while (request.find("\r\n\r\n") == std::string::npos && request.size() < MaxRequestSize) {
+		ssize_t count = recv(clientFd, buffer, sizeof(buffer), 0);
+		if (count <= 0) {
+			return;
+		}
+		request.append(buffer, static_cast<size_t>(count));
+	}
+	
+	std::string status = "200 OK";
+	std::string contentType = ContentType;
+	std::string body;
+	if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 6, "GET / ") == 0) {
+		body = renderer();
+	} else if (request.compare(0, 4, "GET ") == 0) {
+		status = "404 Not Found";
+		contentType = "text/plain; charset=utf-8";
+		body = "Not found, use /metrics\n";
+		for (const auto& page : pages) {
+			std::string line = "GET " + page.first + " ";
+			if (request.compare(0, line.size(), line) == 0) {
+				status = "200 OK";
+				body = page.second();
+				break;
+			}
+		}
+	} else {
+		status = "405 Method Not Allowed";
+		contentType = "text/plain; charset=utf-8";
+		body = "Only GET is supported\n";
+	}
+	
+	std::string response = "HTTP/1.1 " + status + "\r\n"
+	                       "Content-Type: " + contentType + "\r\n"
+	                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+	                       "Connection: close\r\n\r\n" + body;
+	size_t sent = 0;
+	while (sent < response.size()) {
+		ssize_t count = send(clientFd, response.data() + sent, response.size() - sent, SendFlags);
+		if (count <= 0) {
+			return;
+		}
+		sent += static_cast<size_t>(count);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "TrafficStatistics.hpp"
+#include <string>
+#include <thread>
+#include <functional>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////
+/// \brief Builder of OpenMetrics text exposition
+///
+/// Appends metric families in the OpenMetrics 1.0 text
+/// format; text() terminates the exposition with "# EOF".
+///
+/// Example:
+/// \code
+/// OpenMetricsWriter writer;
+/// writer.counter("arpspoof_arp_sent", "Spoofed ARP replies sent.", 12);
+/// std::string body = writer.text();
+/// \endcode
+///
+/// The class name "OpenMetricsWriter" comes from:
+/// - "OpenMetrics" - denotes the exposition format
+/// - "Writer" - denotes it produces text
+///
+/// \see MetricsServer
+///
+////////////////////////////////////////////////////////////
+class OpenMetricsWriter {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Writes metric family header
+	///
+	/// \param name Family name (without _total suffix)
+	/// \param type "counter", "gauge" or "histogram"
+	/// \param help Description
+	/// \param unit Unit suffix of the name, empty for none
+	///
+	////////////////////////////////////////////////////////////
+	void family(const std::string& name, const char* type, const std::string& help, const char* unit = "");
+
+	////////////////////////////////////////////////////////////
+	/// \brief Writes one sample line
+	///
+	/// \param name Sample name
+	/// \param value Sample value
+	/// \param labels Label set without braces, e.g. direction="x"
+	///
+	////////////////////////////////////////////////////////////
+	void sample(const std::string& name, uint64_t value, const std::string& labels = "");
+	void sample(const std::string& name, double value, const std::string& labels = "");
+
+	////////////////////////////////////////////////////////////
+	/// \brief Writes counter family with one sample
+	///
+	////////////////////////////////////////////////////////////
+	void counter(const std::string& name, const std::string& help, uint64_t value, const char* unit = "");
+
+	////////////////////////////////////////////////////////////
+	/// \brief Writes gauge family with one sample
+	///
+	////////////////////////////////////////////////////////////
+	void gauge(const std::string& name, const std::string& help, uint64_t value);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Writes duration histogram in seconds
+	///
+	/// Buckets are groups of BucketsPerBound adjacent
+	/// LatencyHistogram buckets, four per power of two, so the
+	/// bounds are the same on every scrape.
+	///
+	/// \param name Family name, should end with _seconds
+	/// \param help Description
+	/// \param histogram Distribution in nanoseconds
+	///
+	////////////////////////////////////////////////////////////
+	void histogram(const std::string& name, const std::string& help, const LatencyHistogram::Distribution& histogram);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets complete exposition
+	///
+	////////////////////////////////////////////////////////////
+	std::string text() const { return output + "# EOF\n"; }
+
+	static constexpr size_t BucketsPerBound = (static_cast<size_t>(1) << LatencyHistogram::SubBucketBits) / 4; ///< Histogram buckets per exported bucket
+
+private:
+	std::string output; ///< Text written so far
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Local HTTP endpoint serving live metrics
+///
+/// Answers "GET /metrics" with the text produced by the
+/// renderer, in OpenMetrics format, on its own thread. The
+/// renderer only reads counters, so serving a scrape adds no
+/// work to the forwarding threads.
+///
+/// The endpoint address is one of:
+/// - "port" or ":port" - TCP on 127.0.0.1,
+/// - "host:port" - TCP on given address ("[::1]:port" for IPv6),
+/// - "unix:/path" - HTTP over a Unix domain socket
+///   (e.g. curl --unix-socket /path http://localhost/metrics).
+///
+/// Further plain-text pages can be served next to /metrics,
+/// see addPage().
+///
+/// Not available on Windows; start() returns false there.
+///
+/// The class name "MetricsServer" comes from:
+/// - "Metrics" - denotes exported counters
+/// - "Server" - denotes listening endpoint
+///
+/// \see OpenMetricsWriter, App::renderMetrics()
+///
+////////////////////////////////////////////////////////////
+class MetricsServer {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Produces the exposition text
+	///
+	/// Runs on the server thread.
+	///
+	////////////////////////////////////////////////////////////
+	using Renderer = std::function<std::string()>;
+
+	static constexpr const char* ContentType = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param renderer Produces the metrics on each scrape
+	///
+	////////////////////////////////////////////////////////////
+	explicit MetricsServer(Renderer renderer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Stops the server.
+	///
+	////////////////////////////////////////////////////////////
+	~MetricsServer();
+
+	MetricsServer(const MetricsServer&) = delete;
+	MetricsServer& operator=(const MetricsServer&) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Serves a plain-text page on another path
+	///
+	/// Must be called before start().
+	///
+	/// \param path Request path, e.g. "/latency"
+	/// \param renderer Produces the page on each request
+	///
+	////////////////////////////////////////////////////////////
+	void addPage(const std::string& path, Renderer renderer);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Starts listening and serving
+	///
+	/// \param address Endpoint address (see class description)
+	///
+	/// \return bool false if the address is invalid, cannot be
+	///         bound or the platform is not supported
+	///
+	////////////////////////////////////////////////////////////
+	bool start(const std::string& address);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Stops serving and closes the endpoint
+	///
+	/// Removes the Unix socket file, if any.
+	///
+	////////////////////////////////////////////////////////////
+	void stop();
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Body of server thread
+	///
+	////////////////////////////////////////////////////////////
+	void serve();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Reads one request and sends the response
+	///
+	/// \param clientFd Accepted connection, closed by caller
+	///
+	////////////////////////////////////////////////////////////
+	void handleClient(int clientFd);
+
+	Renderer renderer;            ///< Metrics source
+	std::vector<std::pair<std::string, Renderer>> pages; ///< Plain-text pages by path
+	int listenFd = -1;            ///< Listening socket
+	int stopPipe[2] = {-1, -1};   ///< Written by stop() to wake the thread
+	std::string unixPath;         ///< Unix socket path, empty for TCP
+	std::thread thread;           ///< Server thread
+
+	static constexpr size_t MaxRequestSize = 4096;   ///< Longer requests are rejected
+	static constexpr int ClientTimeoutMs = 1000;     ///< Read/write timeout per connection
+};
\ No newline at end of file
@@ -1,92 +1,272 @@
 #pragma once
 
+#include "Span.hpp"
+#include "IPAddress.hpp"
+#include "MacAddress.hpp"
+#include <array>
 #include <cstdint>
+#include <cstddef>
+
+// Network constants
+const uint16_t ETHERTYPE_IP = 0x0800;   ///< Ethernet type for IP
+const uint16_t ETHERTYPE_ARP = 0x0806;  ///< Ethernet type for ARP
+
+const uint8_t IP_PROTO_ICMP = 1;        ///< IP protocol for ICMP
+const uint8_t IP_PROTO_TCP = 6;         ///< IP protocol for TCP
+const uint8_t IP_PROTO_UDP = 17;        ///< IP protocol for UDP
+
+const uint16_t ARP_OP_REQUEST = 1;      ///< ARP operation: request
+const uint16_t ARP_OP_REPLY = 2;        ///< ARP operation: reply
+
+const uint16_t HW_TYPE_ETHERNET = 1;    ///< Hardware type: Ethernet
 
 ////////////////////////////////////////////////////////////
-/// \brief Structure representing Ethernet frame header
+/// \brief Reads and writes fields in network byte order
 ///
-/// This structure defines the format of Ethernet frame header according
-/// to IEEE 802.3 standard. Contains source and destination MAC addresses
-/// and higher layer protocol type (EtherType).
+/// Work byte by byte, so any alignment is fine; compilers
+/// turn them into single (byte-swapped) loads and stores.
 ///
-/// The structure name "EthHeader" comes from:
-/// - "Eth" - abbreviation of "Ethernet"
-/// - "Header" - denotes frame header
+////////////////////////////////////////////////////////////
+constexpr uint16_t readBigEndian16(const uint8_t* data) {
+	return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+constexpr void writeBigEndian16(uint8_t* data, uint16_t value) {
+	data[0] = static_cast<uint8_t>(value >> 8);
+	data[1] = static_cast<uint8_t>(value);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief View of an Ethernet frame header
+///
+/// Header fields follow the IEEE 802.3 layout: destination and
+/// source MAC addresses and the EtherType of the payload.
+///
+/// A view is a pointer into a frame (ByteSpan or ConstByteSpan)
+/// and copies nothing. The constructor checks the length once;
+/// a view of a too short frame is invalid (false in a boolean
+/// context) and must not be used further. Accessors of a valid
+/// view then read fixed offsets without further checks. Fields
+/// are read and written byte-wise in network order, so views
+/// are well-defined at any alignment, unlike casting the buffer
+/// to a header struct.
 ///
-/// \see IpHeader, ArpHeader
+/// Example:
+/// \code
+/// ConstEthernetView eth(frame);
+/// if (eth && eth.etherType() == ETHERTYPE_IP) {
+///     ConstIpv4View ip(eth.payload());
+/// }
+/// \endcode
+///
+/// The class name "EthernetView" comes from:
+/// - "Ethernet" - denotes the link layer header
+/// - "View" - denotes non-owning access to a buffer
+///
+/// \see Ipv4View, ArpView
 ///
 ////////////////////////////////////////////////////////////
-struct EthernetHeader {
-	uint8_t dest[6];    ///< Destination MAC address (6 bytes)
-	uint8_t src[6];     ///< Source MAC address (6 bytes)
-	uint16_t type;       ///< Protocol type (0x0800 for IP, 0x0806 for ARP)
+template <typename Byte>
+class BasicEthernetView {
+public:
+	static constexpr size_t Size = 14; ///< Header length
+
+	constexpr BasicEthernetView() = default;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor from frame
+	///
+	/// \param frame Frame starting with the Ethernet header
+	///
+	////////////////////////////////////////////////////////////
+	constexpr explicit BasicEthernetView(Span<Byte> frame)
+		: bytes(frame.size() >= Size ? frame.data() : nullptr), length(frame.size()) {}
+
+	constexpr bool isValid() const { return bytes != nullptr; }
+	constexpr explicit operator bool() const { return isValid(); }
+
+	constexpr MacAddress destination() const { return MacAddress(bytes); }
+	constexpr MacAddress source() const { return MacAddress(bytes + 6); }
+	constexpr uint16_t etherType() const { return readBigEndian16(bytes + 12); }
+
+	constexpr void setDestination(const MacAddress& mac) const { mac.copyTo(bytes); }
+	constexpr void setSource(const MacAddress& mac) const { mac.copyTo(bytes + 6); }
+	constexpr void setEtherType(uint16_t type) const { writeBigEndian16(bytes + 12, type); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets data behind the header
+	///
+	////////////////////////////////////////////////////////////
+	constexpr Span<Byte> payload() const { return Span<Byte>(bytes + Size, length - Size); }
+
+private:
+	Byte* bytes = nullptr; ///< Start of the header, nullptr if invalid
+	size_t length = 0;     ///< Frame length
 };
 
 ////////////////////////////////////////////////////////////
-/// \brief Structure representing IP packet header
+/// \brief View of an IPv4 packet header
 ///
-/// This structure defines the format of IPv4 packet header according
-/// to RFC 791. Contains information about IP version, header length,
-/// type of service, packet length, fragmentation identifier,
-/// flags, TTL, higher layer protocol, checksum,
-/// and source and destination IP addresses.
+/// Header fields as defined by RFC 791. Valid if the packet
+/// holds at least MinSize bytes; version and header length are
+/// reported as found, not checked. Same rules as for
+/// BasicEthernetView apply.
 ///
-/// The structure name "IpHeader" comes from:
-/// - "Ip" - denotes Internet Protocol
-/// - "Header" - denotes packet header
+/// The class name "Ipv4View" comes from:
+/// - "Ipv4" - denotes Internet Protocol version 4
+/// - "View" - denotes non-owning access to a buffer
 ///
-/// \see EthHeader, ArpHeader
+/// \see EthernetView
 ///
 ////////////////////////////////////////////////////////////
-struct IpHeader {
-	uint8_t version_ihl;    ///< Version (4 bits) + Header length (4 bits)
-	uint8_t tos;            ///< Type of service
-	uint16_t total_length;  ///< Total packet length
-	uint16_t id;            ///< Identification
-	uint16_t flags_offset;  ///< Flags (3 bits) + Fragment offset (13 bits)
-	uint8_t ttl;            ///< Time to live
-	uint8_t protocol;       ///< Higher layer protocol
-	uint16_t checksum;      ///< Header checksum
-	uint32_t src;           ///< Source IP address
-	uint32_t dest;          ///< Destination IP address
+template <typename Byte>
+class BasicIpv4View {
+public:
+	static constexpr size_t MinSize = 20; ///< Header length without options
+
+	constexpr BasicIpv4View() = default;
+	constexpr explicit BasicIpv4View(Span<Byte> packet)
+		: bytes(packet.size() >= MinSize ? packet.data() : nullptr) {}
+
+	constexpr bool isValid() const { return bytes != nullptr; }
+	constexpr explicit operator bool() const { return isValid(); }
+
+	constexpr uint8_t version() const { return bytes[0] >> 4; }
+	constexpr size_t headerLength() const { return static_cast<size_t>(bytes[0] & 0x0F) * 4; }
+	constexpr uint16_t totalLength() const { return readBigEndian16(bytes + 2); }
+	constexpr uint8_t ttl() const { return bytes[8]; }
+	constexpr uint8_t protocol() const { return bytes[9]; }
+	constexpr uint16_t checksum() const { return readBigEndian16(bytes + 10); }
+	constexpr IPAddress source() const { return IPAddress(bytes + 12); }
+	constexpr IPAddress destination() const { return IPAddress(bytes + 16); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sets version 4 and header length
+	///
+	/// \param size Header length in bytes, multiple of 4
+	///
+	////////////////////////////////////////////////////////////
+	constexpr void setHeaderLength(size_t size) const { bytes[0] = static_cast<uint8_t>(0x40 | (size / 4)); }
+	constexpr void setTotalLength(uint16_t size) const { writeBigEndian16(bytes + 2, size); }
+	constexpr void setTtl(uint8_t value) const { bytes[8] = value; }
+	constexpr void setProtocol(uint8_t value) const { bytes[9] = value; }
+	constexpr void setChecksum(uint16_t value) const { writeBigEndian16(bytes + 10, value); }
+	constexpr void setSource(const IPAddress& ip) const { writeAddress(bytes + 12, ip); }
+	constexpr void setDestination(const IPAddress& ip) const { writeAddress(bytes + 16, ip); }
+
+private:
+	static constexpr void writeAddress(uint8_t* data, const IPAddress& ip) {
+		for (size_t i = 0; i < 4; ++i) {
+			data[i] = ip[i];
+		}
+	}
+
+	Byte* bytes = nullptr; ///< Start of the header, nullptr if invalid
 };
 
 ////////////////////////////////////////////////////////////
-/// \brief Structure representing ARP packet header
+/// \brief View of an ARP packet for IPv4 over Ethernet
 ///
-/// This structure defines the format of ARP (Address Resolution Protocol)
-/// packet header according to RFC 826. Contains hardware type,
-/// protocol type, hardware and protocol address sizes,
-/// operation code, and source/target MAC and IP addresses.
+/// Fields as defined by RFC 826, with 6-byte hardware and
+/// 4-byte protocol addresses. Same rules as for
+/// BasicEthernetView apply.
 ///
-/// The structure name "ArpHeader" comes from:
+/// The class name "ArpView" comes from:
 /// - "Arp" - denotes Address Resolution Protocol
-/// - "Header" - denotes packet header
+/// - "View" - denotes non-owning access to a buffer
 ///
-/// \see EthHeader, IpHeader
+/// \see EthernetView, makeArpFrame()
 ///
 ////////////////////////////////////////////////////////////
-struct ArpHeader {
-	uint16_t hardware_type;       ///< Hardware type (1 for Ethernet)
-	uint16_t protocol_type;       ///< Protocol type (0x0800 for IP)
-	uint8_t hardware_size;        ///< Hardware address size (6 for MAC)
-	uint8_t protocol_size;        ///< Protocol address size (4 for IP)
-	uint16_t opcode;               ///< Operation code (1=request, 2=reply)
-	uint8_t sender_mac[6];         ///< Sender MAC address
-	uint8_t sender_ip[4];          ///< Sender IP address
-	uint8_t target_mac[6];         ///< Target MAC address
-	uint8_t target_ip[4];          ///< Target IP address
+template <typename Byte>
+class BasicArpView {
+public:
+	static constexpr size_t Size = 28; ///< Packet length
+
+	constexpr BasicArpView() = default;
+	constexpr explicit BasicArpView(Span<Byte> packet)
+		: bytes(packet.size() >= Size ? packet.data() : nullptr) {}
+
+	constexpr bool isValid() const { return bytes != nullptr; }
+	constexpr explicit operator bool() const { return isValid(); }
+
+	constexpr uint16_t hardwareType() const { return readBigEndian16(bytes); }
+	constexpr uint16_t protocolType() const { return readBigEndian16(bytes + 2); }
+	constexpr uint8_t hardwareSize() const { return bytes[4]; }
+	constexpr uint8_t protocolSize() const { return bytes[5]; }
+	constexpr uint16_t operation() const { return readBigEndian16(bytes + 6); }
+	constexpr MacAddress senderMac() const { return MacAddress(bytes + 8); }
+	constexpr IPAddress senderIp() const { return IPAddress(bytes + 14); }
+	constexpr MacAddress targetMac() const { return MacAddress(bytes + 18); }
+	constexpr IPAddress targetIp() const { return IPAddress(bytes + 24); }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sets hardware and protocol fields for IPv4 over
+	///        Ethernet
+	///
+	////////////////////////////////////////////////////////////
+	constexpr void setEthernetIpv4() const {
+		writeBigEndian16(bytes, HW_TYPE_ETHERNET);
+		writeBigEndian16(bytes + 2, ETHERTYPE_IP);
+		bytes[4] = 6;
+		bytes[5] = 4;
+	}
+
+	constexpr void setOperation(uint16_t value) const { writeBigEndian16(bytes + 6, value); }
+	constexpr void setSenderMac(const MacAddress& mac) const { mac.copyTo(bytes + 8); }
+	constexpr void setSenderIp(const IPAddress& ip) const { writeAddress(bytes + 14, ip); }
+	constexpr void setTargetMac(const MacAddress& mac) const { mac.copyTo(bytes + 18); }
+	constexpr void setTargetIp(const IPAddress& ip) const { writeAddress(bytes + 24, ip); }
+
+private:
+	static constexpr void writeAddress(uint8_t* data, const IPAddress& ip) {
+		for (size_t i = 0; i < 4; ++i) {
+			data[i] = ip[i];
+		}
+	}
+
+	Byte* bytes = nullptr; ///< Start of the packet, nullptr if invalid
 };
 
-// Network constants
-const uint16_t ETHERTYPE_IP = 0x0800;   ///< Ethernet type for IP
-const uint16_t ETHERTYPE_ARP = 0x0806;  ///< Ethernet type for ARP
+using EthernetView = BasicEthernetView<uint8_t>;             ///< Mutable Ethernet header
+using ConstEthernetView = BasicEthernetView<const uint8_t>;  ///< Read-only Ethernet header
+using Ipv4View = BasicIpv4View<uint8_t>;                     ///< Mutable IPv4 header
+using ConstIpv4View = BasicIpv4View<const uint8_t>;          ///< Read-only IPv4 header
+using ArpView = BasicArpView<uint8_t>;                       ///< Mutable ARP packet
+using ConstArpView = BasicArpView<const uint8_t>;            ///< Read-only ARP packet
 
-const uint8_t IP_PROTO_ICMP = 1;        ///< IP protocol for ICMP
-const uint8_t IP_PROTO_TCP = 6;         ///< IP protocol for TCP
-const uint8_t IP_PROTO_UDP = 17;        ///< IP protocol for UDP
+using ArpFrame = std::array<uint8_t, EthernetView::Size + ArpView::Size>; ///< Ethernet frame with ARP packet, without padding
 
-const uint16_t ARP_OP_REQUEST = 1;      ///< ARP operation: request
-const uint16_t ARP_OP_REPLY = 2;        ///< ARP operation: reply
+////////////////////////////////////////////////////////////
+/// \brief Builds an ARP frame
+///
+/// Usable in constant expressions, so fixed frames can be built
+/// at compile time.
+///
+/// \param operation ARP_OP_REQUEST or ARP_OP_REPLY
+/// \param destination Ethernet destination (MacAddress::Broadcast for requests)
+/// \param senderMac Ethernet source and ARP sender hardware address
+/// \param senderIp ARP sender protocol address
+/// \param targetMac ARP target hardware address (empty for requests)
+/// \param targetIp ARP target protocol address
+///
+/// \return ArpFrame Frame ready to send
+///
+////////////////////////////////////////////////////////////
+constexpr ArpFrame makeArpFrame(uint16_t operation, const MacAddress& destination, const MacAddress& senderMac,
+                                const IPAddress& senderIp, const MacAddress& targetMac, const IPAddress& targetIp) {
+	ArpFrame frame{};
+	EthernetView eth(ByteSpan(frame.data(), frame.size()));
+	eth.setDestination(destination);
+	eth.setSource(senderMac);
+	eth.setEtherType(ETHERTYPE_ARP);
 
-const uint16_t HW_TYPE_ETHERNET = 1;    ///< Hardware type: Ethernet 
\ No newline at end of file
+	ArpView arp(eth.payload());
+	arp.setEthernetIpv4();
+	arp.setOperation(operation);
+	arp.setSenderMac(senderMac);
+	arp.setSenderIp(senderIp);
+	arp.setTargetMac(targetMac);
+	arp.setTargetIp(targetIp);
+	return frame;
+}
\ No newline at end of file
@@ -0,0 +1,304 @@
+#include "PcapFile.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr uint32_t PcapMagic = 0xA1B2C3D4;             ///< Microsecond timestamps
+constexpr uint32_t PcapMagicNanoseconds = 0xA1B23C4D;  ///< Nanosecond timestamps
+constexpr uint32_t LinkTypeEthernet = 1;               ///< DLT_EN10MB
+constexpr size_t PcapHeaderSize = 24;
+constexpr size_t PcapRecordSize = 16;
+
+// pcapng blocks and options
+constexpr uint32_t SectionHeaderBlock = 0x0A0D0D0A;
+constexpr uint32_t InterfaceDescriptionBlock = 1;
+constexpr uint32_t SimplePacketBlock = 3;
+constexpr uint32_t EnhancedPacketBlock = 6;
+constexpr uint32_t ByteOrderMagic = 0x1A2B3C4D;
+constexpr uint16_t OptionTimestampResolution = 9;
+
+uint16_t swap16(uint16_t value) {
+	return static_cast<uint16_t>((value >> 8) | (value << 8));
+}
+
+uint32_t swap32(uint32_t value) {
+	return ((value >> 24) & 0xFF) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+}
+
+size_t padded(size_t size) {
+	return (size + 3) & ~static_cast<size_t>(3);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+PcapFile::~PcapFile() {
+	close();
+}
+
+////////////////////////////////////////////////////////////
+bool PcapFile::open(const std::string& path) {
+	close();
+
+#ifndef _WIN32
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat status;
+	if (fstat(fd, &status) == 0 && status.st_size > 0) {
+		void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping != MAP_FAILED) {
+			madvise(mapping, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+			data = static_cast<const uint8_t*>(mapping);
+			size = static_cast<size_t>(status.st_size);
+			mapped = true;
+		}
+	}
+	::close(fd);
+#else
+	std::ifstream file(path, std::ios::binary);
+	contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	if (!contents.empty()) {
+		data = contents.data();
+		size = contents.size();
+	}
+#endif
+	if (!data || size < PcapHeaderSize) {
+		close();
+		return false;
+	}
+
+	// Classic pcap has a file header; pcapng starts with a section header block read by next()
+	uint32_t magic;
+	std::memcpy(&magic, data, 4);
+	if (magic == SectionHeaderBlock) {
+		pcapng = true;
+	} else {
+		swapped = magic == swap32(PcapMagic) || magic == swap32(PcapMagicNanoseconds);
+		if (swapped) {
+			magic = swap32(magic);
+		}
+		if (magic != PcapMagic && magic != PcapMagicNanoseconds) {
+			close();
+			return false;
+		}
+		unitsPerSecond = magic == PcapMagic ? 1000000 : 1000000000;
+		ethernet = (read32(20) & 0xFFFF) == LinkTypeEthernet;
+	}
+
+	// One pass checks the structure, so next() never meets a malformed record later
+	rewind();
+	int result;
+	Frame frame;
+	while ((result = pcapng ? nextPcapng(frame) : nextPcap(frame)) == 1) {
+		frameCount++;
+	}
+	if (result < 0) {
+		close();
+		return false;
+	}
+	rewind();
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void PcapFile::close() {
+#ifndef _WIN32
+	if (mapped) {
+		munmap(const_cast<uint8_t*>(data), size);
+	}
+#endif
+	data = nullptr;
+	size = 0;
+	mapped = false;
+	contents.clear();
+	pcapng = false;
+	swapped = false;
+	ethernet = false;
+	interfaces.clear();
+	offset = 0;
+	frameCount = 0;
+}
+
+////////////////////////////////////////////////////////////
+bool PcapFile::next(Frame& frame) {
+	if (!data) {
+		return false;
+	}
+	return (pcapng ? nextPcapng(frame) : nextPcap(frame)) == 1;
+}
+
+////////////////////////////////////////////////////////////
+void PcapFile::rewind() {
+	offset = pcapng ? 0 : PcapHeaderSize;
+	interfaces.clear();
+}
+
+////////////////////////////////////////////////////////////
+uint16_t PcapFile::read16(size_t position) const {
+	uint16_t value;
+	std::memcpy(&value, data + position, 2);
+	return swapped ? swap16(value) : value;
+}
+
+////////////////////////////////////////////////////////////
+uint32_t PcapFile::read32(size_t position) const {
+	uint32_t value;
+	std::memcpy(&value, data + position, 4);
+	return swapped ? swap32(value) : value;
+}
+
+////////////////////////////////////////////////////////////
+int PcapFile::nextPcap(Frame& frame) {
+	while (offset + PcapRecordSize <= size) {
+		uint64_t seconds = read32(offset);
+		uint64_t fraction = read32(offset + 4);
+		uint32_t length = read32(offset + 8);
+		uint32_t originalLength = read32(offset + 12);
+		size_t start = offset + PcapRecordSize;
+		if (length > size - start) {
+			return -1; // Truncated record
+		}
+		offset = start + length;
+		if (!ethernet) {
+			continue;
+		}
+
+		frame.data = ConstByteSpan(data + start, length);
+		frame.timestamp = seconds * 1000000000ull + toNanoseconds(fraction, unitsPerSecond);
+		frame.originalLength = originalLength;
+		return 1;
+	}
+	return offset == size ? 0 : -1;
+}
+
+////////////////////////////////////////////////////////////
+int PcapFile::nextPcapng(Frame& frame) {
+	while (offset + 12 <= size) {
+		// The section header's byte order magic decides how the rest of the section is read
+		uint32_t type;
+		std::memcpy(&type, data + offset, 4);
+		if (type == SectionHeaderBlock) {
+			uint32_t magic;
+			std::memcpy(&magic, data + offset + 8, 4);
+			if (magic != ByteOrderMagic && magic != swap32(ByteOrderMagic)) {
+				return -1;
+			}
+			swapped = magic != ByteOrderMagic;
+			interfaces.clear();
+		} else {
+			type = read32(offset);
+		}
+
+		uint32_t length = read32(offset + 4);
+		if (length < 12 || length % 4 != 0 || length > size - offset || read32(offset + length - 4) != length) {
+			return -1;
+		}
+		size_t block = offset;
+		size_t end = offset + length - 4;
+		offset += length;
+
+		if (type == InterfaceDescriptionBlock) {
+			if (length < 20) {
+				return -1;
+			}
+			Interface interface;
+			interface.ethernet = read16(block + 8) == LinkTypeEthernet;
+			interface.snapLength = read32(block + 12);
+			if (!readInterfaceOptions(block + 16, end, interface)) {
+				return -1;
+			}
+			interfaces.push_back(interface);
+		} else if (type == EnhancedPacketBlock) {
+			if (length < 32) {
+				return -1;
+			}
+			uint32_t id = read32(block + 8);
+			uint32_t captured = read32(block + 20);
+			if (id >= interfaces.size() || padded(captured) > end - (block + 28)) {
+				return -1;
+			}
+			if (!interfaces[id].ethernet) {
+				continue;
+			}
+			uint64_t units = (static_cast<uint64_t>(read32(block + 12)) << 32) | read32(block + 16);
+			frame.data = ConstByteSpan(data + block + 28, captured);
+			frame.timestamp = toNanoseconds(units, interfaces[id].unitsPerSecond);
+			frame.originalLength = read32(block + 24);
+			return 1;
+		} else if (type == SimplePacketBlock) {
+			// Belongs to the first interface; holds the frame up to the snap length, without timestamp
+			if (length < 16 || interfaces.empty()) {
+				return -1;
+			}
+			if (!interfaces[0].ethernet) {
+				continue;
+			}
+			uint32_t originalLength = read32(block + 8);
+			size_t captured = end - (block + 12);
+			if (originalLength < captured) {
+				captured = originalLength;
+			}
+			if (interfaces[0].snapLength != 0 && interfaces[0].snapLength < captured) {
+				captured = interfaces[0].snapLength;
+			}
+			frame.data = ConstByteSpan(data + block + 12, captured);
+			frame.timestamp = 0;
+			frame.originalLength = originalLength;
+			return 1;
+		}
+		// Other blocks (statistics, name resolution, custom) carry no frames
+	}
+	return offset == size ? 0 : -1;
+}
+
+////////////////////////////////////////////////////////////
+bool PcapFile::readInterfaceOptions(size_t position, size_t end, Interface& interface) const {
+	while (position + 4 <= end) {
+		uint16_t code = read16(position);
+		uint16_t length = read16(position + 2);
+		position += 4;
+		if (code == 0) {
+			return true; // opt_endofopt
+		}
+		if (padded(length) > end - position) {
+			return false;
+		}
+		if (code == OptionTimestampResolution && length >= 1) {
+			// Bit 7 selects a power of two, otherwise a power of ten
+			uint8_t resolution = data[position];
+			uint8_t exponent = resolution & 0x7F;
+			if (exponent > 63 || ((resolution & 0x80) == 0 && exponent > 19)) {
+				return false;
+			}
+			uint64_t units = 1;
+			for (uint8_t i = 0; i < exponent; ++i) {
+				units *= (resolution & 0x80) ? 2 : 10;
+			}
+			interface.unitsPerSecond = units;
+		}
+		position += padded(length);
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+uint64_t PcapFile::toNanoseconds(uint64_t value, uint64_t unitsPerSecond) {
+	if (unitsPerSecond == 1000000000) {
+		return value;
+	}
+	uint64_t seconds = value / unitsPerSecond;
+	uint64_t fraction = value % unitsPerSecond;
+	return seconds * 1000000000ull +
+	       static_cast<uint64_t>(static_cast<long double>(fraction) * 1e9L / static_cast<long double>(unitsPerSecond));
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "PlatformAbstraction.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+////////////////////////////////////////////////////////////
+/// \brief Memory-mapped reader of capture files
+///
+/// Reads classic pcap (microsecond or nanosecond timestamps,
+/// either byte order) and pcapng (Enhanced and Simple Packet
+/// Blocks, any if_tsresol, several sections) files with
+/// Ethernet frames, e.g. the files written by CaptureWriter.
+/// Frames of other link types are skipped.
+///
+/// The file is mapped into memory (read whole on Windows) and
+/// next() returns views into the mapping, so iterating a file
+/// neither copies nor allocates. open() walks the whole file
+/// once, so a truncated or malformed file is rejected up front.
+///
+/// Example:
+/// \code
+/// PcapFile file;
+/// if (file.open("capture.pcapng")) {
+///     PcapFile::Frame frame;
+///     while (file.next(frame)) {
+///         handle(frame.data, frame.timestamp);
+///     }
+/// }
+/// \endcode
+///
+/// The class name "PcapFile" comes from:
+/// - "Pcap" - denotes the capture file formats
+/// - "File" - denotes a file on disk
+///
+/// \see CaptureWriter, InMemoryRawSocket::replayPcap()
+///
+////////////////////////////////////////////////////////////
+class PcapFile {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief One captured frame
+	///
+	////////////////////////////////////////////////////////////
+	struct Frame {
+		ConstByteSpan data;           ///< Captured bytes, valid until close()
+		uint64_t timestamp = 0;       ///< Capture time in nanoseconds since the Unix epoch (0 if not recorded)
+		uint32_t originalLength = 0;  ///< Length on the wire
+	};
+
+	PcapFile() = default;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Unmaps the file.
+	///
+	////////////////////////////////////////////////////////////
+	~PcapFile();
+
+	PcapFile(const PcapFile&) = delete;
+	PcapFile& operator=(const PcapFile&) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Maps and checks a capture file
+	///
+	/// \return bool false if the file cannot be read or is not a
+	///         well-formed pcap or pcapng file
+	///
+	////////////////////////////////////////////////////////////
+	bool open(const std::string& path);
+
+	void close();
+	bool isOpen() const { return data != nullptr; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets number of Ethernet frames in the file
+	///
+	////////////////////////////////////////////////////////////
+	size_t getFrameCount() const { return frameCount; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Reads the next Ethernet frame
+	///
+	/// \return bool false at the end of the file
+	///
+	////////////////////////////////////////////////////////////
+	bool next(Frame& frame);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Starts reading from the first frame again
+	///
+	////////////////////////////////////////////////////////////
+	void rewind();
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Interface of the current pcapng section
+	///
+	////////////////////////////////////////////////////////////
+	struct Interface {
+		bool ethernet = false;           ///< Link type is Ethernet
+		uint32_t snapLength = 0;         ///< Longest captured frame, 0 - unlimited
+		uint64_t unitsPerSecond = 1000000; ///< Timestamp resolution (if_tsresol)
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Reads values in the byte order of the file
+	///
+	////////////////////////////////////////////////////////////
+	uint16_t read16(size_t position) const;
+	uint32_t read32(size_t position) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Parses the next record or block
+	///
+	/// \return int 1 - frame read, 0 - end of file,
+	///         -1 - malformed file
+	///
+	////////////////////////////////////////////////////////////
+	int nextPcap(Frame& frame);
+	int nextPcapng(Frame& frame);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Reads options of an interface description block
+	///
+	/// \return bool false if the options are malformed
+	///
+	////////////////////////////////////////////////////////////
+	bool readInterfaceOptions(size_t position, size_t end, Interface& interface) const;
+
+	static uint64_t toNanoseconds(uint64_t value, uint64_t unitsPerSecond);
+
+	const uint8_t* data = nullptr;     ///< File contents
+	size_t size = 0;                   ///< File size
+	bool mapped = false;               ///< data is a memory mapping
+	std::vector<uint8_t> contents;     ///< File contents when not mapped
+	bool pcapng = false;               ///< Format of the file
+	bool swapped = false;              ///< Byte order differs from the host
+	bool ethernet = false;             ///< Link type of a classic pcap file
+	uint64_t unitsPerSecond = 1000000; ///< Timestamp resolution of a classic pcap file
+	std::vector<Interface> interfaces; ///< Interfaces of the current pcapng section
+	size_t offset = 0;                 ///< Position of the next record or block
+	size_t frameCount = 0;             ///< Ethernet frames in the file
+};
\ No newline at end of file
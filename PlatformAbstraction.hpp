@@ -4,6 +4,12 @@
 #include <vector>
 #include <cstdint>
 #include <memory>
+#include <functional>
+#include <algorithm>
+#include "Span.hpp"
+#include "FramePool.hpp"
+#include "BpfFilter.hpp"
+#include "MacAddress.hpp"
 
 ////////////////////////////////////////////////////////////
 /// \brief Abstraction for network operations on different platforms
@@ -33,13 +39,40 @@ public:
 	///
 	////////////////////////////////////////////////////////////
 	struct InterfaceInfo {
+		////////////////////////////////////////////////////////////
+		/// \brief Single IPv4 address assigned to interface
+		///
+		////////////////////////////////////////////////////////////
+		struct AddressInfo {
+			std::vector<uint8_t> ip;    ///< IP address (4 bytes)
+			uint8_t prefixLength;       ///< Network prefix length
+		};
+
 		std::string name;           ///< Interface name
 		std::string description;    ///< Interface description
-		std::vector<uint8_t> mac;   ///< MAC address (6 bytes)
+		MacAddress mac;             ///< MAC address (empty if none)
 		std::vector<uint8_t> ip;    ///< IP address (4 bytes)
 		uint8_t prefixLength;       ///< Network prefix length
 		std::vector<uint8_t> gateway; ///< Default gateway address
 		bool isUp;                  ///< Whether interface is active
+		std::vector<AddressInfo> addresses; ///< All IPv4 addresses (first one is also in ip/prefixLength)
+		unsigned int index = 0;     ///< Kernel interface index (0 if unknown)
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Timing of active MAC address resolution
+	///
+	/// A request is sent for every unresolved address, then
+	/// the resolver waits timeoutMs for replies. Each further
+	/// attempt multiplies the wait by backoffFactor.
+	///
+	/// \see resolveMacAddresses()
+	///
+	////////////////////////////////////////////////////////////
+	struct ResolverConfig {
+		unsigned int timeoutMs = 200;     ///< Wait after the first request (milliseconds)
+		unsigned int maxAttempts = 4;     ///< Requests sent per address
+		unsigned int backoffFactor = 2;   ///< Wait multiplier after unanswered attempt
 	};
 
 	////////////////////////////////////////////////////////////
@@ -72,11 +105,57 @@ public:
 	/// \param interfaceName Interface name to search on
 	/// \param ip IP address to resolve
 	///
-	/// \return std::vector<uint8_t> MAC address (6 bytes) or empty vector if not found
+	/// \return MacAddress MAC address or empty address if not found
+	///
+	////////////////////////////////////////////////////////////
+	virtual MacAddress resolveMacAddress(const std::string& interfaceName,
+	                                     const std::vector<uint8_t>& ip) = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Resolves several IP addresses to MAC addresses
+	///
+	/// Platforms that can send their own requests resolve all
+	/// addresses concurrently, so the total time is bounded by
+	/// the slowest single exchange. The default implementation
+	/// calls resolveMacAddress() for each address in turn.
+	///
+	/// \param interfaceName Interface name to search on
+	/// \param ips IP addresses to resolve (4 bytes each)
+	/// \param config Timeout and retry settings
+	///
+	/// \return std::vector<MacAddress> MAC address for each IP, empty if not resolved
+	///
+	/// \see resolveMacAddress(), ResolverConfig
+	///
+	////////////////////////////////////////////////////////////
+	virtual std::vector<MacAddress> resolveMacAddresses(const std::string& interfaceName,
+	                                                    const std::vector<std::vector<uint8_t>>& ips,
+	                                                    const ResolverConfig& config) {
+		(void)config;
+		std::vector<MacAddress> macs;
+		macs.reserve(ips.size());
+		for (const auto& ip : ips) {
+			macs.push_back(resolveMacAddress(interfaceName, ip));
+		}
+		return macs;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enables caching of neighbour table lookups
+	///
+	/// Platforms that receive neighbour table change events
+	/// keep answers from the system table in memory and drop
+	/// an entry as soon as the system reports it changed, so
+	/// repeated resolutions of known addresses skip the table
+	/// query; they still read pending change events. Platforms
+	/// without such events keep querying on every call.
+	///
+	/// \return bool true if the cache is active
+	///
+	/// \see resolveMacAddresses()
 	///
 	////////////////////////////////////////////////////////////
-	virtual std::vector<uint8_t> resolveMacAddress(const std::string& interfaceName, 
-	                                               const std::vector<uint8_t>& ip) = 0;
+	virtual bool enableNeighbourCache() { return false; }
 };
 
 ////////////////////////////////////////////////////////////
@@ -96,6 +175,83 @@ public:
 ////////////////////////////////////////////////////////////
 class RawSocket {
 public:
+	////////////////////////////////////////////////////////////
+	/// \brief Geometry of memory-mapped receive ring
+	///
+	/// The ring consists of blockCount blocks of blockSize
+	/// bytes. The kernel fills a block with several frames and
+	/// hands it over when it is full or blockTimeoutMs elapsed,
+	/// so one wakeup delivers a batch of frames. blockSize must
+	/// be a multiple of the page size and frameSize a multiple
+	/// of 16 that holds the largest frame plus headers.
+	///
+	/// \see setReceiveRing()
+	///
+	////////////////////////////////////////////////////////////
+	struct RingConfig {
+		uint32_t blockSize = 1 << 20;   ///< Bytes per block
+		uint32_t blockCount = 64;       ///< Number of blocks
+		uint32_t frameSize = 2048;      ///< Nominal frame slot size
+		uint32_t blockTimeoutMs = 10;   ///< Retire partially filled block after this time
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Receive counters kept by the system
+	///
+	/// \see getStatistics()
+	///
+	////////////////////////////////////////////////////////////
+	struct Statistics {
+		uint64_t packets = 0;   ///< Frames that passed the socket filter
+		uint64_t drops = 0;     ///< Frames dropped because the ring or buffer was full
+		uint64_t freezes = 0;   ///< Times the ring was full and the queue froze
+		uint64_t truncated = 0; ///< Frames dropped because they did not fit the receive buffer
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Segmentation and checksum offload state of a frame
+	///
+	/// Frames received with setSegmentationOffload() may be
+	/// super-frames that the kernel merged (GRO) from several
+	/// segments of one TCP or UDP flow; segmentSize then says
+	/// how to cut them again when they are sent (GSO). Passing
+	/// the state back to sendBatchWithOffload() forwards such a
+	/// frame as one unit instead of per-segment copies. Fields
+	/// use the encoding of struct virtio_net_hdr.
+	///
+	/// \see receiveOffload(), sendBatchWithOffload()
+	///
+	////////////////////////////////////////////////////////////
+	struct Offload {
+		uint8_t flags = 0;            ///< VIRTIO_NET_HDR_F_* (checksum to complete, checksum valid)
+		uint8_t segmentation = 0;     ///< VIRTIO_NET_HDR_GSO_* type, 0 - not a super-frame
+		uint16_t headerLength = 0;    ///< Bytes of Ethernet, IP and transport headers
+		uint16_t segmentSize = 0;     ///< Payload bytes per segment
+		uint16_t checksumStart = 0;   ///< Start of checksummed data from the frame start
+		uint16_t checksumOffset = 0;  ///< Checksum field offset from checksumStart
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Handler for received frames
+	///
+	/// The span points into socket-owned memory (possibly the
+	/// receive ring itself) and is valid only during the call.
+	/// The handler may modify the frame in place.
+	///
+	////////////////////////////////////////////////////////////
+	using PacketHandler = std::function<void(ByteSpan frame)>;
+
+	////////////////////////////////////////////////////////////
+	/// \brief How a fanout group spreads frames over its sockets
+	///
+	/// \see setFanout()
+	///
+	////////////////////////////////////////////////////////////
+	enum class FanoutMode {
+		Hash,   ///< By flow hash - both directions of a flow reach the same socket
+		Cpu     ///< By CPU that received the frame (follows NIC queues)
+	};
+
 	////////////////////////////////////////////////////////////
 	/// \brief Virtual destructor
 	///
@@ -151,6 +307,45 @@ public:
 	////////////////////////////////////////////////////////////
 	virtual std::vector<uint8_t> receivePacket() = 0;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Receives packet into caller-provided buffer
+	///
+	/// Does not allocate; the buffer is typically a FramePool
+	/// frame. Frames longer than the buffer are truncated. The
+	/// default implementation copies the result of
+	/// receivePacket(); socket implementations receive directly.
+	///
+	/// \param buffer Destination of the frame
+	///
+	/// \return size_t Frame length, 0 if no packets
+	///
+	/// \see receivePacket(), setFramePool()
+	///
+	////////////////////////////////////////////////////////////
+	virtual size_t receiveInto(ByteSpan buffer) {
+		std::vector<uint8_t> frame = receivePacket();
+		size_t length = frame.size() < buffer.size() ? frame.size() : buffer.size();
+		std::copy(frame.begin(), frame.begin() + static_cast<std::ptrdiff_t>(length), buffer.begin());
+		return length;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Supplies buffers for the default receivePackets()
+	///
+	/// With a pool, the default receivePackets() receives every
+	/// frame into a pool frame with receiveInto(), so it never
+	/// allocates; without one it falls back to receivePacket().
+	/// Sockets with their own receive buffer or ring ignore the
+	/// pool. The pool must outlive its use by this socket and is
+	/// used only by the thread calling receivePackets().
+	///
+	/// \param pool Frame pool, or nullptr to stop using it
+	///
+	/// \see FramePool, receivePackets()
+	///
+	////////////////////////////////////////////////////////////
+	void setFramePool(FramePool* pool) { framePool = pool; }
+
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if socket is open
 	///
@@ -158,6 +353,378 @@ public:
 	///
 	////////////////////////////////////////////////////////////
 	virtual bool isOpen() const = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requests memory-mapped receive ring
+	///
+	/// Must be called before open(). Platforms without ring
+	/// support return false and keep per-frame receive.
+	///
+	/// \param config Ring geometry
+	///
+	/// \return bool true if the ring will be used
+	///
+	/// \see RingConfig, receivePackets()
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool setReceiveRing(const RingConfig& config) { (void)config; return false; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Receives all pending frames
+	///
+	/// Calls handler for every frame that is ready, without
+	/// waiting for new ones. Socket implementations with a
+	/// receive ring pass frames in place; the default
+	/// implementation receives into a frame of the pool set by
+	/// setFramePool(), or wraps receivePacket() without one.
+	///
+	/// \param handler Called once per frame
+	/// \param maxPackets Upper bound of frames handled in this call
+	///
+	/// \return size_t Number of frames handled
+	///
+	/// \see PacketHandler, receivePacket()
+	///
+	////////////////////////////////////////////////////////////
+	virtual size_t receivePackets(const PacketHandler& handler, size_t maxPackets) {
+		size_t count = 0;
+		uint32_t index = framePool ? framePool->acquire() : FramePool::NoFrame;
+		if (index != FramePool::NoFrame) {
+			ByteSpan buffer = framePool->frame(index);
+			size_t length;
+			while (count < maxPackets && (length = receiveInto(buffer)) > 0) {
+				handler(buffer.subspan(0, length));
+				++count;
+			}
+			framePool->release(index);
+			return count;
+		}
+
+		while (count < maxPackets) {
+			std::vector<uint8_t> frame = receivePacket();
+			if (frame.empty()) {
+				break;
+			}
+			handler(ByteSpan(frame));
+			++count;
+		}
+		return count;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets receive counters
+	///
+	/// Counters accumulate from open(); they are not reset by
+	/// reading them.
+	///
+	/// \param statistics Filled with current counters
+	///
+	/// \return bool true if the platform provides counters
+	///
+	/// \see Statistics
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool getStatistics(Statistics& statistics) { (void)statistics; return false; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Attaches classic BPF program to open socket
+	///
+	/// Frames rejected by the program are dropped in the
+	/// kernel and never copied to user space. Frames queued
+	/// before the call may still be delivered, so callers keep
+	/// their own checks. Platforms without kernel filtering
+	/// return false.
+	///
+	/// \param program Filter program, e.g. from BpfFilterBuilder
+	///
+	/// \return bool true if the filter is active
+	///
+	/// \see BpfFilterBuilder
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool attachFilter(const std::vector<BpfInstruction>& program) { (void)program; return false; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends several frames
+	///
+	/// Socket implementations hand the whole batch to the
+	/// system at once; the default implementation calls
+	/// sendPacket() for each frame. Sending stops at the first
+	/// frame that could not be queued.
+	///
+	/// \param frames Frames to send
+	/// \param count Number of frames
+	///
+	/// \return size_t Number of frames sent (from the start of the batch)
+	///
+	/// \see sendPacket(), setTransmitRing()
+	///
+	////////////////////////////////////////////////////////////
+	virtual size_t sendBatch(const ConstByteSpan* frames, size_t count) {
+		size_t sent = 0;
+		while (sent < count && sendPacket(std::vector<uint8_t>(frames[sent].begin(), frames[sent].end()))) {
+			++sent;
+		}
+		return sent;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requests memory-mapped transmit ring
+	///
+	/// Must be called before open(). sendBatch() then copies
+	/// frames into shared memory and needs one system call per
+	/// batch. Only blockSize, blockCount and frameSize of the
+	/// config are used. Platforms without ring support return
+	/// false.
+	///
+	/// Once the ring exists the system sends only from it, so
+	/// sendPacket() also goes through a ring slot and waits
+	/// until the frame has left. sendPacket() and sendBatch()
+	/// then share the ring and must be called from one thread.
+	///
+	/// \param config Ring geometry
+	///
+	/// \return bool true if the ring will be used
+	///
+	/// \see sendBatch()
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool setTransmitRing(const RingConfig& config) { (void)config; return false; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets descriptor for readiness notification
+	///
+	/// The descriptor becomes readable when receivePackets()
+	/// has frames to deliver, so an EventLoop can sleep until
+	/// traffic arrives instead of polling.
+	///
+	/// \return int Pollable descriptor, or -1 if the platform
+	///         cannot wait on this socket
+	///
+	/// \see EventLoop::addSocket()
+	///
+	////////////////////////////////////////////////////////////
+	virtual int getDescriptor() const { return -1; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requests membership in a fanout group
+	///
+	/// Must be called before open(). Sockets opened on the same
+	/// interface with the same group share received frames
+	/// instead of each getting a copy, so several threads can
+	/// receive in parallel. Sending is not affected.
+	///
+	/// \param group Group identifier, shared by all members
+	/// \param mode How frames are spread over members
+	///
+	/// \return bool true if the platform supports fanout
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool setFanout(uint16_t group, FanoutMode mode) { (void)group; (void)mode; return false; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requests kernel receive timestamps
+	///
+	/// Must be called before open(). The kernel then records
+	/// when it received each frame, see receiveTimestamp().
+	/// Platforms without timestamps return false.
+	///
+	/// \return bool true if frames will carry timestamps
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool setReceiveTimestamps() { return false; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets kernel receive time of the current frame
+	///
+	/// Valid only inside a receivePackets() handler call.
+	///
+	/// \return uint64_t Nanoseconds since the Unix epoch
+	///         (std::chrono::system_clock), 0 if unknown
+	///
+	/// \see setReceiveTimestamps()
+	///
+	////////////////////////////////////////////////////////////
+	virtual uint64_t receiveTimestamp() const { return 0; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Requests segmentation offload
+	///
+	/// Must be called before open(). Frames then keep the size
+	/// the kernel gave them, up to 64 KB super-frames merged by
+	/// GRO, and carry their offload state (receiveOffload()),
+	/// so they can be forwarded whole. Platforms without
+	/// offload return false and receive frames up to the
+	/// interface MTU.
+	///
+	/// \return bool true if frames will carry offload state
+	///
+	/// \see Offload, getMaxFrameSize()
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool setSegmentationOffload() { return false; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets offload state of the current frame
+	///
+	/// Valid only inside a receivePackets() handler call.
+	///
+	/// \return const Offload* State of the frame, or nullptr if
+	///         the socket does not use offload
+	///
+	/// \see setSegmentationOffload()
+	///
+	////////////////////////////////////////////////////////////
+	virtual const Offload* receiveOffload() const { return nullptr; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends several frames with their offload state
+	///
+	/// Like sendBatch(); offloads[i] belongs to frames[i]. The
+	/// default implementation ignores offloads, which is right
+	/// for sockets that never report any.
+	///
+	/// \param frames Frames to send
+	/// \param offloads Offload state per frame, or nullptr for none
+	/// \param count Number of frames
+	///
+	/// \return size_t Number of frames sent (from the start of the batch)
+	///
+	/// \see sendBatch(), receiveOffload()
+	///
+	////////////////////////////////////////////////////////////
+	virtual size_t sendBatchWithOffload(const ConstByteSpan* frames, const Offload* offloads, size_t count) {
+		(void)offloads;
+		return sendBatch(frames, count);
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets size of the largest frame that can be received
+	///
+	/// Known after open(); longer frames are dropped and counted
+	/// in Statistics::truncated instead of being cut short.
+	///
+	/// \return size_t Bytes, 0 if the platform does not tell
+	///
+	////////////////////////////////////////////////////////////
+	virtual size_t getMaxFrameSize() const { return 0; }
+
+protected:
+	FramePool* framePool = nullptr; ///< Buffers for the default receivePackets(), see setFramePool()
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Abstraction for event-driven main loop
+///
+/// Dispatches periodic timers, socket readiness and stop
+/// signals (Ctrl+C, SIGTERM) from a single thread. The
+/// process sleeps while nothing happens and wakes up as
+/// soon as a frame arrives, a timer expires or a stop is
+/// requested.
+///
+/// Handlers run on the thread that called run(). Only
+/// stop() may be called from other threads or from signal
+/// handlers.
+///
+/// The class name "EventLoop" comes from:
+/// - "Event" - denotes timer, socket or signal event
+/// - "Loop" - denotes main dispatch loop
+///
+/// \see LinuxEventLoop, PollingEventLoop
+///
+////////////////////////////////////////////////////////////
+class EventLoop {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Handler for timer expiry and stop signals
+	///
+	////////////////////////////////////////////////////////////
+	using Handler = std::function<void()>;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Handler for socket readiness
+	///
+	/// Returns true if it processed any data. Loops that
+	/// cannot wait on the socket use this to decide whether
+	/// to sleep before the next check.
+	///
+	////////////////////////////////////////////////////////////
+	using SocketHandler = std::function<bool()>;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Virtual destructor
+	///
+	/// Ensures proper resource cleanup during inheritance.
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~EventLoop() = default;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Adds periodic timer
+	///
+	/// The timer fires for the first time right after run()
+	/// starts and then every intervalMs milliseconds. Missed
+	/// expiries are coalesced into one call.
+	///
+	/// \param intervalMs Interval in milliseconds (must be positive)
+	/// \param handler Function called on expiry
+	///
+	/// \return bool true if timer was added
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool addTimer(uint32_t intervalMs, Handler handler) = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Adds socket to watch for incoming frames
+	///
+	/// \param socket Open socket (must outlive the registration)
+	/// \param handler Function called when frames are pending
+	///
+	/// \return bool true if socket was added
+	///
+	/// \see RawSocket::getDescriptor()
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool addSocket(RawSocket& socket, SocketHandler handler) = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Handles interrupt and termination signals
+	///
+	/// While registered, Ctrl+C and termination requests call
+	/// handler from the loop instead of killing the process.
+	///
+	/// \param handler Function called when a signal arrives
+	///
+	/// \return bool true if signals are handled by the loop
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool addStopSignals(Handler handler) = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Removes all timers, sockets and signal handlers
+	///
+	/// Restores default signal handling.
+	///
+	////////////////////////////////////////////////////////////
+	virtual void clear() = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Dispatches events until stop() is called
+	///
+	/// A stop requested before run() makes it return at once.
+	///
+	/// \return bool false if waiting for events failed
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool run() = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Makes run() return
+	///
+	/// Safe to call from other threads and signal handlers.
+	///
+	////////////////////////////////////////////////////////////
+	virtual void stop() = 0;
 };
 
 ////////////////////////////////////////////////////////////
@@ -171,11 +738,21 @@ public:
 /// - "Platform" - denotes system platform
 /// - "Factory" - denotes factory design pattern
 ///
-/// \see NetworkInterface, RawSocket
+/// \see NetworkInterface, RawSocket, EventLoop
 ///
 ////////////////////////////////////////////////////////////
 class PlatformFactory {
 public:
+	////////////////////////////////////////////////////////////
+	/// \brief Kind of RawSocket implementation
+	///
+	////////////////////////////////////////////////////////////
+	enum class SocketBackend {
+		Default,    ///< Platform raw socket (AF_PACKET, BPF device, WinPcap)
+		Xdp,        ///< Linux AF_XDP, native XDP with generic (SKB) fallback
+		XdpGeneric  ///< Linux AF_XDP, always generic (SKB) XDP
+	};
+
 	////////////////////////////////////////////////////////////
 	/// \brief Creates NetworkInterface implementation for current platform
 	///
@@ -195,4 +772,27 @@ public:
 	///
 	////////////////////////////////////////////////////////////
 	static std::unique_ptr<RawSocket> createRawSocket();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Creates RawSocket of a given kind
+	///
+	/// \param backend Requested implementation
+	///
+	/// \return std::unique_ptr<RawSocket> Implementation, nullptr if
+	///         the backend is not available on this platform
+	///
+	/// \see RawSocket, LinuxXdpSocket
+	///
+	////////////////////////////////////////////////////////////
+	static std::unique_ptr<RawSocket> createRawSocket(SocketBackend backend);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Creates EventLoop implementation for current platform
+	///
+	/// \return std::unique_ptr<EventLoop> Implementation for current platform
+	///
+	/// \see EventLoop
+	///
+	////////////////////////////////////////////////////////////
+	static std::unique_ptr<EventLoop> createEventLoop();
 }; 
\ No newline at end of file
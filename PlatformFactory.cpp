@@ -3,10 +3,13 @@
 
 #ifdef _WIN32
 #include "WindowsPlatform.hpp"
+#include "PollingEventLoop.hpp"
 #elif defined(__linux__)
 #include "LinuxPlatform.hpp"
+#include "LinuxXdpSocket.hpp"
 #elif defined(__APPLE__)
 #include "MacOSPlatform.hpp"
+#include "PollingEventLoop.hpp"
 #endif
 
 std::unique_ptr<NetworkInterface> PlatformFactory::createNetworkInterface() {
@@ -33,4 +36,29 @@ std::unique_ptr<RawSocket> PlatformFactory::createRawSocket() {
 	// Unsupported platform
 	return nullptr;
 #endif
+}
+
+std::unique_ptr<RawSocket> PlatformFactory::createRawSocket(SocketBackend backend) {
+	if (backend == SocketBackend::Default) {
+		return createRawSocket();
+	}
+#if defined(__linux__)
+	return std::make_unique<LinuxXdpSocket>(backend == SocketBackend::XdpGeneric);
+#else
+	// AF_XDP exists only on Linux
+	return nullptr;
+#endif
+}
+
+std::unique_ptr<EventLoop> PlatformFactory::createEventLoop() {
+#ifdef _WIN32
+	return std::make_unique<PollingEventLoop>();
+#elif defined(__linux__)
+	return std::make_unique<LinuxEventLoop>();
+#elif defined(__APPLE__)
+	return std::make_unique<PollingEventLoop>();
+#else
+	// Unsupported platform
+	return nullptr;
+#endif
 } 
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "PollingEventLoop.hpp"
+#include <csignal>
+#include <thread>
+
+namespace {
+
+std::atomic<bool> signalReceived{false}; ///< Set from signal handler
+
+////////////////////////////////////////////////////////////
+/// \brief Signal handler for SIGINT and SIGTERM
+///
+/// Lock-free atomic store is safe in a signal handler.
+///
+////////////////////////////////////////////////////////////
+void onStopSignal(int) {
+	signalReceived = true;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+PollingEventLoop::~PollingEventLoop() {
+	clear();
+}
+
+////////////////////////////////////////////////////////////
+bool PollingEventLoop::addTimer(uint32_t intervalMs, Handler handler) {
+	if (intervalMs == 0) {
+		return false;
+	}
+	timers.push_back({std::chrono::milliseconds(intervalMs), std::chrono::steady_clock::now(), std::move(handler)});
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool PollingEventLoop::addSocket(RawSocket& socket, SocketHandler handler) {
+	(void)socket;
+	sockets.push_back(std::move(handler));
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool PollingEventLoop::addStopSignals(Handler handler) {
+	stopHandler = std::move(handler);
+	signalReceived = false;
+	std::signal(SIGINT, onStopSignal);
+	std::signal(SIGTERM, onStopSignal);
+	signalsInstalled = true;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void PollingEventLoop::clear() {
+	timers.clear();
+	sockets.clear();
+	stopHandler = nullptr;
+	
+	if (signalsInstalled) {
+		std::signal(SIGINT, SIG_DFL);
+		std::signal(SIGTERM, SIG_DFL);
+		signalsInstalled = false;
+	}
+}
+
+////////////////////////////////////////////////////////////
+bool PollingEventLoop::run() {
+	while (!stopRequested) {
+		if (signalReceived.exchange(false) && stopHandler) {
+			stopHandler();
+			continue;
+		}
+		
+		auto now = std::chrono::steady_clock::now();
+		for (auto& timer : timers) {
+			if (now >= timer.next) {
+				timer.next = now + timer.interval;
+				timer.handler();
+			}
+		}
+		
+		bool busy = false;
+		for (auto& handler : sockets) {
+			busy = handler() || busy;
+		}
+		
+		// Sleep only when idle so bursts are drained without delay
+		if (!busy) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(IdleSleepMs));
+		}
+	}
+	
+	stopRequested = false;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+void PollingEventLoop::stop() {
+	stopRequested = true;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "PlatformAbstraction.hpp"
+#include <vector>
+#include <atomic>
+#include <chrono>
+
+////////////////////////////////////////////////////////////
+/// \brief Portable implementation of EventLoop
+///
+/// Used on platforms whose raw sockets cannot be waited on
+/// (RawSocket::getDescriptor() returns -1). Checks timers
+/// and sockets in turn and sleeps for IdleSleepMs only when
+/// no socket handler processed any data. Stop signals are
+/// caught with std::signal().
+///
+/// The class name "PollingEventLoop" comes from:
+/// - "Polling" - denotes periodic checking of sources
+/// - "Event" - denotes timer, socket or signal event
+/// - "Loop" - denotes main dispatch loop
+///
+/// \see EventLoop, LinuxEventLoop
+///
+////////////////////////////////////////////////////////////
+class PollingEventLoop : public EventLoop {
+public:
+	static constexpr int IdleSleepMs = 1; ///< Sleep when no socket had data
+
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor
+	///
+	/// Restores previous signal handlers.
+	///
+	////////////////////////////////////////////////////////////
+	~PollingEventLoop() override;
+
+	bool addTimer(uint32_t intervalMs, Handler handler) override;
+	bool addSocket(RawSocket& socket, SocketHandler handler) override;
+	bool addStopSignals(Handler handler) override;
+	void clear() override;
+	bool run() override;
+	void stop() override;
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Periodic timer
+	///
+	////////////////////////////////////////////////////////////
+	struct Timer {
+		std::chrono::milliseconds interval;          ///< Period
+		std::chrono::steady_clock::time_point next;  ///< Next expiry
+		Handler handler;                             ///< Function called on expiry
+	};
+
+	std::vector<Timer> timers;                 ///< Registered timers
+	std::vector<SocketHandler> sockets;        ///< Registered socket handlers
+	Handler stopHandler;                       ///< Called when a stop signal arrives
+	bool signalsInstalled = false;             ///< Whether signal handlers must be restored
+	std::atomic<bool> stopRequested{false};    ///< Set by stop()
+};
\ No newline at end of file
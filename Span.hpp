@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+
+////////////////////////////////////////////////////////////
+/// \brief Non-owning view of contiguous memory
+///
+/// Minimal C++17 replacement for std::span. Holds only a
+/// pointer and a length, so it is passed by value. Used to
+/// hand packet data to handlers without copying it, e.g.
+/// frames living inside a kernel receive ring.
+///
+/// The memory must outlive the span; a span into a receive
+/// ring is valid only until the handler returns.
+///
+/// The class name "Span" comes from:
+/// - "Span" - denotes contiguous range of memory
+///
+/// \see ByteSpan, ConstByteSpan, RawSocket::receivePackets()
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class Span {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	/// Creates empty span.
+	///
+	////////////////////////////////////////////////////////////
+	constexpr Span() : pointer(nullptr), length(0) {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor from pointer and size
+	///
+	/// \param data First element
+	/// \param size Number of elements
+	///
+	////////////////////////////////////////////////////////////
+	constexpr Span(T* data, size_t size) : pointer(data), length(size) {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor from vector
+	///
+	/// \param vector Vector to view (must not be resized while viewed)
+	///
+	////////////////////////////////////////////////////////////
+	template <typename U, typename = std::enable_if_t<std::is_convertible<U(*)[], T(*)[]>::value>>
+	Span(std::vector<U>& vector) : pointer(vector.data()), length(vector.size()) {}
+
+	template <typename U, typename = std::enable_if_t<std::is_convertible<const U(*)[], T(*)[]>::value>>
+	Span(const std::vector<U>& vector) : pointer(vector.data()), length(vector.size()) {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Conversion from span of less qualified type
+	///
+	/// Allows passing ByteSpan where ConstByteSpan is expected.
+	///
+	////////////////////////////////////////////////////////////
+	template <typename U, typename = std::enable_if_t<std::is_convertible<U(*)[], T(*)[]>::value>>
+	constexpr Span(const Span<U>& other) : pointer(other.data()), length(other.size()) {}
+
+	constexpr T* data() const { return pointer; }
+	constexpr size_t size() const { return length; }
+	constexpr bool empty() const { return length == 0; }
+
+	constexpr T* begin() const { return pointer; }
+	constexpr T* end() const { return pointer + length; }
+
+	constexpr T& operator[](size_t index) const { return pointer[index]; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets part of span
+	///
+	/// \param offset First element of the part
+	/// \param count Number of elements (clamped to the end)
+	///
+	/// \return Span View of the part, empty if offset is past the end
+	///
+	////////////////////////////////////////////////////////////
+	constexpr Span subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const {
+		if (offset >= length) {
+			return Span();
+		}
+		return Span(pointer + offset, count < length - offset ? count : length - offset);
+	}
+
+private:
+	T* pointer;    ///< First element
+	size_t length; ///< Number of elements
+};
+
+using ByteSpan = Span<uint8_t>;            ///< Mutable view of bytes
+using ConstByteSpan = Span<const uint8_t>; ///< Read-only view of bytes
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <atomic>
+
+////////////////////////////////////////////////////////////
+/// \brief Assumed size of a CPU cache line
+///
+/// Used to keep data written by different threads in
+/// separate cache lines (no false sharing).
+///
+////////////////////////////////////////////////////////////
+constexpr size_t CacheLineSize = 64;
+
+////////////////////////////////////////////////////////////
+/// \brief Bounded lock-free single-producer/single-consumer queue
+///
+/// Fixed-capacity ring buffer connecting exactly one
+/// producer thread with exactly one consumer thread. push()
+/// and pop() never block and never allocate; the storage is
+/// allocated once in the constructor. The capacity is
+/// rounded up to a power of two.
+///
+/// The producer and consumer indices live in separate cache
+/// lines, and each side keeps a cached copy of the other
+/// side's index, so the shared lines are touched only when
+/// the queue looks full or empty.
+///
+/// Example:
+/// \code
+/// SpscQueue<uint32_t> queue(1024);
+/// queue.push(7);          // producer thread
+/// uint32_t value;
+/// if (queue.pop(value)) { // consumer thread
+/// }
+/// \endcode
+///
+/// The class name "SpscQueue" comes from:
+/// - "Spsc" - denotes single producer, single consumer
+/// - "Queue" - denotes FIFO queue
+///
+/// \see ForwardingPipeline
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class SpscQueue {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param capacity Minimum number of elements (rounded up
+	///                 to a power of two, at least 2)
+	///
+	////////////////////////////////////////////////////////////
+	explicit SpscQueue(size_t capacity) {
+		size_t size = 2;
+		while (size < capacity) {
+			size <<= 1;
+		}
+		slots.resize(size);
+		mask = size - 1;
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Adds element (producer thread only)
+	///
+	/// \param value Element to add
+	///
+	/// \return bool false if the queue is full
+	///
+	////////////////////////////////////////////////////////////
+	bool push(const T& value) {
+		size_t tail = producer.index.load(std::memory_order_relaxed);
+		if (tail - producer.cachedOther > mask) {
+			producer.cachedOther = consumer.index.load(std::memory_order_acquire);
+			if (tail - producer.cachedOther > mask) {
+				return false;
+			}
+		}
+		slots[tail & mask] = value;
+		producer.index.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Removes oldest element (consumer thread only)
+	///
+	/// \param value Receives the element
+	///
+	/// \return bool false if the queue is empty
+	///
+	////////////////////////////////////////////////////////////
+	bool pop(T& value) {
+		size_t head = consumer.index.load(std::memory_order_relaxed);
+		if (head == consumer.cachedOther) {
+			consumer.cachedOther = producer.index.load(std::memory_order_acquire);
+			if (head == consumer.cachedOther) {
+				return false;
+			}
+		}
+		value = slots[head & mask];
+		consumer.index.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets number of queued elements
+	///
+	/// May be called from any thread; the result is a snapshot.
+	///
+	////////////////////////////////////////////////////////////
+	size_t size() const {
+		size_t head = consumer.index.load(std::memory_order_acquire);
+		size_t tail = producer.index.load(std::memory_order_acquire);
+		return tail - head;
+	}
+
+	bool empty() const { return size() == 0; }
+	size_t capacity() const { return mask + 1; }
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Index owned by one side, alone in its cache line
+	///
+	////////////////////////////////////////////////////////////
+	struct alignas(CacheLineSize) Side {
+		std::atomic<size_t> index{0}; ///< Next slot to write (producer) or read (consumer)
+		size_t cachedOther = 0;       ///< Last seen index of the other side
+	};
+
+	Side producer;          ///< Written by producer thread
+	Side consumer;          ///< Written by consumer thread
+	std::vector<T> slots;   ///< Ring storage
+	size_t mask = 0;        ///< capacity() - 1
+};
\ No newline at end of file
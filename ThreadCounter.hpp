@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+
+////////////////////////////////////////////////////////////
+/// \brief Counter written by a single thread
+///
+/// Plain load and store instead of a locked increment; any
+/// thread may read it.
+///
+////////////////////////////////////////////////////////////
+struct ThreadCounter {
+	std::atomic<uint64_t> value{0}; ///< Current value
+
+	void add(uint64_t amount) {
+		value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+	void set(uint64_t amount) { value.store(amount, std::memory_order_relaxed); }
+	uint64_t get() const { return value.load(std::memory_order_relaxed); }
+};
\ No newline at end of file
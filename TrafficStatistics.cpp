@@ -0,0 +1,44 @@
+#include "TrafficStatistics.hpp"
+
+////////////////////////////////////////////////////////////
+void TrafficStatistics::Block::addTo(Snapshot& snapshot) const {
+	snapshot.arpSent += arpSent.get();
+	snapshot.received += received.get();
+	snapshot.receivedBytes += receivedBytes.get();
+	snapshot.dropped += dropped.get();
+	snapshot.forwarded += forwarded.get();
+	snapshot.forwardedBytes += forwardedBytes.get();
+	snapshot.sendFailures += sendFailures.get();
+	snapshot.kernelDrops += kernelDrops.get();
+	for (size_t i = 0; i < DirectionCount; ++i) {
+		snapshot.directions[i].frames += directionFrames[i].get();
+		snapshot.directions[i].bytes += directionBytes[i].get();
+	}
+	forwardLatency.addTo(snapshot.forwardLatency);
+	arpSendTime.addTo(snapshot.arpSendTime);
+	loopTime.addTo(snapshot.loopTime);
+	addedDelay.addTo(snapshot.addedDelay);
+}
+
+////////////////////////////////////////////////////////////
+TrafficStatistics::Block& TrafficStatistics::createBlock() {
+	std::lock_guard<std::mutex> lock(blocksMutex);
+	blocks.push_back(std::make_unique<Block>());
+	return *blocks.back();
+}
+
+////////////////////////////////////////////////////////////
+void TrafficStatistics::clear() {
+	std::lock_guard<std::mutex> lock(blocksMutex);
+	blocks.clear();
+}
+
+////////////////////////////////////////////////////////////
+TrafficStatistics::Snapshot TrafficStatistics::snapshot() const {
+	Snapshot snapshot;
+	std::lock_guard<std::mutex> lock(blocksMutex);
+	for (const auto& block : blocks) {
+		block->addTo(snapshot);
+	}
+	return snapshot;
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "SpscQueue.hpp"
+#include "ThreadCounter.hpp"
+#include "LatencyHistogram.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+////////////////////////////////////////////////////////////
+/// \brief Attack traffic counters, one block per thread
+///
+/// Every thread that counts traffic (control thread, pipeline
+/// threads, fanout workers) gets its own Block from
+/// createBlock() and is its only writer. Blocks are aligned
+/// to cache lines, so the hot path neither locks nor shares
+/// a cache line with another writer. snapshot() sums all
+/// blocks and may be called from any thread, e.g. a monitor
+/// polling App::getStatistics() while the attack runs.
+///
+/// Example:
+/// \code
+/// TrafficStatistics statistics;
+/// TrafficStatistics::Block& block = statistics.createBlock();
+/// block.addReceived(frame.size());          // worker thread
+/// TrafficStatistics::Snapshot now = statistics.snapshot(); // any thread
+/// \endcode
+///
+/// The class name "TrafficStatistics" comes from:
+/// - "Traffic" - denotes intercepted network traffic
+/// - "Statistics" - denotes collected counters
+///
+/// \see App::getStatistics(), ForwardingPipeline, ForwardingWorker
+///
+////////////////////////////////////////////////////////////
+class TrafficStatistics {
+public:
+	////////////////////////////////////////////////////////////
+	/// \brief Direction of an intercepted frame
+	///
+	////////////////////////////////////////////////////////////
+	enum class Direction {
+		VictimToTarget,  ///< Sent by the victim
+		TargetToVictim   ///< Sent by the target
+	};
+
+	static constexpr size_t DirectionCount = 2;  ///< Number of Direction values
+
+	////////////////////////////////////////////////////////////
+	/// \brief Counters of one direction
+	///
+	////////////////////////////////////////////////////////////
+	struct DirectionCounters {
+		uint64_t frames = 0;   ///< Intercepted frames
+		uint64_t bytes = 0;    ///< Intercepted bytes
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Summed counters at one moment
+	///
+	////////////////////////////////////////////////////////////
+	struct Snapshot {
+		uint64_t arpSent = 0;          ///< Spoofed ARP replies sent
+		uint64_t received = 0;         ///< Frames delivered by the sockets
+		uint64_t receivedBytes = 0;    ///< Bytes delivered by the sockets
+		uint64_t dropped = 0;          ///< Intercepted frames dropped (drop mode)
+		uint64_t forwarded = 0;        ///< Frames forwarded
+		uint64_t forwardedBytes = 0;   ///< Bytes forwarded
+		uint64_t sendFailures = 0;     ///< Frames the socket did not accept
+		uint64_t kernelDrops = 0;      ///< Frames lost by the system (receive buffer or ring full)
+		std::array<DirectionCounters, DirectionCount> directions{}; ///< Indexed by Direction
+		LatencyHistogram::Distribution forwardLatency; ///< Frame availability to end of its send
+		LatencyHistogram::Distribution arpSendTime;    ///< Duration of one spoofed ARP send
+		LatencyHistogram::Distribution loopTime;       ///< Handling time of one socket wakeup
+		LatencyHistogram::Distribution addedDelay;     ///< Kernel receive timestamp to end of send
+
+		////////////////////////////////////////////////////////////
+		/// \brief Gets counters of one direction
+		///
+		////////////////////////////////////////////////////////////
+		const DirectionCounters& direction(Direction value) const {
+			return directions[static_cast<size_t>(value)];
+		}
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Counters of one writer thread
+	///
+	/// All add methods must be called from the owning thread.
+	///
+	////////////////////////////////////////////////////////////
+	class alignas(CacheLineSize) Block {
+	public:
+		void addArpSent() { arpSent.add(1); }
+		void addReceived(size_t bytes) { received.add(1); receivedBytes.add(bytes); }
+		void addDropped() { dropped.add(1); }
+		void addForwarded(size_t bytes) { forwarded.add(1); forwardedBytes.add(bytes); }
+		void addSendFailure() { sendFailures.add(1); }
+		void setKernelDrops(uint64_t drops) { kernelDrops.set(drops); }
+
+		////////////////////////////////////////////////////////////
+		/// \brief Counts an intercepted frame
+		///
+		////////////////////////////////////////////////////////////
+		void addIntercepted(Direction direction, size_t bytes) {
+			size_t index = static_cast<size_t>(direction);
+			directionFrames[index].add(1);
+			directionBytes[index].add(bytes);
+		}
+
+		////////////////////////////////////////////////////////////
+		/// \brief Records forwarding latency of one frame
+		///
+		/// \param nanoseconds Time from frame availability to send
+		///
+		////////////////////////////////////////////////////////////
+		void addLatency(uint64_t nanoseconds) { forwardLatency.record(nanoseconds); }
+		void addArpSendTime(uint64_t nanoseconds) { arpSendTime.record(nanoseconds); }
+		void addLoopTime(uint64_t nanoseconds) { loopTime.record(nanoseconds); }
+
+		////////////////////////////////////////////////////////////
+		/// \brief Records delay the attack added to one frame
+		///
+		/// \param nanoseconds Time from the kernel receive timestamp
+		///                    to the end of the frame's send
+		///
+		////////////////////////////////////////////////////////////
+		void addAddedDelay(uint64_t nanoseconds) { addedDelay.record(nanoseconds); }
+
+		////////////////////////////////////////////////////////////
+		/// \brief Adds this block's counters to a snapshot
+		///
+		/// Safe to call from any thread.
+		///
+		////////////////////////////////////////////////////////////
+		void addTo(Snapshot& snapshot) const;
+
+	private:
+		ThreadCounter arpSent;
+		ThreadCounter received;
+		ThreadCounter receivedBytes;
+		ThreadCounter dropped;
+		ThreadCounter forwarded;
+		ThreadCounter forwardedBytes;
+		ThreadCounter sendFailures;
+		ThreadCounter kernelDrops;
+		ThreadCounter directionFrames[DirectionCount];
+		ThreadCounter directionBytes[DirectionCount];
+		LatencyHistogram forwardLatency;
+		LatencyHistogram arpSendTime;
+		LatencyHistogram loopTime;
+		LatencyHistogram addedDelay;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Creates counters for a new writer thread
+	///
+	/// The block stays valid until clear() or destruction.
+	///
+	////////////////////////////////////////////////////////////
+	Block& createBlock();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Removes all blocks
+	///
+	/// No writer thread may be running.
+	///
+	////////////////////////////////////////////////////////////
+	void clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sums counters of all blocks
+	///
+	/// Safe to call from any thread.
+	///
+	////////////////////////////////////////////////////////////
+	Snapshot snapshot() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets monotonic time for latency measurement
+	///
+	/// \return uint64_t Nanoseconds since an unspecified epoch
+	///
+	////////////////////////////////////////////////////////////
+	static uint64_t now() {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets wall-clock time comparable with receive timestamps
+	///
+	/// \return uint64_t Nanoseconds since the Unix epoch
+	///
+	/// \see RawSocket::receiveTimestamp()
+	///
+	////////////////////////////////////////////////////////////
+	static uint64_t systemNow() {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count());
+	}
+
+private:
+	mutable std::mutex blocksMutex;              ///< Guards the list, not the counters
+	std::vector<std::unique_ptr<Block>> blocks;  ///< One block per writer thread
+};
\ No newline at end of file
@@ -52,14 +52,24 @@ std::vector<NetworkInterface::InterfaceInfo> WindowsNetworkInterface::getInterfa
 		
 		// Adres MAC
 		if (p->PhysicalAddressLength == 6) {
-			info.mac.assign(p->PhysicalAddress, p->PhysicalAddress + 6);
+			info.mac = MacAddress(p->PhysicalAddress);
 		}
 		
-		// Adres IP i maska
-		if (p->FirstUnicastAddress) {
-			sockaddr_in* addr = (sockaddr_in*)p->FirstUnicastAddress->Address.lpSockaddr;
-			info.ip.assign((uint8_t*)&addr->sin_addr, (uint8_t*)&addr->sin_addr + 4);
-			info.prefixLength = p->FirstUnicastAddress->OnLinkPrefixLength;
+		info.index = p->IfIndex;
+		info.prefixLength = 0;
+		
+		// Adresy IP i maski - pierwszy adres jest adresem głównym
+		for (IP_ADAPTER_UNICAST_ADDRESS* u = p->FirstUnicastAddress; u; u = u->Next) {
+			sockaddr_in* addr = (sockaddr_in*)u->Address.lpSockaddr;
+			InterfaceInfo::AddressInfo entry;
+			entry.ip.assign((uint8_t*)&addr->sin_addr, (uint8_t*)&addr->sin_addr + 4);
+			entry.prefixLength = u->OnLinkPrefixLength;
+			
+			if (info.addresses.empty()) {
+				info.ip = entry.ip;
+				info.prefixLength = entry.prefixLength;
+			}
+			info.addresses.push_back(std::move(entry));
 		}
 		
 		// Brama domyślna
@@ -74,8 +84,8 @@ std::vector<NetworkInterface::InterfaceInfo> WindowsNetworkInterface::getInterfa
 	return interfaces;
 }
 
-std::vector<uint8_t> WindowsNetworkInterface::resolveMacAddress(const std::string& interfaceName, 
-                                                               const std::vector<uint8_t>& ip) {
+MacAddress WindowsNetworkInterface::resolveMacAddress(const std::string& interfaceName,
+                                                     const std::vector<uint8_t>& ip) {
 	if (ip.size() != 4) {
 		return {};
 	}
@@ -109,7 +119,7 @@ std::vector<uint8_t> WindowsNetworkInterface::resolveMacAddress(const std::strin
 	}
 	
 	if (row.State == NlnsReachable) {
-		return std::vector<uint8_t>(row.PhysicalAddress, row.PhysicalAddress + 6);
+		return MacAddress(row.PhysicalAddress);
 	}
 	
 	return {};
@@ -182,21 +192,41 @@ bool WindowsRawSocket::sendPacket(const std::vector<uint8_t>& data) {
 }
 
 std::vector<uint8_t> WindowsRawSocket::receivePacket() {
-	if (sock == INVALID_SOCKET) return {};
-	
 	std::vector<uint8_t> buffer(65536);
+	buffer.resize(receiveInto(ByteSpan(buffer)));
+	return buffer;
+}
+	
+size_t WindowsRawSocket::sendBatch(const ConstByteSpan* frames, size_t count) {
+	if (sock == INVALID_SOCKET) return 0;
+	
+	sockaddr_in addr = { 0 };
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = INADDR_ANY;
+	
+	size_t sent = 0;
+	while (sent < count && frames[sent].size() <= static_cast<size_t>((std::numeric_limits<int>::max)()) &&
+	       sendto((SOCKET)sock, (const char*)frames[sent].data(), static_cast<int>(frames[sent].size()), 0,
+	              (sockaddr*)&addr, sizeof(addr)) != SOCKET_ERROR) {
+		++sent;
+	}
+	return sent;
+}
+
+size_t WindowsRawSocket::receiveInto(ByteSpan buffer) {
+	if (sock == INVALID_SOCKET) return 0;
+	
 	if (buffer.size() > static_cast<size_t>((std::numeric_limits<int>::max)())) {
-		return {}; // Za duży bufor
+		return 0; // Za duży bufor
 	}
 	
 	int result = recv((SOCKET)sock, (char*)buffer.data(), static_cast<int>(buffer.size()), 0);
 	
 	if (result == SOCKET_ERROR) {
-		return {};
+		return 0;
 	}
 	
-	buffer.resize(result);
-	return buffer;
+	return static_cast<size_t>(result);
 }
 
 bool WindowsRawSocket::isOpen() const {
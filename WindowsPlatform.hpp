@@ -65,13 +65,13 @@ public:
 	/// \param interfaceName Interface name to search on
 	/// \param ip IP address to resolve
 	///
-	/// \return std::vector<uint8_t> MAC address (6 bytes) or empty vector
+	/// \return MacAddress MAC address or empty address
 	///
 	/// \see NetworkInterface::resolveMacAddress()
 	///
 	////////////////////////////////////////////////////////////
-	std::vector<uint8_t> resolveMacAddress(const std::string& interfaceName, 
-	                                       const std::vector<uint8_t>& ip) override;
+	MacAddress resolveMacAddress(const std::string& interfaceName,
+	                             const std::vector<uint8_t>& ip) override;
 
 private:
 	////////////////////////////////////////////////////////////
@@ -179,6 +179,27 @@ public:
 	////////////////////////////////////////////////////////////
 	std::vector<uint8_t> receivePacket() override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Receives packet into caller-provided buffer
+	///
+	/// Windows implementation using recv() straight into the buffer.
+	///
+	/// \see RawSocket::receiveInto()
+	///
+	////////////////////////////////////////////////////////////
+	size_t receiveInto(ByteSpan buffer) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sends several frames
+	///
+	/// One sendto() per frame, straight from the caller's
+	/// memory without copying it into a vector.
+	///
+	/// \see RawSocket::sendBatch()
+	///
+	////////////////////////////////////////////////////////////
+	size_t sendBatch(const ConstByteSpan* frames, size_t count) override;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Checks if socket is open
 	///
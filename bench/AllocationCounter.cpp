@@ -0,0 +1,131 @@
+#include "BenchUtils.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace {
+
+std::atomic<uint64_t> allocations{0}; ///< Number of operator new calls
+
+void* countedAllocate(size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (size == 0) {
+		size = 1;
+	}
+	return std::malloc(size);
+}
+
+void* countedAllocate(size_t size, std::align_val_t alignment) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	size_t bytes = static_cast<size_t>(alignment);
+#ifdef _MSC_VER
+	return _aligned_malloc(size == 0 ? 1 : size, bytes);
+#else
+	// aligned_alloc() needs a multiple of the alignment
+	return std::aligned_alloc(bytes, size == 0 ? bytes : (size + bytes - 1) / bytes * bytes);
+#endif
+}
+
+void alignedFree(void* ptr) {
+#ifdef _MSC_VER
+	_aligned_free(ptr);
+#else
+	std::free(ptr);
+#endif
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+/// \brief Counting replacements of the global allocation functions
+///
+/// Kept apart from the rest of the benchmark code, so the
+/// compiler never inlines a replaced operator new next to the
+/// matching free().
+///
+////////////////////////////////////////////////////////////
+
+void* operator new(size_t size) {
+	void* ptr = countedAllocate(size);
+	if (!ptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return countedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return countedAllocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+	void* ptr = countedAllocate(size, alignment);
+	if (!ptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+	return operator new(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	return countedAllocate(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	return countedAllocate(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+	alignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+	alignedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+	alignedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+	alignedFree(ptr);
+}
+
+namespace bench {
+
+////////////////////////////////////////////////////////////
+uint64_t allocationCount() {
+	return allocations.load(std::memory_order_relaxed);
+}
+
+} // namespace bench
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "BenchUtils.hpp"
+#include "AppBench.hpp"
+#include "../NetworkHeaders.hpp"
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+////////////////////////////////////////////////////////////
+/// \brief Microbenchmark of App's per-frame work
+///
+/// Runs the real App code on synthetic frames, without
+/// sockets or privileges:
+/// - classifyPacket() over a mix of intercepted and
+///   unrelated frames,
+/// - handlePacket() with forwarding to a socket that
+///   discards frames (classification, statistics, send),
+/// - the same in drop mode,
+/// - createArpPacket().
+///
+/// The per-frame cases must not allocate.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+const uint8_t VictimMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x02};
+const uint8_t TargetMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x03};
+const uint8_t OurMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+const uint8_t OtherMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x09};
+const uint8_t VictimIp[4] = {10, 0, 0, 2};
+const uint8_t TargetIp[4] = {10, 0, 0, 3};
+const size_t FrameSize = 128;
+
+////////////////////////////////////////////////////////////
+/// \brief Synthetic frame with its original addresses
+///
+/// Forwarding rewrites the MAC addresses in place, so every
+/// iteration restores them from here first.
+///
+////////////////////////////////////////////////////////////
+struct Frame {
+	std::vector<uint8_t> data;
+	uint8_t dest[6];
+	uint8_t src[6];
+};
+
+Frame makeFrame(const uint8_t* src, const uint8_t* dest, uint16_t etherType, const uint8_t* ipSrc, const uint8_t* ipDest) {
+	Frame frame;
+	frame.data.assign(FrameSize, 0);
+	std::memcpy(frame.dest, dest, 6);
+	std::memcpy(frame.src, src, 6);
+	frame.data[12] = static_cast<uint8_t>(etherType >> 8);
+	frame.data[13] = static_cast<uint8_t>(etherType);
+	frame.data[14] = 0x45;
+	std::memcpy(frame.data.data() + 26, ipSrc, 4);
+	std::memcpy(frame.data.data() + 30, ipDest, 4);
+	return frame;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Traffic as seen by the attacker without a kernel filter
+///
+/// Three of four frames are intercepted, both directions.
+///
+////////////////////////////////////////////////////////////
+std::vector<Frame> makeTraffic() {
+	std::vector<Frame> frames;
+	frames.push_back(makeFrame(VictimMac, OurMac, 0x0800, VictimIp, TargetIp));
+	frames.push_back(makeFrame(TargetMac, OurMac, 0x0800, TargetIp, VictimIp));
+	frames.push_back(makeFrame(VictimMac, OurMac, 0x0800, VictimIp, TargetIp));
+	frames.push_back(makeFrame(OtherMac, OurMac, 0x0800, TargetIp, VictimIp));
+	return frames;
+}
+
+ByteSpan restore(Frame& frame) {
+	std::memcpy(frame.data.data(), frame.dest, 6);
+	std::memcpy(frame.data.data() + 6, frame.src, 6);
+	return ByteSpan(frame.data);
+}
+
+} // namespace
+
+int main() {
+	const uint64_t iterations = 5000000;
+	std::vector<Frame> frames = makeTraffic();
+	
+	App::AttackInfo info;
+	info.victimIp = IPAddress(VictimIp);
+	info.targetIp = IPAddress(TargetIp);
+	info.victimMac = MacAddress(VictimMac);
+	info.targetMac = MacAddress(TargetMac);
+	info.myMac = MacAddress(OurMac);
+	info.isActive = true;
+	
+	App forwardApp;
+	AppBench forward(forwardApp);
+	forward.configure(info, false, std::make_unique<DiscardSocket>());
+	
+	App dropApp;
+	AppBench drop(dropApp);
+	drop.configure(info, true, std::make_unique<DiscardSocket>());
+	
+	auto classify = bench::run("classifyPacket (3/4 intercepted)", iterations, [&](uint64_t i) {
+		ForwardingPipeline::Action action = forward.classify(restore(frames[i % frames.size()]));
+		bench::doNotOptimize(action);
+	});
+	
+	auto handle = bench::run("handlePacket forward (discard socket)", iterations, [&](uint64_t i) {
+		forward.handle(restore(frames[i % frames.size()]));
+	});
+	
+	auto handleDrop = bench::run("handlePacket drop mode", iterations, [&](uint64_t i) {
+		drop.handle(restore(frames[i % frames.size()]));
+	});
+	
+	auto arp = bench::run("createArpPacket", iterations / 5, [&](uint64_t) {
+		std::vector<uint8_t> packet = forward.arpPacket();
+		bench::doNotOptimize(packet.data());
+	});
+	
+	bench::report(classify);
+	bench::report(handle);
+	bench::report(handleDrop);
+	bench::report(arp);
+	
+	// Every fourth frame is not intercepted; two of three go from the victim
+	const uint64_t checkFrames = 4000;
+	TrafficStatistics::Snapshot before = forward.statistics();
+	for (uint64_t i = 0; i < checkFrames; ++i) {
+		forward.handle(restore(frames[i % frames.size()]));
+	}
+	TrafficStatistics::Snapshot after = forward.statistics();
+	uint64_t forwarded = after.forwarded - before.forwarded;
+	uint64_t fromVictim = after.direction(TrafficStatistics::Direction::VictimToTarget).frames -
+	                      before.direction(TrafficStatistics::Direction::VictimToTarget).frames;
+	if (forwarded != checkFrames / 4 * 3 || fromVictim != checkFrames / 2) {
+		std::fprintf(stderr, "FAIL: forwarded %llu (%llu from victim) of %llu frames\n",
+		             static_cast<unsigned long long>(forwarded), static_cast<unsigned long long>(fromVictim),
+		             static_cast<unsigned long long>(checkFrames));
+		return 1;
+	}
+	if (classify.allocationsPerOp != 0.0 || handle.allocationsPerOp != 0.0 || handleDrop.allocationsPerOp != 0.0) {
+		std::fprintf(stderr, "FAIL: per-frame path allocates\n");
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
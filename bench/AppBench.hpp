@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../App.hpp"
+#include <memory>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// \brief Access to App internals for the benchmarks
+///
+/// Lets a benchmark configure an attack without resolving
+/// addresses or opening sockets, and drive the per-frame code
+/// directly.
+///
+////////////////////////////////////////////////////////////
+class AppBench {
+public:
+	explicit AppBench(App& app) : app(app) {}
+
+	void configure(const App::AttackInfo& info, bool dropMode, std::unique_ptr<RawSocket> socket) {
+		app.attackInfo = info;
+		app.config.dropMode = dropMode;
+		app.rawSocket = std::move(socket);
+		app.controlStatistics = &app.statistics.createBlock();
+	}
+
+	ForwardingPipeline::Action classify(ByteSpan frame) {
+		TrafficStatistics::Direction direction = TrafficStatistics::Direction::VictimToTarget;
+		return app.classifyPacket(frame, direction);
+	}
+
+	void handle(ByteSpan frame) { app.handlePacket(frame); }
+
+	std::vector<uint8_t> arpPacket() {
+		return app.createArpPacket(app.attackInfo.victimIp, app.attackInfo.victimMac,
+		                           app.attackInfo.targetIp, app.attackInfo.myMac);
+	}
+
+	TrafficStatistics::Snapshot statistics() const { return app.statistics.snapshot(); }
+
+private:
+	App& app;
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Raw socket that discards sent frames
+///
+////////////////////////////////////////////////////////////
+class DiscardSocket : public RawSocket {
+public:
+	bool open(const std::string&, bool) override { return true; }
+	void close() override {}
+	bool isOpen() const override { return true; }
+	std::vector<uint8_t> receivePacket() override { return {}; }
+	bool sendPacket(const std::vector<uint8_t>&) override { return true; }
+	size_t sendBatch(const ConstByteSpan*, size_t count) override { return count; }
+};
\ No newline at end of file
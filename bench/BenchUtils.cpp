@@ -0,0 +1,163 @@
+#include "BenchUtils.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define BENCH_HAS_TSC 1
+#endif
+
+namespace {
+
+////////////////////////////////////////////////////////////
+/// \brief Reported results, written to BENCH_JSON at exit
+///
+////////////////////////////////////////////////////////////
+struct JsonLog {
+	std::vector<bench::Result> results;
+
+	~JsonLog() {
+		const char* path = std::getenv("BENCH_JSON");
+		if (!path || path[0] == '\0') {
+			return;
+		}
+		FILE* file = std::fopen(path, "w");
+		if (!file) {
+			std::fprintf(stderr, "bench: cannot write %s\n", path);
+			return;
+		}
+		
+		const char* commit = std::getenv("BENCH_COMMIT");
+		std::fprintf(file, "{\n  \"commit\": \"%s\",\n  \"timestamp\": %lld,\n  \"results\": [",
+		             escape(commit ? commit : "").c_str(), static_cast<long long>(std::time(nullptr)));
+		for (size_t i = 0; i < results.size(); ++i) {
+			const bench::Result& result = results[i];
+			std::fprintf(file, "%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, "
+			             "\"allocs_per_op\": %.3f, \"metrics\": {",
+			             i == 0 ? "" : ",", escape(result.name).c_str(),
+			             static_cast<unsigned long long>(result.iterations), result.nsPerOp, result.allocationsPerOp);
+			for (size_t j = 0; j < result.metrics.size(); ++j) {
+				std::fprintf(file, "%s\"%s\": ", j == 0 ? "" : ", ", escape(result.metrics[j].first).c_str());
+				if (std::isfinite(result.metrics[j].second)) {
+					std::fprintf(file, "%.6g", result.metrics[j].second);
+				} else {
+					std::fprintf(file, "null");
+				}
+			}
+			std::fprintf(file, "}}");
+		}
+		std::fprintf(file, "\n  ]\n}\n");
+		std::fclose(file);
+	}
+
+	static std::string escape(const std::string& text) {
+		std::string escaped;
+		for (char c : text) {
+			if (c == '"' || c == '\\') {
+				escaped += '\\';
+			}
+			escaped += c;
+		}
+		return escaped;
+	}
+};
+
+JsonLog jsonLog;
+
+} // namespace
+
+namespace bench {
+
+////////////////////////////////////////////////////////////
+CycleCounter::CycleCounter() {
+#if defined(__linux__)
+	perf_event_attr attributes;
+	std::memset(&attributes, 0, sizeof(attributes));
+	attributes.type = PERF_TYPE_HARDWARE;
+	attributes.size = sizeof(attributes);
+	attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv = 1;
+	fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+	if (fd >= 0) {
+		return;
+	}
+#endif
+#ifdef BENCH_HAS_TSC
+	timestampCounter = true;
+#endif
+}
+
+////////////////////////////////////////////////////////////
+CycleCounter::~CycleCounter() {
+#if defined(__linux__)
+	if (fd >= 0) {
+		close(fd);
+	}
+#endif
+}
+
+////////////////////////////////////////////////////////////
+uint64_t CycleCounter::read() const {
+#if defined(__linux__)
+	if (fd >= 0) {
+		uint64_t value = 0;
+		if (::read(fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+			return value;
+		}
+		return 0;
+	}
+#endif
+#ifdef BENCH_HAS_TSC
+	if (timestampCounter) {
+		return __rdtsc();
+	}
+#endif
+	return 0;
+}
+
+////////////////////////////////////////////////////////////
+const char* CycleCounter::source() const {
+	if (fd >= 0) {
+		return "cycles";
+	}
+	return timestampCounter ? "tsc" : "none";
+}
+
+////////////////////////////////////////////////////////////
+void report(const Result& result) {
+	std::printf("%-40s %12.2f ns/op %10.3f allocs/op  (%llu iterations)\n",
+	            result.name.c_str(), result.nsPerOp, result.allocationsPerOp,
+	            static_cast<unsigned long long>(result.iterations));
+	jsonLog.results.push_back(result);
+}
+
+////////////////////////////////////////////////////////////
+void report(const std::string& name, const std::vector<std::pair<std::string, double>>& metrics) {
+	std::printf("%-40s", name.c_str());
+	for (const auto& metric : metrics) {
+		std::printf(" %12.6g %s", metric.second, metric.first.c_str());
+	}
+	std::printf("\n");
+	
+	Result result;
+	result.name = name;
+	result.iterations = 0;
+	result.nsPerOp = 0.0;
+	result.allocationsPerOp = 0.0;
+	result.metrics = metrics;
+	jsonLog.results.push_back(result);
+}
+
+} // namespace bench
\ No newline at end of file
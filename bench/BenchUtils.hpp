@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+
+////////////////////////////////////////////////////////////
+/// \brief Minimal helpers shared by the benchmark programs
+///
+/// Every benchmark binary links BenchUtils.cpp, which replaces
+/// the global operator new/delete with counting versions so
+/// that hot paths can be checked for heap allocations.
+///
+/// Every reported result is also collected; if the BENCH_JSON
+/// environment variable names a file, the results are written
+/// there as JSON when the program exits, together with
+/// BENCH_COMMIT (if set), so runs on different commits can be
+/// compared with bench/compare.py.
+///
+////////////////////////////////////////////////////////////
+namespace bench {
+
+////////////////////////////////////////////////////////////
+/// \brief Result of a single measured benchmark case
+///
+////////////////////////////////////////////////////////////
+struct Result {
+	std::string name;          ///< Benchmark case name
+	uint64_t iterations;       ///< Number of measured operations
+	double nsPerOp;            ///< Average wall time per operation
+	double allocationsPerOp;   ///< Average heap allocations per operation
+	std::vector<std::pair<std::string, double>> metrics; ///< Further measurements, e.g. frames per second
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Gets number of heap allocations made so far
+///
+/// \return uint64_t Allocation counter (all threads)
+///
+////////////////////////////////////////////////////////////
+uint64_t allocationCount();
+
+////////////////////////////////////////////////////////////
+/// \brief Counts CPU cycles of the calling thread
+///
+/// Uses the hardware cycle counter through perf_event_open
+/// (Linux, user-space cycles only). Where it is not available,
+/// e.g. in virtual machines without a PMU or with a restrictive
+/// perf_event_paranoid, falls back to the time stamp counter
+/// on x86, which counts at a constant reference rate. Without
+/// either, read() returns 0 and isAvailable() is false.
+///
+////////////////////////////////////////////////////////////
+class CycleCounter {
+public:
+	CycleCounter();
+	~CycleCounter();
+
+	CycleCounter(const CycleCounter&) = delete;
+	CycleCounter& operator=(const CycleCounter&) = delete;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets current counter value
+	///
+	/// Only differences of two values are meaningful.
+	///
+	////////////////////////////////////////////////////////////
+	uint64_t read() const;
+
+	bool isAvailable() const { return fd >= 0 || timestampCounter; }
+
+	////////////////////////////////////////////////////////////
+	/// \brief Gets name of the counter in use
+	///
+	/// \return const char* "cycles", "tsc" or "none"
+	///
+	////////////////////////////////////////////////////////////
+	const char* source() const;
+
+private:
+	int fd = -1;                    ///< perf event descriptor, -1 if not opened
+	bool timestampCounter = false;  ///< Falling back to the time stamp counter
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Prevents the compiler from optimizing a value away
+///
+/// \param value Value that must be considered used
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Measures average time and allocations of an operation
+///
+/// Runs a short warm-up, then calls fn(i) for i in
+/// [0, iterations) and reports averages.
+///
+/// \param name Benchmark case name
+/// \param iterations Number of measured calls
+/// \param fn Operation to measure, called with iteration index
+///
+/// \return Result Measured averages
+///
+////////////////////////////////////////////////////////////
+template <typename Fn>
+Result run(const std::string& name, uint64_t iterations, Fn&& fn) {
+	for (uint64_t i = 0; i < iterations / 10 + 1; ++i) {
+		fn(i);
+	}
+
+	uint64_t allocationsBefore = allocationCount();
+	auto start = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < iterations; ++i) {
+		fn(i);
+	}
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	uint64_t allocations = allocationCount() - allocationsBefore;
+
+	Result result;
+	result.name = name;
+	result.iterations = iterations;
+	result.nsPerOp = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+	result.allocationsPerOp = static_cast<double>(allocations) / static_cast<double>(iterations);
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Prints benchmark result in human-readable form
+///
+/// The result is also kept for the JSON output.
+///
+/// \param result Result to print
+///
+////////////////////////////////////////////////////////////
+void report(const Result& result);
+
+////////////////////////////////////////////////////////////
+/// \brief Prints and keeps a measurement that is not timed
+///        by run(), e.g. throughput of a multi-threaded test
+///
+/// \param name Benchmark case name
+/// \param metrics Measurements to report
+///
+////////////////////////////////////////////////////////////
+void report(const std::string& name, const std::vector<std::pair<std::string, double>>& metrics);
+
+} // namespace bench
\ No newline at end of file
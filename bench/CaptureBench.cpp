@@ -0,0 +1,145 @@
+#include "BenchUtils.hpp"
+#include "../CaptureWriter.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// \brief Benchmark of the pcapng capture writer
+///
+/// Measures the cost of CaptureWriter::write() on the calling
+/// thread (which must not allocate) with buffered writes, with
+/// O_DIRECT and with size rotation. The written files are read
+/// back: every frame that was not reported as dropped must be
+/// present as an Enhanced Packet Block with its timestamp, and
+/// rotated files must stay within the size limit.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+const size_t FrameSize = 128;
+const uint64_t BaseTime = 1700000000000000000ull;
+
+uint32_t read32(const std::vector<uint8_t>& data, size_t offset) {
+	uint32_t value;
+	std::memcpy(&value, data.data() + offset, 4);
+	return value;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Checks one capture file
+///
+/// \param nextTime Timestamp of the next expected frame,
+///                 advanced past every frame found
+/// \param frames Incremented per frame found
+///
+/// \return bool false if the file is malformed
+///
+////////////////////////////////////////////////////////////
+bool checkFile(const std::string& name, uint64_t& nextTime, uint64_t& frames, uint64_t& size) {
+	std::ifstream file(name, std::ios::binary);
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	size = data.size();
+	if (data.size() < 28 || read32(data, 0) != 0x0A0D0D0A || read32(data, 8) != 0x1A2B3C4D) {
+		return false;
+	}
+
+	size_t offset = 0;
+	while (offset + 12 <= data.size()) {
+		uint32_t type = read32(data, offset);
+		uint32_t length = read32(data, offset + 4);
+		if (length < 12 || length % 4 != 0 || offset + length > data.size() ||
+		    read32(data, offset + length - 4) != length) {
+			return false;
+		}
+		if (type == 6) {
+			uint64_t time = (static_cast<uint64_t>(read32(data, offset + 12)) << 32) | read32(data, offset + 16);
+			if (time < nextTime || read32(data, offset + 20) != FrameSize) {
+				return false;
+			}
+			nextTime = time + 1;
+			frames++;
+		}
+		offset += length;
+	}
+	return offset == data.size();
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Writes frames, reports the cost and checks the files
+///
+////////////////////////////////////////////////////////////
+bool runCase(const std::string& name, CaptureWriter::Config config, uint64_t iterations) {
+	CaptureWriter writer;
+	if (!writer.open(config)) {
+		std::fprintf(stderr, "FAIL: %s: cannot open %s\n", name.c_str(), config.path.c_str());
+		return false;
+	}
+
+	std::vector<uint8_t> frame(FrameSize, 0x5A);
+	ConstByteSpan span(frame);
+	uint64_t sequence = 0; // Timestamps keep rising through the warm-up
+	auto start = std::chrono::steady_clock::now();
+	bench::Result result = bench::run(name, iterations, [&](uint64_t) {
+		writer.write(span, BaseTime + sequence++);
+	});
+	writer.close();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	CaptureWriter::Statistics statistics = writer.getStatistics();
+	uint64_t frames = 0;
+	uint64_t nextTime = 0;
+	bool valid = statistics.writeErrors == 0 && (config.rotateBytes == 0 || statistics.files > 1);
+	for (uint64_t index = 1; valid && index <= statistics.files; ++index) {
+		uint64_t size = 0;
+		valid = checkFile(writer.fileName(index), nextTime, frames, size);
+		if (config.rotateBytes != 0 && size > config.rotateBytes + 256) {
+			valid = false;
+		}
+		std::remove(writer.fileName(index).c_str());
+	}
+
+	result.metrics.push_back({"files", static_cast<double>(statistics.files)});
+	result.metrics.push_back({"dropped_frames", static_cast<double>(statistics.dropped)});
+	result.metrics.push_back({"mb_per_s", static_cast<double>(statistics.bytes) / seconds / 1e6});
+	bench::report(result);
+	std::printf("%-40s %12.1f MB/s %8llu files %8llu dropped\n", "",
+	            static_cast<double>(statistics.bytes) / seconds / 1e6, static_cast<unsigned long long>(statistics.files),
+	            static_cast<unsigned long long>(statistics.dropped));
+
+	if (!valid || frames != statistics.frames) {
+		std::fprintf(stderr, "FAIL: %s: %llu of %llu frames in %llu valid files\n", name.c_str(),
+		             static_cast<unsigned long long>(frames), static_cast<unsigned long long>(statistics.frames),
+		             static_cast<unsigned long long>(statistics.files));
+		return false;
+	}
+	if (result.allocationsPerOp > 0.001) {
+		std::fprintf(stderr, "FAIL: %s: write() allocates\n", name.c_str());
+		return false;
+	}
+	return true;
+}
+
+} // namespace
+
+int main() {
+	const uint64_t iterations = 400000;
+
+	CaptureWriter::Config buffered;
+	buffered.path = "capture_bench.pcapng";
+	buffered.interfaceName = "bench0";
+
+	CaptureWriter::Config direct = buffered;
+	direct.directIo = true;
+
+	CaptureWriter::Config rotated = buffered;
+	rotated.rotateBytes = 8000000;
+
+	bool passed = runCase("pcapng write 128 B (buffered)", buffered, iterations);
+	passed = runCase("pcapng write 128 B (O_DIRECT)", direct, iterations) && passed;
+	passed = runCase("pcapng write 128 B (rotate 8 MB)", rotated, iterations) && passed;
+	return passed ? 0 : 1;
+}
\ No newline at end of file
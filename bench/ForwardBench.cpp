@@ -0,0 +1,163 @@
+#include "BenchUtils.hpp"
+#include "../PlatformAbstraction.hpp"
+#include "../NetworkHeaders.hpp"
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+////////////////////////////////////////////////////////////
+/// \brief Benchmark of the forwarding step of App::handlePacket
+///
+/// Compares the previous forwarding path (copy the frame
+/// into a new vector, rewrite MAC addresses, sendPacket())
+/// with the in-place path (rewrite MAC addresses in the
+/// receive buffer, sendBatch() from a span). Reports frames
+/// and bytes per second for several frame sizes:
+/// - against a socket that discards frames, which isolates
+///   the cost of the forwarding step itself,
+/// - against a real raw socket on an interface (default
+///   "lo"), if it can be opened.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+const MacAddress VictimMac(0x02, 0x00, 0x00, 0x00, 0x00, 0x02);
+const MacAddress TargetMac(0x02, 0x00, 0x00, 0x00, 0x00, 0x03);
+const MacAddress OurMac(0x02, 0x00, 0x00, 0x00, 0x00, 0x01);
+
+////////////////////////////////////////////////////////////
+/// \brief Raw socket that counts and discards sent frames
+///
+////////////////////////////////////////////////////////////
+class DiscardSocket : public RawSocket {
+public:
+	bool open(const std::string&, bool) override { return true; }
+	void close() override {}
+	bool isOpen() const override { return true; }
+	std::vector<uint8_t> receivePacket() override { return {}; }
+
+	bool sendPacket(const std::vector<uint8_t>& data) override {
+		bytes += data.size();
+		return true;
+	}
+
+	size_t sendBatch(const ConstByteSpan* frames, size_t count) override {
+		for (size_t i = 0; i < count; ++i) {
+			bytes += frames[i].size();
+		}
+		return count;
+	}
+
+	uint64_t bytes = 0; ///< Bytes "sent"
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Previous forwarding path: copy, rewrite, send
+///
+////////////////////////////////////////////////////////////
+void forwardByCopy(ByteSpan data, RawSocket& socket) {
+	ConstEthernetView eth(data);
+	std::vector<uint8_t> newPacket(data.begin(), data.end());
+	EthernetView newEth{ByteSpan(newPacket)};
+	
+	if (eth.source() == VictimMac) {
+		newEth.setDestination(TargetMac);
+		newEth.setSource(OurMac);
+	} else {
+		newEth.setDestination(VictimMac);
+		newEth.setSource(OurMac);
+	}
+	
+	socket.sendPacket(newPacket);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Current forwarding path: rewrite in place, send span
+///
+////////////////////////////////////////////////////////////
+void forwardInPlace(ByteSpan data, RawSocket& socket) {
+	EthernetView eth(data);
+	if (eth.source() == VictimMac) {
+		eth.setDestination(TargetMac);
+	} else {
+		eth.setDestination(VictimMac);
+	}
+	eth.setSource(OurMac);
+	
+	ConstByteSpan frame(data);
+	socket.sendBatch(&frame, 1);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Creates IPv4 frame from the victim to us
+///
+////////////////////////////////////////////////////////////
+std::vector<uint8_t> makeFrame(size_t size) {
+	std::vector<uint8_t> frame(size, 0);
+	EthernetView eth{ByteSpan(frame)};
+	eth.setDestination(OurMac);
+	eth.setSource(VictimMac);
+	eth.setEtherType(ETHERTYPE_IP);
+	frame[14] = 0x45;
+	return frame;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Runs one forwarding path and prints its throughput
+///
+/// \return double Allocations per frame
+///
+////////////////////////////////////////////////////////////
+template <typename Forward>
+double measure(const std::string& name, size_t frameSize, uint64_t iterations,
+               RawSocket& socket, Forward forward) {
+	std::vector<uint8_t> frame = makeFrame(frameSize);
+	bench::Result result = bench::run(name, iterations, [&](uint64_t i) {
+		// Alternate directions like bidirectional traffic
+		((i & 1) ? TargetMac : VictimMac).copyTo(frame.data() + 6);
+		OurMac.copyTo(frame.data());
+		forward(ByteSpan(frame), socket);
+	});
+	double framesPerSecond = 1e9 / result.nsPerOp;
+	result.metrics.push_back({"frames_per_s", framesPerSecond});
+	result.metrics.push_back({"mb_per_s", framesPerSecond * static_cast<double>(frameSize) / 1e6});
+	bench::report(result);
+	
+	std::printf("%-40s %12.0f frames/s %10.1f MB/s\n", "", framesPerSecond,
+	            framesPerSecond * static_cast<double>(frameSize) / 1e6);
+	return result.allocationsPerOp;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const char* interfaceName = argc > 1 ? argv[1] : "lo";
+	const size_t frameSizes[] = {64, 576, 1514};
+	bool failed = false;
+
+	DiscardSocket discard;
+	for (size_t size : frameSizes) {
+		std::string suffix = " " + std::to_string(size) + " B (discard)";
+		measure("copy + sendPacket" + suffix, size, 5000000, discard, forwardByCopy);
+		failed |= measure("in place + sendBatch" + suffix, size, 5000000, discard, forwardInPlace) > 0.0;
+	}
+
+	auto socket = PlatformFactory::createRawSocket();
+	if (!socket || !socket->open(interfaceName, false)) {
+		std::printf("forward_bench: cannot open raw socket on %s, socket cases skipped\n", interfaceName);
+	} else {
+		for (size_t size : frameSizes) {
+			std::string suffix = " " + std::to_string(size) + " B (" + interfaceName + ")";
+			measure("copy + sendPacket" + suffix, size, 200000, *socket, forwardByCopy);
+			failed |= measure("in place + sendBatch" + suffix, size, 200000, *socket, forwardInPlace) > 0.0;
+		}
+		socket->close();
+	}
+
+	if (failed) {
+		std::printf("FAIL: in-place forwarding allocates\n");
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "BenchUtils.hpp"
+#include "../NetworkHeaders.hpp"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#endif
+
+////////////////////////////////////////////////////////////
+/// \brief Benchmark of the header views against struct casts
+///
+/// Compares, on frames laid out back to back as in a receive
+/// ring (so the IPv4 header sits at an odd 2-byte offset):
+/// - reading EtherType and IPv4 addresses through
+///   ConstEthernetView / ConstIpv4View and through the
+///   previous reinterpret_cast to header structs,
+/// - building an ARP reply with makeArpFrame() and by filling
+///   the previous structs field by field.
+///
+/// Both variants must agree and the views must not allocate.
+/// makeArpFrame() is also evaluated at compile time.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+const MacAddress VictimMac(0x02, 0x00, 0x00, 0x00, 0x00, 0x02);
+const MacAddress OurMac(0x02, 0x00, 0x00, 0x00, 0x00, 0x01);
+const IPAddress VictimIp(10, 0, 0, 2);
+const IPAddress TargetIp(10, 0, 0, 3);
+const size_t FrameSize = 62;   ///< Not a multiple of 4, so frames start misaligned too
+const size_t FrameCount = 256;
+
+constexpr MacAddress ConstantMac(0x02, 0x00, 0x00, 0x00, 0x00, 0x07);
+constexpr ArpFrame ConstantReply = makeArpFrame(ARP_OP_REPLY, MacAddress::Broadcast, ConstantMac,
+                                                IPAddress(10, 0, 0, 1), MacAddress(), IPAddress(10, 0, 0, 2));
+static_assert(ConstantReply[12] == 0x08 && ConstantReply[13] == 0x06, "EtherType");
+static_assert(ConstantReply[21] == ARP_OP_REPLY && ConstantReply[27] == 0x07, "operation and sender");
+static_assert(ConstantReply[31] == 1 && ConstantReply[41] == 2, "sender and target IP");
+
+////////////////////////////////////////////////////////////
+/// \brief Header structs used before the views
+///
+////////////////////////////////////////////////////////////
+struct LegacyEthernetHeader {
+	uint8_t dest[6];
+	uint8_t src[6];
+	uint16_t type;
+};
+
+struct LegacyIpHeader {
+	uint8_t version_ihl;
+	uint8_t tos;
+	uint16_t total_length;
+	uint16_t id;
+	uint16_t flags_offset;
+	uint8_t ttl;
+	uint8_t protocol;
+	uint16_t checksum;
+	uint32_t src;
+	uint32_t dest;
+};
+
+struct LegacyArpHeader {
+	uint16_t hardware_type;
+	uint16_t protocol_type;
+	uint8_t hardware_size;
+	uint8_t protocol_size;
+	uint16_t opcode;
+	uint8_t sender_mac[6];
+	uint8_t sender_ip[4];
+	uint8_t target_mac[6];
+	uint8_t target_ip[4];
+};
+
+uint64_t parseWithViews(ByteSpan frame) {
+	ConstEthernetView eth(frame);
+	if (!eth || eth.etherType() != ETHERTYPE_IP) {
+		return 0;
+	}
+	ConstIpv4View ip(eth.payload());
+	if (!ip) {
+		return 0;
+	}
+	return ip.source().toUint32() ^ (static_cast<uint64_t>(ip.destination().toUint32()) << 32);
+}
+
+uint64_t parseWithCasts(ByteSpan frame) {
+	if (frame.size() < sizeof(LegacyEthernetHeader) + sizeof(LegacyIpHeader)) {
+		return 0;
+	}
+	LegacyEthernetHeader* eth = reinterpret_cast<LegacyEthernetHeader*>(frame.data());
+	if (ntohs(eth->type) != ETHERTYPE_IP) {
+		return 0;
+	}
+	LegacyIpHeader* ip = reinterpret_cast<LegacyIpHeader*>(frame.data() + sizeof(LegacyEthernetHeader));
+	IPAddress src(reinterpret_cast<uint8_t*>(&ip->src));
+	IPAddress dest(reinterpret_cast<uint8_t*>(&ip->dest));
+	return src.toUint32() ^ (static_cast<uint64_t>(dest.toUint32()) << 32);
+}
+
+void buildWithCasts(uint8_t* packet, const IPAddress& spoofedIp) {
+	LegacyEthernetHeader* eth = reinterpret_cast<LegacyEthernetHeader*>(packet);
+	std::memcpy(eth->dest, VictimMac.data(), 6);
+	std::memcpy(eth->src, OurMac.data(), 6);
+	eth->type = htons(ETHERTYPE_ARP);
+
+	LegacyArpHeader* arp = reinterpret_cast<LegacyArpHeader*>(packet + 14);
+	arp->hardware_type = htons(HW_TYPE_ETHERNET);
+	arp->protocol_type = htons(ETHERTYPE_IP);
+	arp->hardware_size = 6;
+	arp->protocol_size = 4;
+	arp->opcode = htons(ARP_OP_REPLY);
+	std::memcpy(arp->sender_mac, OurMac.data(), 6);
+	std::memcpy(arp->sender_ip, spoofedIp.toArray().data(), 4);
+	std::memcpy(arp->target_mac, VictimMac.data(), 6);
+	std::memcpy(arp->target_ip, VictimIp.toArray().data(), 4);
+}
+
+} // namespace
+
+int main() {
+	const uint64_t iterations = 20000000;
+
+	// Frames back to back; every other one is ARP, which both parsers skip
+	std::vector<uint8_t> ring(FrameSize * FrameCount + 1);
+	std::vector<ByteSpan> frames;
+	for (size_t i = 0; i < FrameCount; ++i) {
+		ByteSpan frame(ring.data() + 1 + i * FrameSize, FrameSize);
+		EthernetView eth(frame);
+		eth.setDestination(OurMac);
+		eth.setSource(VictimMac);
+		eth.setEtherType(i % 2 == 0 ? ETHERTYPE_IP : ETHERTYPE_ARP);
+		Ipv4View ip(eth.payload());
+		ip.setHeaderLength(Ipv4View::MinSize);
+		ip.setSource(IPAddress::fromUint32(VictimIp.toUint32() + static_cast<uint32_t>(i)));
+		ip.setDestination(TargetIp);
+		frames.push_back(frame);
+	}
+
+	uint64_t viewSum = 0;
+	uint64_t castSum = 0;
+	for (ByteSpan frame : frames) {
+		viewSum += parseWithViews(frame);
+		castSum += parseWithCasts(frame);
+	}
+	if (viewSum != castSum || viewSum == 0) {
+		std::fprintf(stderr, "FAIL: views and casts read different fields\n");
+		return 1;
+	}
+
+	auto views = bench::run("parse Ethernet + IPv4 (views)", iterations, [&](uint64_t i) {
+		bench::doNotOptimize(parseWithViews(frames[i % FrameCount]));
+	});
+	auto casts = bench::run("parse Ethernet + IPv4 (struct casts)", iterations, [&](uint64_t i) {
+		bench::doNotOptimize(parseWithCasts(frames[i % FrameCount]));
+	});
+
+	uint8_t legacy[42];
+	buildWithCasts(legacy, TargetIp);
+	ArpFrame built = makeArpFrame(ARP_OP_REPLY, VictimMac, OurMac, TargetIp, VictimMac, VictimIp);
+	if (std::memcmp(legacy, built.data(), built.size()) != 0) {
+		std::fprintf(stderr, "FAIL: makeArpFrame differs from the struct-built frame\n");
+		return 1;
+	}
+
+	auto builder = bench::run("build ARP reply (makeArpFrame)", iterations, [&](uint64_t i) {
+		ArpFrame frame = makeArpFrame(ARP_OP_REPLY, VictimMac, OurMac,
+		                              IPAddress::fromUint32(static_cast<uint32_t>(i)), VictimMac, VictimIp);
+		bench::doNotOptimize(frame.data());
+	});
+	auto structs = bench::run("build ARP reply (struct casts)", iterations, [&](uint64_t i) {
+		uint8_t packet[42];
+		buildWithCasts(packet, IPAddress::fromUint32(static_cast<uint32_t>(i)));
+		bench::doNotOptimize(static_cast<uint8_t*>(packet));
+	});
+
+	bench::report(views);
+	bench::report(casts);
+	bench::report(builder);
+	bench::report(structs);
+	std::printf("views / casts: parse %.2fx, build %.2fx\n", views.nsPerOp / casts.nsPerOp,
+	            builder.nsPerOp / structs.nsPerOp);
+
+	if (views.allocationsPerOp != 0.0 || builder.allocationsPerOp != 0.0) {
+		std::fprintf(stderr, "FAIL: header views allocate\n");
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "BenchUtils.hpp"
+#include "../IPAddress.hpp"
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+////////////////////////////////////////////////////////////
+/// \brief Microbenchmark of per-packet IPAddress handling
+///
+/// Mirrors what App::handlePacket does for every received
+/// frame: build source and destination addresses from the
+/// IPv4 header and compare them with the victim address.
+/// A vector-backed reference implementation (the previous
+/// IPAddress layout) is measured for comparison.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+const size_t FrameCount = 1024;  ///< Number of distinct synthetic frames
+const size_t IpSrcOffset = 26;   ///< Offset of IPv4 source in Ethernet frame
+const size_t IpDestOffset = 30;  ///< Offset of IPv4 destination in Ethernet frame
+
+////////////////////////////////////////////////////////////
+/// \brief Previous heap-backed address layout, kept for comparison
+///
+////////////////////////////////////////////////////////////
+struct VectorAddress {
+	std::vector<uint8_t> address;
+	
+	explicit VectorAddress(const uint8_t bytes[4]) : address(bytes, bytes + 4) {}
+	bool operator!=(const VectorAddress& other) const { return address != other.address; }
+};
+
+std::vector<std::vector<uint8_t>> makeFrames() {
+	std::vector<std::vector<uint8_t>> frames(FrameCount, std::vector<uint8_t>(64, 0));
+	for (size_t i = 0; i < frames.size(); ++i) {
+		uint8_t src[4] = {192, 168, 1, static_cast<uint8_t>(i)};
+		uint8_t dst[4] = {10, 0, static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)};
+		std::memcpy(frames[i].data() + IpSrcOffset, src, 4);
+		std::memcpy(frames[i].data() + IpDestOffset, dst, 4);
+	}
+	return frames;
+}
+
+} // namespace
+
+int main() {
+	const uint64_t iterations = 5000000;
+	auto frames = makeFrames();
+	
+	const uint8_t victimBytes[4] = {192, 168, 1, 42};
+	const IPAddress victimIp(victimBytes);
+	const IPAddress mask = IPAddress::fromPrefixLength(24);
+	const VectorAddress victimVector(victimBytes);
+	
+	auto current = bench::run("IPAddress per-packet compare", iterations, [&](uint64_t i) {
+		const uint8_t* frame = frames[i % FrameCount].data();
+		IPAddress srcIp(frame + IpSrcOffset);
+		IPAddress dstIp(frame + IpDestOffset);
+		bool match = !(srcIp != victimIp && dstIp != victimIp);
+		bench::doNotOptimize(match);
+	});
+	
+	auto network = bench::run("IPAddress mask/arithmetic", iterations, [&](uint64_t i) {
+		const uint8_t* frame = frames[i % FrameCount].data();
+		IPAddress srcIp(frame + IpSrcOffset);
+		IPAddress next = srcIp.getNetworkAddress(mask) + 1;
+		auto bytes = next.toArray();
+		bool same = srcIp.isInSameNetwork(victimIp, mask);
+		bench::doNotOptimize(bytes);
+		bench::doNotOptimize(same);
+	});
+	
+	auto legacy = bench::run("vector-backed per-packet compare", iterations, [&](uint64_t i) {
+		const uint8_t* frame = frames[i % FrameCount].data();
+		VectorAddress srcIp(frame + IpSrcOffset);
+		VectorAddress dstIp(frame + IpDestOffset);
+		bool match = !(srcIp != victimVector && dstIp != victimVector);
+		bench::doNotOptimize(match);
+	});
+	
+	bench::report(current);
+	bench::report(network);
+	bench::report(legacy);
+	
+	if (current.allocationsPerOp != 0.0 || network.allocationsPerOp != 0.0) {
+		std::fprintf(stderr, "FAIL: IPAddress hot path allocates\n");
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
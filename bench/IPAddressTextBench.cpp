@@ -0,0 +1,222 @@
+#include "BenchUtils.hpp"
+#include "../IPAddress.hpp"
+#include <string>
+#include <vector>
+#include <sstream>
+#include <random>
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#endif
+
+////////////////////////////////////////////////////////////
+/// \brief Benchmark and differential check of IPv4 text handling
+///
+/// Before timing anything, IPAddress::parse() and toChars()
+/// are compared with inet_pton()/inet_ntop() on a large set
+/// of random valid and mutated inputs; any disagreement
+/// fails the run. Then the new parser and formatter are
+/// timed against the previous stringstream implementation.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+////////////////////////////////////////////////////////////
+/// \brief Previous stringstream-based parser, kept for comparison
+///
+////////////////////////////////////////////////////////////
+bool legacyParse(const std::string& ipString, uint8_t bytes[4]) {
+	std::istringstream iss(ipString);
+	std::string token;
+	for (int i = 0; i < 4; ++i) {
+		if (!std::getline(iss, token, '.')) {
+			return false;
+		}
+		if (token.empty() || token.find_first_not_of("0123456789") != std::string::npos) {
+			return false;
+		}
+		int value = std::stoi(token);
+		if (value < 0 || value > 255) {
+			return false;
+		}
+		bytes[i] = static_cast<uint8_t>(value);
+	}
+	return !std::getline(iss, token);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Previous ostringstream-based formatter, kept for comparison
+///
+////////////////////////////////////////////////////////////
+std::string legacyFormat(const IPAddress& ip) {
+	std::ostringstream oss;
+	oss << static_cast<int>(ip[0]) << "." << static_cast<int>(ip[1]) << "."
+	    << static_cast<int>(ip[2]) << "." << static_cast<int>(ip[3]);
+	return oss.str();
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Produces a random, possibly malformed, address string
+///
+////////////////////////////////////////////////////////////
+std::string randomInput(std::mt19937& rng) {
+	static const char alphabet[] = "0123456789.....  x-+";
+	std::uniform_int_distribution<int> kind(0, 9);
+	std::uniform_int_distribution<int> octet(0, 300);
+	std::uniform_int_distribution<int> small(0, 5);
+	
+	std::string s;
+	switch (kind(rng)) {
+	case 0: {
+		// Completely random characters
+		int length = small(rng) * 4;
+		for (int i = 0; i < length; ++i) {
+			s += alphabet[rng() % (sizeof(alphabet) - 1)];
+		}
+		return s;
+	}
+	case 1:
+		// Leading zeros
+		return std::to_string(octet(rng)) + ".0" + std::to_string(octet(rng) % 100) + ".1.2";
+	default:
+		break;
+	}
+	
+	int octets = kind(rng) < 8 ? 4 : small(rng) + 1;
+	for (int i = 0; i < octets; ++i) {
+		if (i > 0) {
+			s += '.';
+		}
+		s += std::to_string(kind(rng) < 7 ? octet(rng) % 256 : octet(rng) * 13);
+	}
+	// Occasionally mutate a single character
+	if (kind(rng) == 0 && !s.empty()) {
+		s[rng() % s.size()] = alphabet[rng() % (sizeof(alphabet) - 1)];
+	}
+	return s;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Compares parse()/toChars() with inet_pton()/inet_ntop()
+///
+/// \return size_t Number of mismatches found
+///
+////////////////////////////////////////////////////////////
+size_t differentialCheck(size_t rounds) {
+	std::mt19937 rng(12345);
+	size_t mismatches = 0;
+	size_t accepted = 0;
+	
+	for (size_t i = 0; i < rounds; ++i) {
+		std::string input = randomInput(rng);
+		
+		in_addr reference;
+		bool referenceOk = inet_pton(AF_INET, input.c_str(), &reference) == 1;
+		
+		IPAddress parsed;
+		const char* end = input.data() + input.size();
+		bool ok = IPAddress::parse(input.data(), end, parsed) == end;
+		
+		if (ok != referenceOk ||
+		    (ok && std::memcmp(parsed.toArray().data(), &reference, 4) != 0)) {
+			std::fprintf(stderr, "parse mismatch for \"%s\": inet_pton=%d parse=%d\n",
+			             input.c_str(), referenceOk, ok);
+			++mismatches;
+		}
+		accepted += ok;
+		
+		// Formatting of an arbitrary 32-bit value
+		uint32_t value = static_cast<uint32_t>(rng());
+		IPAddress address = IPAddress::fromUint32(value);
+		char expected[INET_ADDRSTRLEN];
+		auto bytes = address.toArray();
+		inet_ntop(AF_INET, bytes.data(), expected, sizeof(expected));
+		char buffer[IPAddress::MaxStringLength];
+		std::string formatted(buffer, address.toChars(buffer));
+		if (formatted != expected) {
+			std::fprintf(stderr, "format mismatch: inet_ntop=%s toChars=%s\n", expected, formatted.c_str());
+			++mismatches;
+		}
+	}
+	
+	std::printf("differential check: %zu inputs, %zu valid, %zu mismatches\n", rounds, accepted, mismatches);
+	return mismatches;
+}
+
+} // namespace
+
+int main() {
+#ifdef _WIN32
+	WSADATA wsaData;
+	WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+
+	if (differentialCheck(1000000) != 0) {
+		std::fprintf(stderr, "FAIL: parser/formatter disagree with inet_pton/inet_ntop\n");
+		return 1;
+	}
+	
+	const uint64_t iterations = 2000000;
+	std::vector<std::string> inputs;
+	std::mt19937 rng(1);
+	for (int i = 0; i < 1024; ++i) {
+		inputs.push_back(IPAddress::fromUint32(static_cast<uint32_t>(rng())).toString());
+	}
+	
+	std::string bulk;
+	for (const auto& input : inputs) {
+		bulk += input;
+		bulk += '\n';
+	}
+	std::vector<IPAddress> bulkResults(inputs.size());
+	
+	auto parseNew = bench::run("IPAddress::parse", iterations, [&](uint64_t i) {
+		const std::string& s = inputs[i % inputs.size()];
+		IPAddress ip;
+		bench::doNotOptimize(IPAddress::parse(s.data(), s.data() + s.size(), ip));
+		bench::doNotOptimize(ip);
+	});
+	
+	auto parseLegacy = bench::run("stringstream parse (previous)", iterations / 10, [&](uint64_t i) {
+		uint8_t bytes[4];
+		bench::doNotOptimize(legacyParse(inputs[i % inputs.size()], bytes));
+		bench::doNotOptimize(bytes);
+	});
+	
+	auto formatNew = bench::run("IPAddress::toChars", iterations, [&](uint64_t i) {
+		char buffer[IPAddress::MaxStringLength];
+		IPAddress ip = IPAddress::fromUint32(static_cast<uint32_t>(i * 2654435761u));
+		bench::doNotOptimize(ip.toChars(buffer));
+		bench::doNotOptimize(buffer);
+	});
+	
+	auto formatLegacy = bench::run("ostringstream format (previous)", iterations / 10, [&](uint64_t i) {
+		IPAddress ip = IPAddress::fromUint32(static_cast<uint32_t>(i * 2654435761u));
+		bench::doNotOptimize(legacyFormat(ip));
+	});
+	
+	auto parseBulk = bench::run("IPAddress::parseAll (per address)", 2000, [&](uint64_t) {
+		bench::doNotOptimize(IPAddress::parseAll(bulk, bulkResults.data(), bulkResults.size()));
+	});
+	parseBulk.nsPerOp /= static_cast<double>(inputs.size());
+	parseBulk.allocationsPerOp /= static_cast<double>(inputs.size());
+	
+	bench::report(parseNew);
+	bench::report(parseLegacy);
+	bench::report(formatNew);
+	bench::report(formatLegacy);
+	bench::report(parseBulk);
+	std::printf("parse speedup: %.1fx, format speedup: %.1fx\n",
+	            parseLegacy.nsPerOp / parseNew.nsPerOp, formatLegacy.nsPerOp / formatNew.nsPerOp);
+	
+	if (parseNew.allocationsPerOp != 0.0 || formatNew.allocationsPerOp != 0.0 || parseBulk.allocationsPerOp != 0.0) {
+		std::fprintf(stderr, "FAIL: IPv4 text handling allocates\n");
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
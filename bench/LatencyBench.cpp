@@ -0,0 +1,88 @@
+#include "BenchUtils.hpp"
+#include "../TrafficStatistics.hpp"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+
+////////////////////////////////////////////////////////////
+/// \brief Microbenchmark of per-frame delay recording
+///
+/// Measures TrafficStatistics::Block::addAddedDelay(), which
+/// the forwarding threads call once per frame with
+/// --latency, against the log2 histogram used for the other
+/// latency counters. Recording must not allocate. Also checks
+/// that percentiles stay within one sub-bucket of the exact
+/// values.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+const size_t SampleCount = 4096;  ///< Number of distinct synthetic delays
+
+std::vector<uint64_t> makeDelays() {
+	// Around 10 us with a long tail, as seen on a busy forwarder
+	std::mt19937_64 generator(7);
+	std::lognormal_distribution<double> distribution(9.2, 0.8);
+	std::vector<uint64_t> delays(SampleCount);
+	for (auto& delay : delays) {
+		delay = static_cast<uint64_t>(distribution(generator));
+	}
+	return delays;
+}
+
+} // namespace
+
+int main() {
+	const uint64_t iterations = 20000000;
+	auto delays = makeDelays();
+	
+	TrafficStatistics statistics;
+	TrafficStatistics::Block& block = statistics.createBlock();
+	
+	auto hdr = bench::run("LatencyHistogram record", iterations, [&](uint64_t i) {
+		block.addAddedDelay(delays[i % SampleCount]);
+	});
+	
+	auto log2 = bench::run("log2 histogram record", iterations, [&](uint64_t i) {
+		block.addLatency(delays[i % SampleCount]);
+	});
+	
+	uint64_t now = 0;
+	auto clock = bench::run("TrafficStatistics::systemNow", iterations / 10, [&](uint64_t) {
+		now = TrafficStatistics::systemNow();
+		bench::doNotOptimize(now);
+	});
+	
+	bench::report(hdr);
+	bench::report(log2);
+	bench::report(clock);
+	
+	if (hdr.allocationsPerOp != 0.0) {
+		std::fprintf(stderr, "FAIL: delay recording allocates\n");
+		return 1;
+	}
+	
+	// Percentile of the recorded delays against the exact sorted value
+	LatencyHistogram histogram;
+	std::vector<uint64_t> sorted = delays;
+	for (uint64_t delay : sorted) {
+		histogram.record(delay);
+	}
+	std::sort(sorted.begin(), sorted.end());
+	LatencyHistogram::Distribution distribution;
+	histogram.addTo(distribution);
+	for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+		size_t rank = static_cast<size_t>(percentile / 100.0 * static_cast<double>(SampleCount) + 0.999999);
+		uint64_t exact = sorted[rank - 1];
+		uint64_t value = distribution.valueAtPercentile(percentile);
+		std::printf("  p%-5g exact %8llu ns, histogram %8llu ns\n", percentile,
+		            static_cast<unsigned long long>(exact), static_cast<unsigned long long>(value));
+		if (value < exact || value - exact > exact / 16) {
+			std::fprintf(stderr, "FAIL: p%g outside bucket precision\n", percentile);
+			return 1;
+		}
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,338 @@
+#include "BenchUtils.hpp"
+#include "../App.hpp"
+#include "../ArpSpoofer.hpp"
+#include "../InMemoryPlatform.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+////////////////////////////////////////////////////////////
+/// \brief End-to-end benchmark of the attack on a simulated
+///        network
+///
+/// Runs the real App and ArpSpoofer over InMemoryNetwork, so
+/// the whole path (ARP poisoning, event loop, receive,
+/// classification, forwarding, cache restore at stop) is
+/// exercised without privileges or a network card:
+/// - victim and gateway exchange frames through the attacker
+///   in the single-threaded and pipelined modes,
+/// - frames of a pcap file are replayed into the attacker's
+///   socket,
+/// - ArpSpoofer poisons the victim through an injected socket.
+///
+/// Every case checks that frames arrive rewritten by the
+/// attacker and that caches are restored after stop. The
+/// forwarding cases also count heap allocations of all
+/// threads over the middle half of the traffic and fail if the
+/// steady-state packet loop allocates; one of them uses a
+/// socket without its own receivePackets(), so frames go
+/// through RawSocket's default path and App's FramePool.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+const MacAddress AttackerMac(0x02, 0x00, 0x00, 0x00, 0x00, 0x01);
+const MacAddress GatewayMac(0x02, 0x00, 0x00, 0x00, 0x00, 0x03);
+const MacAddress VictimMac(0x02, 0x00, 0x00, 0x00, 0x00, 0x02);
+const IPAddress AttackerIp(10, 0, 0, 100);
+const IPAddress GatewayIp(10, 0, 0, 1);
+const IPAddress VictimIp(10, 0, 0, 2);
+const size_t FrameSize = 128;
+const size_t MaxInFlight = 1024;   ///< Frames sent ahead of the gateway, below the socket queue size
+const double TimeoutSeconds = 10.0;
+
+////////////////////////////////////////////////////////////
+/// \brief Attacker's interface, victim and gateway
+///
+////////////////////////////////////////////////////////////
+struct Segment {
+	InMemoryNetwork network;
+	size_t gateway;
+	size_t victim;
+
+	Segment() {
+		NetworkInterface::InterfaceInfo info;
+		info.name = "mem0";
+		info.description = "In-memory network";
+		info.mac = AttackerMac;
+		info.ip = AttackerIp.toBytes();
+		info.prefixLength = 24;
+		info.gateway = GatewayIp.toBytes();
+		info.isUp = true;
+		info.addresses.push_back({info.ip, info.prefixLength});
+		network.addInterface(info);
+		gateway = network.addPeer({GatewayIp, GatewayMac});
+		victim = network.addPeer({VictimIp, VictimMac});
+	}
+};
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Waits until a condition holds
+///
+/// \return bool false on timeout
+///
+////////////////////////////////////////////////////////////
+template <typename Fn>
+bool waitFor(Fn&& condition) {
+	auto start = std::chrono::steady_clock::now();
+	while (!condition()) {
+		if (secondsSince(start) > TimeoutSeconds) {
+			return false;
+		}
+		std::this_thread::yield();
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Socket that receives one frame per call
+///
+/// Leaves receivePackets() to RawSocket, like the Windows and
+/// macOS sockets do.
+///
+////////////////////////////////////////////////////////////
+class PerFrameSocket : public RawSocket {
+public:
+	explicit PerFrameSocket(InMemoryNetwork& network) : socket(network) {}
+
+	bool open(const std::string& interfaceName, bool promiscuous) override {
+		return socket.open(interfaceName, promiscuous);
+	}
+	void close() override { socket.close(); }
+	bool isOpen() const override { return socket.isOpen(); }
+	bool sendPacket(const std::vector<uint8_t>& data) override { return socket.sendPacket(data); }
+	size_t sendBatch(const ConstByteSpan* frames, size_t count) override { return socket.sendBatch(frames, count); }
+	std::vector<uint8_t> receivePacket() override { return socket.receivePacket(); }
+	size_t receiveInto(ByteSpan buffer) override { return socket.receiveInto(buffer); }
+	int getDescriptor() const override { return socket.getDescriptor(); }
+
+private:
+	InMemoryRawSocket socket;
+};
+
+bool fail(const char* message) {
+	std::fprintf(stderr, "FAIL: %s\n", message);
+	return false;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Runs App on the segment while a callback drives it
+///
+/// \param drive Called once both peers are poisoned; returns
+///              false on a failed check
+///
+////////////////////////////////////////////////////////////
+template <typename Fn>
+bool runAttack(Segment& segment, bool pipelined, App::RawSocketFactory factory, Fn&& drive) {
+	App app(std::make_unique<InMemoryNetworkInterface>(segment.network), std::move(factory));
+	app.setLogCallback([](int level, const std::string& message) {
+		if (level == 0) {
+			std::fprintf(stderr, "%s\n", message.c_str());
+		}
+	});
+
+	App::AttackConfig config;
+	config.victimIp = VictimIp;
+	config.oneWayMode = false;
+	config.dropMode = false;
+	config.arpInterval = 1;
+	config.pipelined = pipelined;
+	if (!app.configureAttack(config)) {
+		return fail("configureAttack");
+	}
+
+	std::thread attack([&app]() { app.startAttack(); });
+	bool poisoned = waitFor([&]() {
+		return segment.network.getPeerArpEntry(segment.victim, GatewayIp) == AttackerMac &&
+		       segment.network.getPeerArpEntry(segment.gateway, VictimIp) == AttackerMac;
+	});
+	bool passed = poisoned ? drive(app) : fail("peers not poisoned");
+	app.requestStop();
+	attack.join();
+
+	if (passed && (segment.network.getPeerArpEntry(segment.victim, GatewayIp) != GatewayMac ||
+	               segment.network.getPeerArpEntry(segment.gateway, VictimIp) != VictimMac)) {
+		return fail("ARP caches not restored after stop");
+	}
+	return passed;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Victim and gateway talk through the attacker
+///
+////////////////////////////////////////////////////////////
+bool forwardCase(const char* name, bool pipelined, bool perFrame, uint64_t frames) {
+	Segment segment;
+	App::RawSocketFactory factory = [&segment, perFrame]() -> std::unique_ptr<RawSocket> {
+		if (perFrame) {
+			return std::make_unique<PerFrameSocket>(segment.network);
+		}
+		return std::make_unique<InMemoryRawSocket>(segment.network);
+	};
+	double seconds = 0.0;
+	uint64_t allocations = 0;
+
+	bool passed = runAttack(segment, pipelined, factory, [&](App& app) {
+		auto received = [&]() {
+			return segment.network.getPeerCounters(segment.gateway).frames +
+			       segment.network.getPeerCounters(segment.victim).frames;
+		};
+		auto start = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; i < frames; ++i) {
+			// Steady state: pools, queues and caches are warm
+			if (i == frames / 4) {
+				allocations = bench::allocationCount();
+			} else if (i == frames / 4 * 3) {
+				allocations = bench::allocationCount() - allocations;
+			}
+			if (i % 2 == 0) {
+				segment.network.sendFromPeer(segment.victim, GatewayIp, FrameSize);
+			} else {
+				segment.network.sendFromPeer(segment.gateway, VictimIp, FrameSize);
+			}
+			// Stay below the socket queue, otherwise frames are dropped
+			if (i % 64 == 0 && !waitFor([&]() { return received() + MaxInFlight > i; })) {
+				return fail("forwarding stalled");
+			}
+		}
+		if (!waitFor([&]() { return received() >= frames; })) {
+			return fail("frames missing at victim or gateway");
+		}
+		seconds = secondsSince(start);
+
+		InMemoryNetwork::PeerCounters gateway = segment.network.getPeerCounters(segment.gateway);
+		InMemoryNetwork::PeerCounters victim = segment.network.getPeerCounters(segment.victim);
+		TrafficStatistics::Snapshot snapshot = app.getStatistics();
+		if (gateway.frames != frames / 2 || victim.frames != frames / 2 || snapshot.forwarded != frames) {
+			return fail("frame counts differ");
+		}
+		if (gateway.lastSource != AttackerMac || victim.lastSource != AttackerMac) {
+			return fail("frames did not pass the attacker");
+		}
+		return true;
+	});
+
+	if (passed) {
+		double framesPerSecond = static_cast<double>(frames) / seconds;
+		bench::report(name, {{"frames", static_cast<double>(frames)},
+		                     {"frames_per_s", framesPerSecond},
+		                     {"steady_state_allocations", static_cast<double>(allocations)}});
+		if (allocations != 0) {
+			return fail("steady-state packet loop allocates");
+		}
+	}
+	return passed;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Writes a pcap file of victim to gateway frames
+///        addressed to the attacker
+///
+////////////////////////////////////////////////////////////
+bool writeCapture(const std::string& path, uint32_t frames) {
+	std::ofstream file(path, std::ios::binary);
+	const uint32_t header[6] = {0xA1B2C3D4, 0x00040002, 0, 0, 65535, 1};
+	file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+	std::vector<uint8_t> frame(FrameSize, 0);
+	AttackerMac.copyTo(frame.data());
+	VictimMac.copyTo(frame.data() + 6);
+	frame[12] = 0x08;
+	frame[14] = 0x45;
+	std::memcpy(frame.data() + 26, VictimIp.toArray().data(), 4);
+	std::memcpy(frame.data() + 30, GatewayIp.toArray().data(), 4);
+	for (uint32_t i = 0; i < frames; ++i) {
+		const uint32_t record[4] = {i, 0, static_cast<uint32_t>(FrameSize), static_cast<uint32_t>(FrameSize)};
+		file.write(reinterpret_cast<const char*>(record), sizeof(record));
+		file.write(reinterpret_cast<const char*>(frame.data()), static_cast<std::streamsize>(frame.size()));
+	}
+	return static_cast<bool>(file);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Replays a capture into the attacker's socket
+///
+////////////////////////////////////////////////////////////
+bool replayCase(uint32_t captureFrames, uint32_t cycles) {
+	const std::string path = "loopback_bench.pcap";
+	if (!writeCapture(path, captureFrames)) {
+		return fail("cannot write capture");
+	}
+
+	Segment segment;
+	bool loaded = false;
+	auto factory = [&]() {
+		auto socket = std::make_unique<InMemoryRawSocket>(segment.network);
+		loaded = socket->replayPcap(path, cycles);
+		return socket;
+	};
+	const uint64_t frames = static_cast<uint64_t>(captureFrames) * cycles;
+	double seconds = 0.0;
+
+	// Replay starts with the attack, so the frames are counted from there
+	auto start = std::chrono::steady_clock::now();
+	bool passed = runAttack(segment, false, factory, [&](App&) {
+		if (!loaded) {
+			return fail("replayPcap");
+		}
+		if (!waitFor([&]() { return segment.network.getPeerCounters(segment.gateway).frames >= frames; })) {
+			return fail("replayed frames missing at gateway");
+		}
+		seconds = secondsSince(start);
+		InMemoryNetwork::PeerCounters gateway = segment.network.getPeerCounters(segment.gateway);
+		if (gateway.frames != frames || gateway.lastSource != AttackerMac) {
+			return fail("replayed frames not forwarded");
+		}
+		return true;
+	});
+	std::remove(path.c_str());
+
+	if (passed) {
+		bench::report("in-memory pcap replay",
+		              {{"frames", static_cast<double>(frames)},
+		               {"frames_per_s", static_cast<double>(frames) / seconds}});
+	}
+	return passed;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief ArpSpoofer poisons the victim through an injected socket
+///
+////////////////////////////////////////////////////////////
+bool spooferCase() {
+	Segment segment;
+	ArpSpoofer spoofer(VictimIp, GatewayIp, std::make_unique<InMemoryRawSocket>(segment.network));
+	spoofer.setVictimMac(VictimMac);
+	spoofer.setTargetMac(GatewayMac);
+	spoofer.setMyMac(AttackerMac);
+	spoofer.setLogCallback([](const std::string&) {});
+	if (!spoofer.start()) {
+		return fail("ArpSpoofer::start");
+	}
+
+	bool poisoned = waitFor([&]() {
+		return segment.network.getPeerArpEntry(segment.victim, GatewayIp) == AttackerMac &&
+		       segment.network.getPeerArpEntry(segment.gateway, VictimIp) == AttackerMac;
+	});
+	spoofer.stop();
+	return poisoned || fail("ArpSpoofer did not poison the peers");
+}
+
+} // namespace
+
+int main() {
+	if (!forwardCase("in-memory attack, event loop", false, false, 200000) ||
+	    !forwardCase("in-memory attack, pipelined", true, false, 200000) ||
+	    !forwardCase("in-memory attack, per-frame socket", false, true, 200000) || !replayCase(1000, 200) ||
+	    !spooferCase()) {
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include "BenchUtils.hpp"
+#include "../MacAddress.hpp"
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <unordered_map>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+
+////////////////////////////////////////////////////////////
+/// \brief Benchmark and differential check of MacAddress
+///
+/// Before timing anything, MacAddress::parse() and toChars()
+/// are compared with sscanf()/snprintf() on random valid and
+/// mutated inputs; any disagreement fails the run. Then the
+/// value type is timed against the std::vector<uint8_t>
+/// addresses it replaced: comparing a frame's addresses,
+/// neighbour cache lookups, and text formatting and parsing.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+////////////////////////////////////////////////////////////
+/// \brief Reference parser built on sscanf()
+///
+////////////////////////////////////////////////////////////
+bool referenceParse(const std::string& text, uint8_t bytes[6]) {
+	// sscanf accepts signs, spaces and single digits, so check the shape first
+	if (text.size() != MacAddress::MaxStringLength) {
+		return false;
+	}
+	char separator = text[2];
+	for (size_t i = 0; i < text.size(); ++i) {
+		bool hex = std::isxdigit(static_cast<unsigned char>(text[i])) != 0;
+		if (i % 3 == 2 ? (text[i] != separator || (separator != ':' && separator != '-')) : !hex) {
+			return false;
+		}
+	}
+	unsigned values[6];
+	const char* format = separator == ':' ? "%2x:%2x:%2x:%2x:%2x:%2x" : "%2x-%2x-%2x-%2x-%2x-%2x";
+	if (std::sscanf(text.c_str(), format, &values[0], &values[1], &values[2], &values[3], &values[4],
+	                &values[5]) != 6) {
+		return false;
+	}
+	for (int i = 0; i < 6; ++i) {
+		bytes[i] = static_cast<uint8_t>(values[i]);
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Previous ostringstream-style formatter, kept for comparison
+///
+////////////////////////////////////////////////////////////
+std::string legacyFormat(const std::vector<uint8_t>& mac) {
+	std::ostringstream oss;
+	oss << std::hex << std::setfill('0');
+	for (size_t i = 0; i < mac.size(); ++i) {
+		if (i > 0) {
+			oss << ':';
+		}
+		oss << std::setw(2) << static_cast<int>(mac[i]);
+	}
+	return oss.str();
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Produces a random, possibly malformed, address string
+///
+////////////////////////////////////////////////////////////
+std::string randomInput(std::mt19937& rng) {
+	static const char alphabet[] = "0123456789abcdefABCDEFxg:-: +";
+	std::uniform_int_distribution<int> kind(0, 9);
+
+	char buffer[32];
+	int length = std::snprintf(buffer, sizeof(buffer), kind(rng) < 5 ? "%02x:%02x:%02x:%02x:%02x:%02x"
+	                                                                : "%02X-%02X-%02X-%02X-%02X-%02X",
+	                           static_cast<unsigned>(rng() & 0xFF), static_cast<unsigned>(rng() & 0xFF),
+	                           static_cast<unsigned>(rng() & 0xFF), static_cast<unsigned>(rng() & 0xFF),
+	                           static_cast<unsigned>(rng() & 0xFF), static_cast<unsigned>(rng() & 0xFF));
+	std::string s(buffer, static_cast<size_t>(length));
+
+	switch (kind(rng)) {
+	case 0:
+		s[rng() % s.size()] = alphabet[rng() % (sizeof(alphabet) - 1)]; // Mutate one character
+		break;
+	case 1:
+		s.erase(rng() % s.size(), 1);
+		break;
+	case 2:
+		s.insert(rng() % (s.size() + 1), 1, alphabet[rng() % (sizeof(alphabet) - 1)]);
+		break;
+	default:
+		break;
+	}
+	return s;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Compares parse()/toChars() with sscanf()/snprintf()
+///
+/// \return size_t Number of mismatches found
+///
+////////////////////////////////////////////////////////////
+size_t differentialCheck(size_t rounds) {
+	std::mt19937 rng(12345);
+	size_t mismatches = 0;
+	size_t accepted = 0;
+
+	for (size_t i = 0; i < rounds; ++i) {
+		std::string input = randomInput(rng);
+
+		uint8_t reference[6];
+		bool referenceOk = referenceParse(input, reference);
+		MacAddress parsed;
+		const char* end = input.data() + input.size();
+		bool ok = MacAddress::parse(input.data(), end, parsed) == end;
+
+		if (ok != referenceOk || (ok && std::memcmp(parsed.data(), reference, 6) != 0)) {
+			std::fprintf(stderr, "parse mismatch for \"%s\": reference=%d parse=%d\n", input.c_str(), referenceOk, ok);
+			++mismatches;
+		}
+		accepted += ok;
+
+		// Formatting and integer round trip of an arbitrary address
+		MacAddress address = MacAddress::fromUint64((static_cast<uint64_t>(rng()) << 16) ^ rng());
+		char expected[32];
+		std::snprintf(expected, sizeof(expected), "%02x:%02x:%02x:%02x:%02x:%02x", address[0], address[1],
+		              address[2], address[3], address[4], address[5]);
+		if (address.toString() != expected || MacAddress::fromString(expected) != address ||
+		    MacAddress::fromUint64(address.toUint64()) != address) {
+			std::fprintf(stderr, "format mismatch: snprintf=%s toString=%s\n", expected, address.toString().c_str());
+			++mismatches;
+		}
+	}
+
+	std::printf("differential check: %zu inputs, %zu valid, %zu mismatches\n", rounds, accepted, mismatches);
+	return mismatches;
+}
+
+} // namespace
+
+int main() {
+	if (differentialCheck(1000000) != 0) {
+		std::fprintf(stderr, "FAIL: parser/formatter disagree with sscanf/snprintf\n");
+		return 1;
+	}
+
+	const uint64_t iterations = 20000000;
+	const size_t count = 1024;
+	std::mt19937 rng(1);
+	std::vector<MacAddress> addresses;
+	std::vector<std::vector<uint8_t>> vectors;
+	std::vector<std::string> texts;
+	for (size_t i = 0; i < count; ++i) {
+		// Half of the addresses repeat the first one, so comparisons go both ways
+		MacAddress mac = i % 2 == 0 ? MacAddress(0x02, 0, 0, 0, 0, 1)
+		                            : MacAddress::fromUint64((static_cast<uint64_t>(rng()) << 16) ^ rng());
+		addresses.push_back(mac);
+		vectors.emplace_back(mac.begin(), mac.end());
+		texts.push_back(mac.toString());
+	}
+	const MacAddress wanted = addresses[0];
+	const std::vector<uint8_t> wantedVector = vectors[0];
+
+	auto compare = bench::run("MacAddress ==", iterations, [&](uint64_t i) {
+		bench::doNotOptimize(addresses[i % count] == wanted);
+	});
+	auto compareLegacy = bench::run("vector memcmp (previous)", iterations, [&](uint64_t i) {
+		bench::doNotOptimize(std::memcmp(vectors[i % count].data(), wantedVector.data(), 6) == 0);
+	});
+
+	// Neighbour cache: (interface << 32 | IP) -> MAC, as in LinuxNetworkInterface
+	std::unordered_map<uint64_t, MacAddress> cache;
+	std::unordered_map<uint64_t, std::vector<uint8_t>> cacheLegacy;
+	for (size_t i = 0; i < count; ++i) {
+		cache[i] = addresses[i];
+		cacheLegacy[i] = vectors[i];
+	}
+	auto lookup = bench::run("neighbour cache hit (MacAddress)", iterations / 4, [&](uint64_t i) {
+		MacAddress mac = cache.find(i % count)->second;
+		bench::doNotOptimize(mac);
+	});
+	auto lookupLegacy = bench::run("neighbour cache hit (vector, previous)", iterations / 4, [&](uint64_t i) {
+		std::vector<uint8_t> mac = cacheLegacy.find(i % count)->second;
+		bench::doNotOptimize(mac.data());
+	});
+
+	auto format = bench::run("MacAddress::toChars", iterations / 4, [&](uint64_t i) {
+		char buffer[MacAddress::MaxStringLength];
+		bench::doNotOptimize(addresses[i % count].toChars(buffer));
+		bench::doNotOptimize(buffer);
+	});
+	auto formatLegacy = bench::run("ostringstream format (previous)", iterations / 40, [&](uint64_t i) {
+		bench::doNotOptimize(legacyFormat(vectors[i % count]));
+	});
+
+	auto parse = bench::run("MacAddress::parse", iterations / 4, [&](uint64_t i) {
+		const std::string& s = texts[i % count];
+		MacAddress mac;
+		bench::doNotOptimize(MacAddress::parse(s.data(), s.data() + s.size(), mac));
+		bench::doNotOptimize(mac);
+	});
+
+	bench::report(compare);
+	bench::report(compareLegacy);
+	bench::report(lookup);
+	bench::report(lookupLegacy);
+	bench::report(format);
+	bench::report(formatLegacy);
+	bench::report(parse);
+	std::printf("speedup over vectors: compare %.1fx, cache hit %.1fx, format %.1fx\n",
+	            compareLegacy.nsPerOp / compare.nsPerOp, lookupLegacy.nsPerOp / lookup.nsPerOp,
+	            formatLegacy.nsPerOp / format.nsPerOp);
+
+	if (compare.allocationsPerOp != 0.0 || lookup.allocationsPerOp != 0.0 || format.allocationsPerOp != 0.0 ||
+	    parse.allocationsPerOp != 0.0) {
+		std::fprintf(stderr, "FAIL: MacAddress allocates\n");
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include "BenchUtils.hpp"
+#include "../PlatformAbstraction.hpp"
+#include <vector>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <cstdarg>
+#include <dlfcn.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////
+/// \brief Benchmark of raw socket transmit paths
+///
+/// Sends synthetic frames on an interface (default "lo")
+/// and reports time and system calls per frame for:
+/// - the previous sendPacket (SIOCGIFINDEX ioctl + sendto),
+/// - sendPacket with the interface address cached in open(),
+/// - sendBatch over sendmmsg,
+/// - sendBatch over PACKET_TX_RING.
+///
+/// System calls are counted by interposing the libc socket
+/// and ioctl wrappers in this binary. Needs CAP_NET_RAW;
+/// without it the benchmark is skipped.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+std::atomic<uint64_t> syscalls{0}; ///< Counted socket system calls
+
+template <typename Fn>
+Fn next(const char* name) {
+	return reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+}
+
+const size_t FrameSize = 64;        ///< Synthetic frame size
+const size_t BatchSize = 64;        ///< Frames per sendBatch call
+const uint64_t FrameCount = 256000; ///< Frames sent per case
+
+} // namespace
+
+////////////////////////////////////////////////////////////
+/// \brief Counting wrappers of libc system call functions
+///
+////////////////////////////////////////////////////////////
+
+extern "C" ssize_t sendto(int fd, const void* buffer, size_t length, int flags,
+                          const struct sockaddr* address, socklen_t addressLength) {
+	static auto real = next<ssize_t (*)(int, const void*, size_t, int, const struct sockaddr*, socklen_t)>("sendto");
+	syscalls.fetch_add(1, std::memory_order_relaxed);
+	return real(fd, buffer, length, flags, address, addressLength);
+}
+
+extern "C" ssize_t send(int fd, const void* buffer, size_t length, int flags) {
+	static auto real = next<ssize_t (*)(int, const void*, size_t, int)>("send");
+	syscalls.fetch_add(1, std::memory_order_relaxed);
+	return real(fd, buffer, length, flags);
+}
+
+extern "C" int sendmmsg(int fd, struct mmsghdr* messages, unsigned int count, int flags) {
+	static auto real = next<int (*)(int, struct mmsghdr*, unsigned int, int)>("sendmmsg");
+	syscalls.fetch_add(1, std::memory_order_relaxed);
+	return real(fd, messages, count, flags);
+}
+
+extern "C" int ioctl(int fd, unsigned long request, ...) noexcept {
+	static auto real = next<int (*)(int, unsigned long, void*)>("ioctl");
+	va_list args;
+	va_start(args, request);
+	void* argument = va_arg(args, void*);
+	va_end(args);
+	syscalls.fetch_add(1, std::memory_order_relaxed);
+	return real(fd, request, argument);
+}
+
+namespace {
+
+////////////////////////////////////////////////////////////
+/// \brief Measures one transmit path
+///
+/// \param name Case name
+/// \param framesPerCall Frames sent by one call of fn
+/// \param fn Sends framesPerCall frames, returns number sent
+///
+/// \return double Allocations per frame
+///
+////////////////////////////////////////////////////////////
+template <typename Fn>
+double measure(const char* name, size_t framesPerCall, Fn&& fn) {
+	uint64_t calls = FrameCount / framesPerCall;
+	uint64_t sent = 0;
+	uint64_t syscallsBefore = syscalls.load();
+
+	bench::Result result = bench::run(name, calls, [&](uint64_t) {
+		sent += fn();
+	});
+
+	// run() adds a warm-up of calls / 10 + 1 calls
+	uint64_t totalCalls = calls + calls / 10 + 1;
+	double frames = static_cast<double>(calls * framesPerCall);
+	result.nsPerOp /= static_cast<double>(framesPerCall);
+	result.allocationsPerOp /= static_cast<double>(framesPerCall);
+	result.iterations = calls * framesPerCall;
+
+	double perFrame = static_cast<double>(syscalls.load() - syscallsBefore) /
+	                  static_cast<double>(totalCalls * framesPerCall);
+	double accepted = 100.0 * static_cast<double>(sent) / (frames * static_cast<double>(totalCalls) / static_cast<double>(calls));
+	result.metrics.push_back({"syscalls_per_frame", perFrame});
+	result.metrics.push_back({"accepted_percent", accepted});
+	bench::report(result);
+	std::printf("%-40s %12.4f syscalls/frame %7.1f%% frames accepted\n", "", perFrame, accepted);
+	return result.allocationsPerOp;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const char* interfaceName = argc > 1 ? argv[1] : "lo";
+
+	std::vector<std::vector<uint8_t>> frames(BatchSize, std::vector<uint8_t>(FrameSize, 0));
+	std::vector<ConstByteSpan> spans;
+	for (size_t i = 0; i < frames.size(); ++i) {
+		std::memset(frames[i].data(), 0xFF, 6);                  // Broadcast destination
+		frames[i][11] = static_cast<uint8_t>(i);                 // Source MAC
+		frames[i][12] = 0x88;                                    // Local experimental EtherType
+		frames[i][13] = 0xB5;
+		spans.push_back(ConstByteSpan(frames[i]));
+	}
+
+	auto socket = PlatformFactory::createRawSocket();
+	if (!socket->open(interfaceName, false)) {
+		std::printf("transmit_bench: cannot open raw socket on %s (needs CAP_NET_RAW), skipped\n", interfaceName);
+		return 0;
+	}
+
+	// Previous sendPacket: interface index looked up on every frame
+	int legacyFd = ::socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+	measure("legacy ioctl + sendto per frame", 1, [&]() -> size_t {
+		struct ifreq ifr;
+		memset(&ifr, 0, sizeof(ifr));
+		strncpy(ifr.ifr_name, interfaceName, IFNAMSIZ - 1);
+		if (ioctl(legacyFd, SIOCGIFINDEX, &ifr) < 0) {
+			return 0;
+		}
+
+		struct sockaddr_ll addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sll_family = AF_PACKET;
+		addr.sll_protocol = htons(ETH_P_ALL);
+		addr.sll_ifindex = ifr.ifr_ifindex;
+		addr.sll_halen = ETH_ALEN;
+		memcpy(addr.sll_addr, frames[0].data(), ETH_ALEN);
+
+		return sendto(legacyFd, frames[0].data(), frames[0].size(), 0,
+		              (struct sockaddr*)&addr, sizeof(addr)) == static_cast<ssize_t>(frames[0].size());
+	});
+	::close(legacyFd);
+
+	measure("sendPacket (cached sockaddr_ll)", 1, [&]() -> size_t {
+		return socket->sendPacket(frames[0]) ? 1 : 0;
+	});
+
+	double batchAllocations = measure("sendBatch sendmmsg", BatchSize, [&]() {
+		return socket->sendBatch(spans.data(), spans.size());
+	});
+	socket->close();
+
+	auto ringSocket = PlatformFactory::createRawSocket();
+	RawSocket::RingConfig ring;
+	ring.blockSize = 1 << 16;
+	ring.blockCount = 16;
+	ring.frameSize = 256;
+	if (ringSocket->setTransmitRing(ring) && ringSocket->open(interfaceName, false)) {
+		measure("sendBatch PACKET_TX_RING", BatchSize, [&]() {
+			return ringSocket->sendBatch(spans.data(), spans.size());
+		});
+	} else {
+		std::printf("sendBatch PACKET_TX_RING: not available, skipped\n");
+	}
+
+	if (batchAllocations > 0.0) {
+		std::printf("FAIL: sendBatch allocates on the hot path\n");
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include "BenchUtils.hpp"
+#include "../PlatformAbstraction.hpp"
+#include "../BpfFilter.hpp"
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+/// \brief Send/receive throughput of the raw socket over a
+///        veth pair
+///
+/// Sends frames with sendBatch() on one end of a veth pair
+/// for a fixed time while a receive thread counts them on the
+/// other end, for several frame sizes, with plain receive,
+/// the receive ring and AF_XDP (native and generic XDP; skipped
+/// where the kernel refuses XDP). Reports frames per second on
+/// both sides, loss and kernel drops.
+///
+/// First checks that frames sent with sendPacket() on a socket
+/// with a transmit ring reach the other end: the kernel sends
+/// only ring slots once PACKET_TX_RING is mapped.
+///
+/// Usage: veth_bench <tx-interface> <rx-interface> [seconds]
+///
+/// bench/veth_harness.sh creates the pair in a private network
+/// namespace and runs this program; it needs no external
+/// network, only CAP_NET_ADMIN and CAP_NET_RAW.
+///
+////////////////////////////////////////////////////////////
+
+namespace {
+
+const uint16_t BenchEtherType = 0x88B5;  ///< Local experimental EtherType
+const size_t BatchSize = 64;              ///< Frames per sendBatch() call
+const int DrainMs = 200;                  ///< Wait for frames in flight after sending
+
+////////////////////////////////////////////////////////////
+/// \brief How the receiving end takes frames
+///
+////////////////////////////////////////////////////////////
+enum class ReceiveMode {
+	Recv,       ///< recvmsg() per frame
+	Ring,       ///< TPACKET_V3 ring
+	Xdp,        ///< AF_XDP, native XDP
+	XdpGeneric  ///< AF_XDP, generic (SKB) XDP
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Gets mode name used in result labels
+///
+////////////////////////////////////////////////////////////
+const char* modeName(ReceiveMode mode) {
+	switch (mode) {
+	case ReceiveMode::Recv:
+		return "recv";
+	case ReceiveMode::Ring:
+		return "ring";
+	case ReceiveMode::Xdp:
+		return "xdp";
+	case ReceiveMode::XdpGeneric:
+		return "xdp-generic";
+	}
+	return "";
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Counts benchmark frames on the receiving end
+///
+////////////////////////////////////////////////////////////
+class Receiver {
+public:
+	explicit Receiver(RawSocket& socket) : socket(socket), events(PlatformFactory::createEventLoop()) {}
+
+	bool start() {
+		if (!events || !events->addSocket(socket, [this]() {
+			size_t count = socket.receivePackets([this](ByteSpan frame) {
+				frames.store(frames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				bytes.store(bytes.load(std::memory_order_relaxed) + frame.size(), std::memory_order_relaxed);
+			}, 256);
+			return count > 0;
+		})) {
+			return false;
+		}
+		thread = std::thread([this]() { events->run(); });
+		return true;
+	}
+
+	void stop() {
+		if (thread.joinable()) {
+			events->stop();
+			thread.join();
+		}
+	}
+
+	std::atomic<uint64_t> frames{0}; ///< Benchmark frames received
+	std::atomic<uint64_t> bytes{0};  ///< Bytes received
+
+private:
+	RawSocket& socket;
+	std::unique_ptr<EventLoop> events;
+	std::thread thread;
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Sends for a fixed time and reports both ends
+///
+/// \return bool false if the receive socket cannot be set up
+///
+////////////////////////////////////////////////////////////
+bool measure(RawSocket& transmitter, const char* rxInterface, size_t frameSize, ReceiveMode mode, double seconds) {
+	bool xdp = mode == ReceiveMode::Xdp || mode == ReceiveMode::XdpGeneric;
+	auto socket = PlatformFactory::createRawSocket(mode == ReceiveMode::Xdp ? PlatformFactory::SocketBackend::Xdp :
+	                                               mode == ReceiveMode::XdpGeneric ? PlatformFactory::SocketBackend::XdpGeneric :
+	                                               PlatformFactory::SocketBackend::Default);
+	if (!socket || (mode == ReceiveMode::Ring && !socket->setReceiveRing(RawSocket::RingConfig()))) {
+		return false;
+	}
+	if (!socket->open(rxInterface, false)) {
+		if (xdp) {
+			// Needs CAP_BPF and Linux 5.9; not a failure of the raw socket
+			std::printf("veth %s receive: AF_XDP not available, skipped\n", modeName(mode));
+			return true;
+		}
+		return false;
+	}
+	BpfFilterBuilder filter;
+	filter.matchEtherType(BenchEtherType);
+	if (!socket->attachFilter(filter.build()) && xdp) {
+		return false;
+	}
+	
+	std::vector<std::vector<uint8_t>> frames(BatchSize, std::vector<uint8_t>(frameSize, 0));
+	std::vector<ConstByteSpan> spans;
+	for (size_t i = 0; i < frames.size(); ++i) {
+		std::memset(frames[i].data(), 0xFF, 6);                  // Broadcast destination
+		frames[i][6] = 0x02;                                     // Locally administered source
+		frames[i][11] = static_cast<uint8_t>(i);
+		frames[i][12] = static_cast<uint8_t>(BenchEtherType >> 8);
+		frames[i][13] = static_cast<uint8_t>(BenchEtherType);
+		spans.push_back(ConstByteSpan(frames[i]));
+	}
+	
+	Receiver receiver(*socket);
+	if (!receiver.start()) {
+		return false;
+	}
+	
+	uint64_t sent = 0;
+	uint64_t allocationsBefore = bench::allocationCount();
+	auto start = std::chrono::steady_clock::now();
+	auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+	while (std::chrono::steady_clock::now() < end) {
+		sent += transmitter.sendBatch(spans.data(), spans.size());
+	}
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	uint64_t allocations = bench::allocationCount() - allocationsBefore;
+	
+	std::this_thread::sleep_for(std::chrono::milliseconds(DrainMs));
+	receiver.stop();
+	RawSocket::Statistics statistics;
+	socket->getStatistics(statistics);
+	socket->close();
+	
+	uint64_t received = receiver.frames.load();
+	std::string name = std::string("veth ") + modeName(mode) + " receive " + std::to_string(frameSize) + " B";
+	bench::report(name, {
+		{"tx_frames_per_s", static_cast<double>(sent) / elapsed},
+		{"rx_frames_per_s", static_cast<double>(received) / elapsed},
+		{"rx_mb_per_s", static_cast<double>(receiver.bytes.load()) / elapsed / 1e6},
+		{"loss_percent", sent > 0 ? 100.0 * static_cast<double>(sent - std::min(sent, received)) / static_cast<double>(sent) : 0.0},
+		{"kernel_drops", static_cast<double>(statistics.drops)},
+		{"allocs_per_frame", sent > 0 ? static_cast<double>(allocations) / static_cast<double>(sent) : 0.0},
+	});
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Checks sendPacket() on a transmit ring socket
+///
+/// \return bool false if a frame did not arrive or the sockets
+///         cannot be set up
+///
+////////////////////////////////////////////////////////////
+bool checkRingSendPacket(const char* txInterface, const char* rxInterface) {
+	const uint64_t FrameCount = 100;
+	
+	auto transmitter = PlatformFactory::createRawSocket();
+	RawSocket::RingConfig ring;
+	ring.blockSize = 1 << 16;
+	ring.blockCount = 4;
+	ring.frameSize = 2048;
+	if (!transmitter->setTransmitRing(ring)) {
+		std::printf("veth sendPacket through PACKET_TX_RING: not available, skipped\n");
+		return true;
+	}
+	auto socket = PlatformFactory::createRawSocket();
+	if (!transmitter->open(txInterface, false) || !socket->open(rxInterface, false)) {
+		return false;
+	}
+	BpfFilterBuilder filter;
+	filter.matchEtherType(BenchEtherType);
+	socket->attachFilter(filter.build());
+	
+	Receiver receiver(*socket);
+	if (!receiver.start()) {
+		return false;
+	}
+	
+	std::vector<uint8_t> frame(64, 0);
+	std::memset(frame.data(), 0xFF, 6);
+	frame[6] = 0x02;
+	frame[12] = static_cast<uint8_t>(BenchEtherType >> 8);
+	frame[13] = static_cast<uint8_t>(BenchEtherType);
+	uint64_t accepted = 0;
+	for (uint64_t i = 0; i < FrameCount; ++i) {
+		accepted += transmitter->sendPacket(frame) ? 1 : 0;
+	}
+	
+	std::this_thread::sleep_for(std::chrono::milliseconds(DrainMs));
+	receiver.stop();
+	socket->close();
+	transmitter->close();
+	
+	uint64_t received = receiver.frames.load();
+	std::printf("veth sendPacket through PACKET_TX_RING: %llu sent, %llu accepted, %llu received\n",
+	            static_cast<unsigned long long>(FrameCount), static_cast<unsigned long long>(accepted),
+	            static_cast<unsigned long long>(received));
+	if (accepted != FrameCount || received != FrameCount) {
+		std::fprintf(stderr, "FAIL: sendPacket() frames lost on a transmit ring socket\n");
+		return false;
+	}
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	if (argc < 3) {
+		std::fprintf(stderr, "Usage: %s <tx-interface> <rx-interface> [seconds]\n", argv[0]);
+		return 2;
+	}
+	const char* txInterface = argv[1];
+	const char* rxInterface = argv[2];
+	double seconds = argc > 3 ? std::atof(argv[3]) : 1.0;
+	
+	if (!checkRingSendPacket(txInterface, rxInterface)) {
+		return 1;
+	}
+	
+	auto transmitter = PlatformFactory::createRawSocket();
+	if (!transmitter->open(txInterface, false)) {
+		std::fprintf(stderr, "veth_bench: cannot open raw socket on %s (needs CAP_NET_RAW)\n", txInterface);
+		return 1;
+	}
+	
+	for (size_t frameSize : {64, 512, 1514}) {
+		for (ReceiveMode mode : {ReceiveMode::Recv, ReceiveMode::Ring, ReceiveMode::Xdp, ReceiveMode::XdpGeneric}) {
+			if (!measure(*transmitter, rxInterface, frameSize, mode, seconds)) {
+				std::fprintf(stderr, "veth_bench: cannot receive on %s (%s)\n", rxInterface, modeName(mode));
+				return 1;
+			}
+		}
+	}
+	transmitter->close();
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Compares two benchmark result directories written by "make bench".
+
+Usage: bench/compare.py <baseline dir> <candidate dir> [threshold percent]
+
+Prints ns/op and throughput changes per case and exits with status 1 if
+any case got slower than the threshold (default 10%) or started to
+allocate.
+"""
+import json
+import os
+import sys
+
+# Metrics where a higher value is better; all others (ns/op, loss) are lower-is-better
+HIGHER_IS_BETTER = ("frames_per_s", "mb_per_s")
+
+
+def load(directory):
+    results = {}
+    for name in sorted(os.listdir(directory)):
+        if not name.endswith(".json"):
+            continue
+        with open(os.path.join(directory, name)) as file:
+            data = json.load(file)
+        for result in data["results"]:
+            results[(name[:-5], result["name"])] = result
+    return results
+
+
+def change(old, new):
+    if old == 0:
+        return 0.0
+    return 100.0 * (new - old) / old
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__.strip())
+        return 2
+    baseline = load(sys.argv[1])
+    candidate = load(sys.argv[2])
+    threshold = float(sys.argv[3]) if len(sys.argv) > 3 else 10.0
+    regressions = 0
+
+    for key in sorted(baseline.keys() & candidate.keys()):
+        old, new = baseline[key], candidate[key]
+        lines = []
+        if old["ns_per_op"] > 0:
+            delta = change(old["ns_per_op"], new["ns_per_op"])
+            worse = delta > threshold
+            lines.append("ns/op %.2f -> %.2f (%+.1f%%)%s" % (old["ns_per_op"], new["ns_per_op"], delta,
+                                                           "  REGRESSION" if worse else ""))
+            regressions += worse
+        if new["allocs_per_op"] > old["allocs_per_op"]:
+            lines.append("allocs/op %.3f -> %.3f  REGRESSION" % (old["allocs_per_op"], new["allocs_per_op"]))
+            regressions += 1
+        for metric, value in new["metrics"].items():
+            previous = old["metrics"].get(metric)
+            if previous is None or value is None:
+                continue
+            delta = change(previous, value)
+            worse = -delta > threshold if metric.endswith(HIGHER_IS_BETTER) else False
+            lines.append("%s %.6g -> %.6g (%+.1f%%)%s" % (metric, previous, value, delta,
+                                                        "  REGRESSION" if worse else ""))
+            regressions += worse
+        print("%s: %s" % key)
+        for line in lines:
+            print("    " + line)
+
+    for key in sorted(baseline.keys() - candidate.keys()):
+        print("%s: %s  missing in candidate" % key)
+    print("%d regression(s) above %.0f%%" % (regressions, threshold))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
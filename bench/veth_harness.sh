@@ -0,0 +1,34 @@
+#!/bin/sh
+# Runs veth_bench over a veth pair in a private network namespace.
+#
+# Usage: bench/veth_harness.sh <veth_bench binary> [seconds per case]
+#
+# Needs CAP_NET_ADMIN (veth pair) and CAP_NET_RAW (raw sockets), no
+# external network. If unshare(1) can create a network namespace the
+# pair lives there and disappears with it; otherwise it is created in
+# the current namespace and removed on exit. BENCH_JSON and
+# BENCH_COMMIT are passed through to the benchmark.
+
+set -e
+
+BENCH=${1:?usage: $0 <veth_bench binary> [seconds]}
+SECONDS_PER_CASE=${2:-1}
+TX=abench0
+RX=abench1
+
+if [ -z "$ARPSPOOF_BENCH_NETNS" ] && command -v unshare >/dev/null 2>&1 && unshare -n true 2>/dev/null; then
+	ARPSPOOF_BENCH_NETNS=1 exec unshare -n "$0" "$@"
+fi
+
+if ! ip link add "$TX" type veth peer name "$RX"; then
+	echo "veth_harness: cannot create veth pair (needs CAP_NET_ADMIN)" >&2
+	exit 1
+fi
+trap 'ip link del "$TX" 2>/dev/null || true' EXIT
+
+# No addresses: only the benchmark's own frames cross the pair
+ip link set "$TX" up
+ip link set "$RX" up
+ip link set lo up 2>/dev/null || true
+
+"$BENCH" "$TX" "$RX" "$SECONDS_PER_CASE"
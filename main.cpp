@@ -52,6 +52,29 @@ void showHelp(const std::string& programName) {
 	std::cout << "  --oneway, -o        One-way attack only\n";
 	std::cout << "  --drop, -d          Drop packets instead of forwarding (cuts internet)\n";
 	std::cout << "  --interval, -t      ARP packet interval (seconds, default 2)\n";
+	std::cout << "  --resolve-timeout   MAC resolution timeout (milliseconds, default 200, doubled per retry)\n";
+	std::cout << "  --resolve-attempts  MAC resolution requests per address (default 4)\n";
+	std::cout << "  --no-filter         Do not attach kernel BPF filter (capture every frame)\n";
+	std::cout << "  --rx-ring           Receive through memory-mapped ring (Linux TPACKET_V3)\n";
+	std::cout << "  --ring-blocks       Receive ring block count (default 64, implies --rx-ring)\n";
+	std::cout << "  --ring-block-size   Receive ring block size in bytes (default 1048576, implies --rx-ring)\n";
+	std::cout << "  --gso               Forward GRO super-frames whole, segmented on send (Linux PACKET_VNET_HDR)\n";
+	std::cout << "  --xdp               Receive and forward through AF_XDP, native XDP or generic fallback (Linux)\n";
+	std::cout << "  --xdp-generic       Like --xdp, always in generic (SKB) mode\n";
+	std::cout << "  --pipeline          Receive and transmit on dedicated threads\n";
+	std::cout << "  --queue-size        Pipeline frame queue size (default 4096, implies --pipeline)\n";
+	std::cout << "  --rx-cpu, --tx-cpu  Pin receive/transmit thread to CPU (implies --pipeline)\n";
+	std::cout << "  --control-cpu       Pin ARP/statistics thread to CPU\n";
+	std::cout << "  --workers           Receive threads sharing the socket through PACKET_FANOUT (default 1)\n";
+	std::cout << "  --fanout-mode       Frame distribution over workers: hash (per flow) or cpu (default hash)\n";
+	std::cout << "  --worker-cpu        Pin worker N to CPU (value + N)\n";
+	std::cout << "  --metrics           Serve OpenMetrics on port, host:port or unix:/path (e.g. 9101)\n";
+	std::cout << "  --latency           Measure delay added to forwarded frames from kernel receive timestamps\n";
+	std::cout << "  --latency-file      Write delay percentile distribution to file at stop (implies --latency)\n";
+	std::cout << "  --capture           Write intercepted frames to pcapng file (nanosecond timestamps)\n";
+	std::cout << "  --capture-rotate-mb Start a new capture file every N megabytes\n";
+	std::cout << "  --capture-rotate-s  Start a new capture file every N seconds\n";
+	std::cout << "  --capture-direct    Write capture with O_DIRECT, bypassing the page cache (Linux)\n";
 	std::cout << "  --verbose, -v       Detailed logging\n\n";
 	std::cout << "Arguments:\n";
 	std::cout << "  victim-ip           Victim's IP address (required)\n";
@@ -84,6 +107,76 @@ void showHelp(const std::string& programName) {
 #endif
 }
 
+////////////////////////////////////////////////////////////
+/// \brief Parses positive numeric option value
+///
+/// Reads the value following option argv[i] and advances i.
+/// Prints an error if the value is missing or not positive.
+///
+/// \param argc Number of arguments
+/// \param argv Array of arguments
+/// \param i Index of the option, moved to its value
+/// \param value Parsed value (written only on success)
+///
+/// \return bool true if value was valid
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+bool parsePositive(int argc, char* argv[], int& i, T& value) {
+	std::string option = argv[i];
+	if (i + 1 >= argc) {
+		std::cerr << "Error: Missing value for " << option << "\n";
+		return false;
+	}
+	
+	try {
+		long long parsed = std::stoll(argv[++i]);
+		if (parsed <= 0 || static_cast<unsigned long long>(parsed) > std::numeric_limits<T>::max()) {
+			std::cerr << "Error: " << option << " must be greater than 0\n";
+			return false;
+		}
+		value = static_cast<T>(parsed);
+	} catch (const std::exception&) {
+		std::cerr << "Error: Invalid value for " << option << "\n";
+		return false;
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Parses CPU index given after an option
+///
+/// Like parsePositive(), but accepts 0 (the first CPU).
+///
+/// \param argc Number of arguments
+/// \param argv Array of arguments
+/// \param i Index of the option, moved to its value
+/// \param cpu Parsed CPU index (written only on success)
+///
+/// \return bool true if value was valid
+///
+////////////////////////////////////////////////////////////
+bool parseCpu(int argc, char* argv[], int& i, int& cpu) {
+	std::string option = argv[i];
+	if (i + 1 >= argc) {
+		std::cerr << "Error: Missing value for " << option << "\n";
+		return false;
+	}
+	
+	try {
+		long long parsed = std::stoll(argv[++i]);
+		if (parsed < 0 || parsed > std::numeric_limits<int>::max()) {
+			std::cerr << "Error: " << option << " must be a CPU number (0 or more)\n";
+			return false;
+		}
+		cpu = static_cast<int>(parsed);
+	} catch (const std::exception&) {
+		std::cerr << "Error: Invalid value for " << option << "\n";
+		return false;
+	}
+	return true;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Parses command line arguments
 ///
@@ -134,6 +227,133 @@ bool parseArguments(int argc, char* argv[], App::AttackConfig& config) {
 				return false;
 			}
 		}
+		else if (arg == "--resolve-timeout") {
+			if (!parsePositive(argc, argv, i, config.resolveTimeoutMs)) {
+				return false;
+			}
+		}
+		else if (arg == "--resolve-attempts") {
+			if (!parsePositive(argc, argv, i, config.resolveAttempts)) {
+				return false;
+			}
+		}
+		else if (arg == "--no-filter") {
+			config.kernelFilter = false;
+		}
+		else if (arg == "--rx-ring") {
+			config.useReceiveRing = true;
+		}
+		else if (arg == "--gso") {
+			config.segmentationOffload = true;
+		}
+		else if (arg == "--xdp") {
+			config.socketBackend = PlatformFactory::SocketBackend::Xdp;
+		}
+		else if (arg == "--xdp-generic") {
+			config.socketBackend = PlatformFactory::SocketBackend::XdpGeneric;
+		}
+		else if (arg == "--ring-blocks") {
+			config.useReceiveRing = true;
+			if (!parsePositive(argc, argv, i, config.ringConfig.blockCount)) {
+				return false;
+			}
+		}
+		else if (arg == "--ring-block-size") {
+			config.useReceiveRing = true;
+			if (!parsePositive(argc, argv, i, config.ringConfig.blockSize)) {
+				return false;
+			}
+		}
+		else if (arg == "--pipeline") {
+			config.pipelined = true;
+		}
+		else if (arg == "--queue-size") {
+			config.pipelined = true;
+			if (!parsePositive(argc, argv, i, config.pipeline.queueSize)) {
+				return false;
+			}
+		}
+		else if (arg == "--rx-cpu") {
+			config.pipelined = true;
+			if (!parseCpu(argc, argv, i, config.pipeline.rxCpu)) {
+				return false;
+			}
+		}
+		else if (arg == "--tx-cpu") {
+			config.pipelined = true;
+			if (!parseCpu(argc, argv, i, config.pipeline.txCpu)) {
+				return false;
+			}
+		}
+		else if (arg == "--control-cpu") {
+			if (!parseCpu(argc, argv, i, config.controlCpu)) {
+				return false;
+			}
+		}
+		else if (arg == "--workers") {
+			if (!parsePositive(argc, argv, i, config.workers)) {
+				return false;
+			}
+		}
+		else if (arg == "--fanout-mode") {
+			std::string mode = i + 1 < argc ? argv[++i] : "";
+			if (mode == "hash") {
+				config.fanoutMode = RawSocket::FanoutMode::Hash;
+			} else if (mode == "cpu") {
+				config.fanoutMode = RawSocket::FanoutMode::Cpu;
+			} else {
+				std::cerr << "Error: Fanout mode must be hash or cpu\n";
+				return false;
+			}
+		}
+		else if (arg == "--worker-cpu") {
+			if (!parseCpu(argc, argv, i, config.workerCpu)) {
+				return false;
+			}
+		}
+		else if (arg == "--metrics") {
+			if (i + 1 < argc) {
+				config.metricsAddress = argv[++i];
+			} else {
+				std::cerr << "Error: Missing metrics address\n";
+				return false;
+			}
+		}
+		else if (arg == "--latency") {
+			config.measureDelay = true;
+		}
+		else if (arg == "--latency-file") {
+			if (i + 1 < argc) {
+				config.delayFile = argv[++i];
+				config.measureDelay = true;
+			} else {
+				std::cerr << "Error: Missing latency file path\n";
+				return false;
+			}
+		}
+		else if (arg == "--capture") {
+			if (i + 1 < argc) {
+				config.capture.path = argv[++i];
+			} else {
+				std::cerr << "Error: Missing capture file path\n";
+				return false;
+			}
+		}
+		else if (arg == "--capture-rotate-mb") {
+			uint32_t megabytes = 0;
+			if (!parsePositive(argc, argv, i, megabytes)) {
+				return false;
+			}
+			config.capture.rotateBytes = static_cast<uint64_t>(megabytes) * 1000000;
+		}
+		else if (arg == "--capture-rotate-s") {
+			if (!parsePositive(argc, argv, i, config.capture.rotateSeconds)) {
+				return false;
+			}
+		}
+		else if (arg == "--capture-direct") {
+			config.capture.directIo = true;
+		}
 		else if (arg == "--interface" || arg == "-i") {
 			if (i + 1 < argc) {
 				config.interfaceName = argv[++i];
@@ -176,6 +396,11 @@ bool parseArguments(int argc, char* argv[], App::AttackConfig& config) {
 		return false;
 	}
 	
+	if (config.workers > 1 && config.pipelined) {
+		std::cerr << "Error: --workers cannot be combined with --pipeline\n";
+		return false;
+	}
+	
 	return true;
 }
 